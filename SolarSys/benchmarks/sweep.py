@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Runs the benchmark mode over stress scenes of growing size, for each rendering
+path, and gathers the results in a CSV file (one line per run) ready to be plotted.
+
+From the bin folder:
+    python3 ../SolarSys/benchmarks/sweep.py --bodies 10 100 1000 10000 100000 1000000
+"""
+
+import argparse
+import csv
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+COLUMNS = ["bodies", "path", "planets", "moons", "rings", "textureSize", "textures",
+           "frameP50", "frameP95", "frameP99", "simulationP50", "renderingP50", "presentP50", "gpuP50",
+           "peakResidentKiB", "frameArenaBytes"]
+
+
+def percentile(statistics, name="p50"):
+    return statistics[name] if statistics else ""
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--app", default="./SolarSys_", help="executable of the simulation")
+    parser.add_argument("--tour", default=os.path.join(here, "tour.txt"), help="tour played by each run")
+    parser.add_argument("--frames", type=int, default=600, help="frames played by each run")
+    parser.add_argument("--bodies", type=int, nargs="+", default=[10, 100, 1000, 10000, 100000, 1000000],
+                        help="bodies of the scenes, the sun included")
+    parser.add_argument("--moons", type=int, default=0, help="satellites of each planet")
+    parser.add_argument("--ring-ratio", type=float, default=0.1, help="part of the planets with a ring")
+    parser.add_argument("--texture-size", type=int, default=256, help="width of the textures")
+    parser.add_argument("--textures", type=int, default=8, help="textures shared by the bodies")
+    parser.add_argument("--paths", nargs="+", default=["cpu", "gpu"], choices=["cpu", "gpu"], help="rendering paths")
+    parser.add_argument("--output", default="sweep.csv", help="CSV file written")
+    args = parser.parse_args()
+
+    with open(args.output, "w", newline="") as file, tempfile.TemporaryDirectory() as folder:
+        writer = csv.writer(file)
+        writer.writerow(COLUMNS)
+
+        for bodies in args.bodies:
+            planets = max(1, -(-(bodies - 1) // (1 + args.moons)))  # Rounded up
+            for path in args.paths:
+                results = os.path.join(folder, "results.json")
+                command = [args.app, "--benchmark", args.tour, "--frames", str(args.frames), "--output", results,
+                           "--path", path, "--planets", str(planets), "--moons", str(args.moons),
+                           "--rings", str(int(planets * args.ring_ratio)),
+                           "--texture-size", str(args.texture_size), "--textures", str(args.textures)]
+                print("Running", " ".join(command), file=sys.stderr)
+                if os.path.exists(results):
+                    os.remove(results)
+
+                # A run with steady allocations (SOLARSYS_TRACK_ALLOCATIONS) fails but still has its results
+                subprocess.run(command, stdout=subprocess.DEVNULL)
+                if not os.path.exists(results):
+                    print("The run failed, its line is skipped", file=sys.stderr)
+                    continue
+
+                with open(results) as resultsFile:
+                    run = json.load(resultsFile)
+                scene = run["scene"]
+                writer.writerow([scene["bodies"], run["path"], planets, args.moons, scene["rings"],
+                                 args.texture_size, args.textures,
+                                 percentile(run["frameTime"]), percentile(run["frameTime"], "p95"), percentile(run["frameTime"], "p99"),
+                                 percentile(run["cpu"]["simulation"]), percentile(run["cpu"]["rendering"]),
+                                 percentile(run["cpu"]["present"]), percentile(run["gpu"]["frame"]),
+                                 run["memory"]["peakResidentKiB"], run["memory"]["frameArenaBytes"]])
+                file.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,75 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module counts the heap allocations made      =
+=  during each frame, to keep the rendering loop     =
+=  free of them.                                     =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+/**
+ * @brief Counts the allocations made through the global operator new.
+ *
+ * The counting is only compiled in when SOLARSYS_TRACK_ALLOCATIONS is defined
+ * (CMake option of the same name): the global operator new and delete are then
+ * replaced to record each allocation with the call stack it comes from.
+ * Otherwise every function does nothing and `isEnabled()` returns false.
+ *
+ * Once the first WARMUP_FRAMES frames are done (caches filled, buffers grown),
+ * the frame loop is expected to stop allocating: each frame which still does is
+ * reported with its main call sites, and `getSteadyAllocations()` tells a
+ * benchmark that it must fail.
+ ********************************************************************************/
+class AllocationTracker
+{
+public:
+    static constexpr unsigned int WARMUP_FRAMES = 60;  // Frames allowed to allocate, at the start of the loop
+    static constexpr unsigned int STACK_DEPTH = 8;     // Frames of the call stack identifying a call site
+    static constexpr unsigned int MAX_SITES = 1024;    // Call sites told apart, the others are counted together
+    static constexpr unsigned int REPORTED_SITES = 5;  // Call sites printed for a frame
+
+    /**
+     * @brief Tells if the allocations are counted (SOLARSYS_TRACK_ALLOCATIONS).
+     ********************************************************************************/
+    static bool isEnabled();
+
+    /**
+     * @brief Ends the current frame.
+     *
+     * Once the warm-up is done, a frame which allocated is reported with its
+     * allocations, their bytes and its main call sites.
+     *
+     * @param out The stream receiving the report.
+     *
+     * @return The amount of allocations made during the frame.
+     ********************************************************************************/
+    static std::size_t endFrame(std::ostream &out);
+
+    /**
+     * @brief Retrieves the amount of allocations made after the warm-up.
+     *
+     * @return 0 if the frame loop reached a steady state without allocation.
+     ********************************************************************************/
+    static std::size_t getSteadyAllocations();
+
+    /**
+     * @brief Records an allocation, called by the replaced operator new.
+     *
+     * @param size Size of the allocation (in bytes).
+     ********************************************************************************/
+    static void recordAllocation(std::size_t size);
+
+    /**
+     * @brief Records a deallocation, called by the replaced operator delete.
+     ********************************************************************************/
+    static void recordDeallocation();
+};
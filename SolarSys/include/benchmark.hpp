@@ -0,0 +1,221 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module plays a scripted tour of the solar    =
+=  system with a fixed time step and measures the    =
+=  frames, to compare the performances of two runs.  =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "include/context.hpp"
+#include "include/renderEngine.hpp"
+#include "include/stressScene.hpp"
+
+/**
+ * @brief Headless and deterministic run of the simulation.
+ *
+ * The tour is a text file, one step per line: the frame it is played on, an
+ * action and its values. The lines starting with '#' are comments.
+ *
+ *     # frame  action     values
+ *     0        overview
+ *     120      next                   (arrow keys)
+ *     240      leap       100         (in seconds of simulated time)
+ *     300      rotate     30 -10      (left and up, in degrees)
+ *
+ * The actions are the ones of the keys: overview, profile, next, previous,
+ * large, faster, slower, leap, zoom, rotate, gpu, impostors, rings, resolution
+ * and scheduling (see the events module).
+ *
+ * The simulated time moves by TIME_STEP each frame, whatever the time the
+ * frames take, and the resolution follows the window (unless the tour turns
+ * the dynamic one on): two runs of a tour render the same frames. The first
+ * WARMUP_FRAMES frames are played but not measured.
+ *
+ * The results are written as JSON: percentiles of the frame time, CPU time of
+ * each phase of the frames, GPU time of the frames and memory high-water marks,
+ * with the size of the scene and the rendering path the run started with. The
+ * builds with the OpenGL interceptor (SOLARSYS_GL_TRACE) add the calls made by
+ * the frames.
+ *
+ * The tour can fly over a stress scene (see the stressScene module) in place
+ * of the solar system, to measure how the frames scale with the scene.
+ ********************************************************************************/
+class Benchmark
+{
+public:
+    static constexpr float TIME_STEP = 1.f / 60;                    // Simulated time of a frame (in seconds)
+    static constexpr unsigned int DEFAULT_FRAMES = 1200;            // Frames played when the command line doesn't tell
+    static constexpr unsigned int WARMUP_FRAMES = 60;               // Frames played before the measures
+    static constexpr const char *DEFAULT_OUTPUT = "benchmark.json"; // Results written when the command line doesn't tell
+
+    /**
+     * @brief Reads the benchmark settings from the command line of the app.
+     *
+     * SolarSys_ --benchmark tour.txt [--frames N] [--output results.json] [--path cpu|gpu]
+     *           [--planets N [--moons N] [--rings N] [--texture-size N] [--textures N]]
+     *           [--gl-capture trace.bin]
+     *
+     * --path selects the rendering path of the bodies at the start, and --planets
+     * replaces the solar system with a stress scene with the given settings.
+     * --gl-capture records the OpenGL calls of the run (SOLARSYS_GL_TRACE builds).
+     *
+     * Throws a std::invalid_argument if the arguments are wrong, and a
+     * std::runtime_error if the tour can't be read.
+     *
+     * @param argc Amount of arguments, the name of the app included.
+     * @param argv The arguments.
+     *
+     * @return The benchmark to run, null without --benchmark.
+     ********************************************************************************/
+    static std::unique_ptr<Benchmark> fromArguments(int argc, char *argv[]);
+
+    /**
+     * @brief Loads a tour.
+     *
+     * Throws a std::runtime_error if the file can't be read or if a step is wrong.
+     *
+     * @param tourPath Path of the tour.
+     * @param nbFrames Amount of frames to play.
+     * @param outputPath Path of the results.
+     ********************************************************************************/
+    Benchmark(const std::string &tourPath, unsigned int nbFrames, const std::string &outputPath);
+
+    /**
+     * @brief Retrieves the stress scene to fly over.
+     *
+     * @return The settings of the scene, null to fly over the solar system.
+     ********************************************************************************/
+    const StressScene *getStressScene() const;
+
+    /**
+     * @brief Retrieves the path of the trace of the OpenGL calls to record.
+     *
+     * @return The path, empty if the calls aren't recorded.
+     ********************************************************************************/
+    const std::string &getGLCapturePath() const;
+
+    /**
+     * @brief Sets the context up for the run, before the first frame: the
+     *        rendering path is selected and the resolution follows the window.
+     *
+     * @param context The context the keys would act on.
+     * @param renderEng The render engine, it tells if the GPU driven path exists.
+     ********************************************************************************/
+    void configure(Context &context, const RenderEngine &renderEng);
+
+    /**
+     * @brief Tells if frames are left to play.
+     ********************************************************************************/
+    bool isRunning() const;
+
+    /**
+     * @brief Starts a frame: plays the steps of the tour due on this frame.
+     *
+     * @param context The context the keys would act on.
+     ********************************************************************************/
+    void beginFrame(Context &context);
+
+    /**
+     * @brief Ends the simulation phase of the frame (update of the matrices and
+     *        of the camera).
+     ********************************************************************************/
+    void endSimulation();
+
+    /**
+     * @brief Ends the rendering phase of the frame (draw calls).
+     ********************************************************************************/
+    void endRendering();
+
+    /**
+     * @brief Ends the frame, after the swap of the buffers and the events.
+     *
+     * @param renderEng The render engine, it gives the GPU time of the frames.
+     ********************************************************************************/
+    void endFrame(const RenderEngine &renderEng);
+
+    /**
+     * @brief Writes the results to the output given to the constructor.
+     *
+     * @return False if the file can't be written.
+     ********************************************************************************/
+    bool writeResults() const;
+
+private:
+    /**
+     * @brief Actions of a tour.
+     ********************************************************************************/
+    enum TourAction
+    {
+        ACTION_OVERVIEW,
+        ACTION_PROFILE,
+        ACTION_NEXT,
+        ACTION_PREVIOUS,
+        ACTION_LARGE,
+        ACTION_FASTER,
+        ACTION_SLOWER,
+        ACTION_LEAP,
+        ACTION_ZOOM,
+        ACTION_ROTATE,
+        ACTION_GPU,
+        ACTION_IMPOSTORS,
+        ACTION_RINGS,
+        ACTION_RESOLUTION,
+        ACTION_SCHEDULING
+    };
+
+    /**
+     * @brief A line of the tour.
+     ********************************************************************************/
+    struct TourStep
+    {
+        unsigned int frame;
+        TourAction action;
+        float values[2];
+    };
+
+    /**
+     * @brief Times measured each frame (in ms).
+     ********************************************************************************/
+    enum Measure
+    {
+        MEASURE_FRAME,      // Whole frame
+        MEASURE_SIMULATION, // Update of the matrices and of the camera
+        MEASURE_RENDERING,  // Draw calls
+        MEASURE_PRESENT,    // Swap of the buffers and events
+        MEASURE_GPU,        // GPU time of the frame, read a few frames late
+        NB_MEASURES
+    };
+
+    /**
+     * @brief Plays a step of the tour.
+     ********************************************************************************/
+    static void play(const TourStep &step, Context &context);
+
+    std::string _tourPath;                             // Path of the tour
+    std::string _outputPath;                           // Path of the results
+    std::vector<TourStep> _steps;                      // Sorted by frame
+    unsigned int _nextStep = 0;                        // Index of the next step to play
+    unsigned int _nbFrames;                            // Frames to play
+    unsigned int _frameIndex = 0;                      // Frame being played
+    std::chrono::steady_clock::time_point _frameStart; // Time when the frame started
+    std::chrono::steady_clock::time_point _phaseStart; // Time when the current phase started
+    std::unique_ptr<StressScene> _stressScene;         // Scene flown over, null for the solar system
+    bool _gpuDriven = false;                           // Rendering path asked for, then the one the run started with
+    std::string _glCapturePath;                        // Trace of the OpenGL calls, empty if they aren't recorded
+    unsigned int _nbBodies = 0;                        // Bodies of the scene
+    unsigned int _nbRings = 0;                         // Rings of the scene
+    std::vector<float> _samples[NB_MEASURES];          // Times of the measured frames (in ms)
+};
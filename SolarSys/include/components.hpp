@@ -0,0 +1,93 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module contains the components of the        =
+=  bodies of the solar system, all the information   =
+=  we need to move and draw them (data, transforms,  =
+=  textures, shaders...).                            =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include "include/entityStore.hpp"
+#include "include/planetData.hpp"
+#include "include/shaderManager.hpp"
+#include "include/sceneGraph.hpp"
+
+/**
+ * @brief Ways of drawing a body, from the most detailed to the cheapest one.
+ *
+ * The render engine picks one from the size of the body on screen, so the
+ * cost of its fragments follows the amount of detail that can be seen.
+ ********************************************************************************/
+enum ShadingLevel : unsigned int
+{
+    SHADING_MESH,       // Sphere mesh, per-pixel lighting
+    SHADING_IMPOSTOR,   // Sphere ray-cast on a quad, per-pixel lighting (SHADER_IMPOSTOR)
+    SHADING_LOW_DETAIL, // Sphere ray-cast on a quad, average color and diffuse lighting (SHADER_AVERAGE_COLOR)
+    SHADING_POINT,      // Single point, for the bodies smaller than a pixel (SHADER_POINT)
+    NB_SHADING_LEVELS
+};
+
+/**
+ * @brief Motion of a body around its parent (the sun or its planet).
+ ********************************************************************************/
+struct OrbitComponent
+{
+    PlanetData data; // Periods, distance, tilts and size of the body
+};
+
+/**
+ * @brief Nodes of a body in the scene graph of the solar system.
+ ********************************************************************************/
+struct TransformComponent
+{
+    SceneGraph::NodeId orbitNode; // Reference of the body and of its satellites (the body node for a satellite)
+    SceneGraph::NodeId bodyNode;  // Body itself (axial rotation and size)
+};
+
+/**
+ * @brief Textures and shaders drawing a body.
+ *
+ * The shaders are owned by the ShaderLibrary (defined in the shaderManager
+ * module), which outlives the solar system.
+ ********************************************************************************/
+struct MaterialComponent
+{
+    static constexpr unsigned int MAX_TEXTURES = 2;
+
+    GLuint textures[MAX_TEXTURES] = {};          // Texture IDs, bound from the unit 0
+    unsigned int nbTextures = 0;                 // Amount of textures used
+    ShaderBody *shaders[NB_SHADING_LEVELS] = {}; // Shader of each shading level, null if the body is never drawn at it
+    bool alwaysImpostor = false;                 // Impostor used at any size
+};
+
+/**
+ * @brief Ring around a planet.
+ ********************************************************************************/
+struct RingComponent
+{
+    GLuint texture = 0;                              // Texture ID
+    ShaderBody *shader = nullptr;                    // Shader of the ring (SHADER_RING)
+    SceneGraph::NodeId node = SceneGraph::NO_PARENT; // Ring node, child of the body node
+    float innerRadius = 0;                           // Distance of the inner edge to the center of the planet
+    float outerRadius = 0;                           // Distance of the outer edge to the center of the planet
+    bool flat = false;                               // Flat annulus instead of a flattened torus
+};
+
+/**
+ * @brief Place of a body in the hierarchy of the solar system.
+ *
+ * The satellites of a planet are the entities following it.
+ ********************************************************************************/
+struct HierarchyComponent
+{
+    Entity parent = NO_ENTITY;     // Planet of a satellite, NO_ENTITY for a planet
+    Entity firstChild = NO_ENTITY; // First satellite
+    unsigned int nbChildren = 0;   // Amount of satellites
+};
@@ -125,11 +125,66 @@ public:
      ********************************************************************************/
     bool isProfileCam();
 
+    /**
+     * @brief Switches between the real distances and the large view, the light
+     *        intensity follows.
+     ********************************************************************************/
+    void toggleLargeView();
+
     /**
      * @brief Accessor for the light
      */
     Light &getLight();
 
+    /**
+     * @brief Switches between the classic rendering and the GPU driven one.
+     ********************************************************************************/
+    void toggleGpuDriven();
+
+    /**
+     * @brief Tells if the bodies must be drawn with the GPU driven path.
+     *
+     * @return True if the GPU driven rendering is selected and false otherwise.
+     ********************************************************************************/
+    bool isGpuDriven();
+
+    /**
+     * @brief Switches between impostors for every body and impostors only for the
+     *        bodies small on screen.
+     ********************************************************************************/
+    void toggleImpostors();
+
+    /**
+     * @brief Switches the rings between flattened toruses and flat annuli.
+     ********************************************************************************/
+    void toggleFlatRings();
+
+    /**
+     * @brief Switches between a resolution following the frame time budget and
+     *        the resolution of the window.
+     ********************************************************************************/
+    void toggleDynamicResolution();
+
+    /**
+     * @brief Tells if the resolution follows the frame time budget.
+     *
+     * @return True if the resolution is dynamic and false if the window one is kept.
+     ********************************************************************************/
+    bool isDynamicResolution();
+
+    /**
+     * @brief Switches between updating the planets from their motion on screen
+     *        and updating all of them every frame.
+     ********************************************************************************/
+    void toggleUpdateScheduling();
+
+    /**
+     * @brief Tells if the planets are updated from their motion on screen.
+     *
+     * @return True if the slow planets skip some updates and false otherwise.
+     ********************************************************************************/
+    bool isUpdateScheduling();
+
 private:
     Camera &camera;
     SolarSystem &solarSys;
@@ -137,4 +192,9 @@ private:
     float speedMultiplier;   // Multiplier for the speed at which time elapses in the solar system
     float _tLeap = 0;
     Light &_light;
+    bool _gpuDriven = false; // Culling and submission of the bodies made by the GPU
+    bool _allImpostors = false; // Every body drawn with its impostor
+    bool _flatRings = false;    // Rings drawn as flat annuli
+    bool _dynamicResolution = true; // Resolution lowered to keep the frame time under the budget
+    bool _updateScheduling = true;  // Planets updated from their motion on screen (see the updateScheduler module)
 };
\ No newline at end of file
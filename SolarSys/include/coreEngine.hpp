@@ -21,6 +21,12 @@
 #include "include/window.hpp"
 #include "include/renderEngine.hpp"
 #include "include/solarSystem.hpp"
+#include "include/updateScheduler.hpp"
+#include "include/allocationTracker.hpp"
+#include "include/sceneSnapshot.hpp"
+#include "include/profiler.hpp"
+#include "include/benchmark.hpp"
+#include <glimac/GLInterceptor.hpp>
 
 #include <glimac/getTime.hpp> // Must keep it after the other includes
 
@@ -32,7 +38,9 @@
  * and the rendering of a 3D environment.
  *
  * @param relativePath A path location where the app is ran.
+ * @param benchmark If not null, the tour it plays replaces the user (see the
+ *                  benchmark module), the window is headless.
  *
  * @return The code error of the core engine part.
  ********************************************************************************/
-int render3DScene(char *relativePath);
+int render3DScene(char *relativePath, Benchmark *benchmark = nullptr);
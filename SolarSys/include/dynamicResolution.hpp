@@ -0,0 +1,66 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module adapts the rendering resolution to    =
+=  keep the GPU time of the frames under a budget.   =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+/**
+ * @brief Chooses the resolution scale of the scene from the measured GPU times.
+ *
+ * The GPU time is assumed to be proportional to the amount of pixels, so the
+ * scale needed to reach the budget is the square root of the time ratio.
+ * The scale drops at once when a frame goes over the budget and only grows back
+ * step by step while the frames stay under a part of it (HEADROOM), which avoids
+ * oscillating around the budget.
+ ********************************************************************************/
+class DynamicResolution
+{
+public:
+    static constexpr float DEFAULT_BUDGET = 1000.f / 60; // Frame time budget (in ms)
+    static constexpr float MIN_SCALE = 0.5f;              // Smallest scale of the window resolution
+    static constexpr float SCALE_STEP = 0.05f;            // Scales are multiples of this step
+    static constexpr float HEADROOM = 0.9f;               // Part of the budget targeted, left for the CPU side and spikes
+
+    /**
+     * @brief Sets the frame time budget.
+     *
+     * @param budget GPU time allowed for a frame (in ms), 0 to always render at the
+     *               full resolution.
+     ********************************************************************************/
+    void setBudget(float budget);
+
+    /**
+     * @brief Retrieves the frame time budget (in ms), 0 if the scaling is disabled.
+     ********************************************************************************/
+    float getBudget() const;
+
+    /**
+     * @brief Adapts the scale to the GPU time of a frame.
+     *
+     * The times arrive a few frames late, the frame may have been rendered with
+     * an older scale.
+     *
+     * @param gpuTime GPU time of the frame (in ms).
+     * @param frameScale Scale the frame was rendered with.
+     ********************************************************************************/
+    void update(double gpuTime, float frameScale);
+
+    /**
+     * @brief Retrieves the scale to apply to the window resolution.
+     *
+     * @return A scale between MIN_SCALE and 1.
+     ********************************************************************************/
+    float getScale() const;
+
+private:
+    float _budget = DEFAULT_BUDGET; // Frame time budget (in ms)
+    float _scale = 1;               // Current resolution scale
+};
@@ -0,0 +1,159 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module contains the storage of the           =
+=  components of the entities of the scene (dense    =
+=  arrays indexed through stable handles).           =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+
+using Entity = unsigned int;          // Stable handle of an object of the scene, never reused
+constexpr Entity NO_ENTITY = ~0u;     // Handle of no entity (parent of the planets)
+
+/**
+ * @brief Dense storage of one type of component.
+ *
+ * The components are stored contiguously in the order they were added, so a
+ * system reading every component walks a flat array. A sparse array gives the
+ * position of the component of each entity, the handles stay valid whatever
+ * the amount of components added later.
+ *
+ * The access by entity isn't checked: the entity must have the component
+ * (see `has()`).
+ *
+ * @tparam Component Type of the stored component.
+ ********************************************************************************/
+template <typename Component>
+class ComponentArray
+{
+public:
+    /**
+     * @brief Gives a component to an entity.
+     *
+     * Throws std::logic_error if the entity already has one.
+     *
+     * @param entity The entity.
+     * @param component The component, copied in the array.
+     *
+     * @return The stored component.
+     ********************************************************************************/
+    Component &add(Entity entity, const Component &component)
+    {
+        if (has(entity))
+        {
+            throw std::logic_error("The entity already has this component");
+        }
+        if (entity >= _indices.size())
+        {
+            _indices.resize(entity + 1, NO_INDEX);
+        }
+
+        _indices[entity] = _components.size();
+        _entities.push_back(entity);
+        _components.push_back(component);
+        return _components.back();
+    }
+
+    /**
+     * @brief Tells if an entity has a component in the array.
+     ********************************************************************************/
+    bool has(Entity entity) const
+    {
+        return entity < _indices.size() && _indices[entity] != NO_INDEX;
+    }
+
+    /**
+     * @brief Retrieves the component of an entity, which must have one.
+     ********************************************************************************/
+    Component &operator[](Entity entity)
+    {
+        return _components[_indices[entity]];
+    }
+    const Component &operator[](Entity entity) const
+    {
+        return _components[_indices[entity]];
+    }
+
+    /**
+     * @brief Retrieves the entity owning the component at a position of the
+     *        dense array.
+     ********************************************************************************/
+    Entity getEntity(unsigned int index) const
+    {
+        return _entities[index];
+    }
+
+    /**
+     * @brief Retrieves the amount of components stored.
+     ********************************************************************************/
+    unsigned int size() const
+    {
+        return _components.size();
+    }
+
+    /**
+     * @brief Bounds of the dense array, to iterate over every component.
+     ********************************************************************************/
+    Component *begin() { return _components.data(); }
+    Component *end() { return _components.data() + _components.size(); }
+    const Component *begin() const { return _components.data(); }
+    const Component *end() const { return _components.data() + _components.size(); }
+
+private:
+    static constexpr unsigned int NO_INDEX = ~0u; // Position of the component of an entity without one
+
+    std::vector<Component> _components; // Components, in the order they were added
+    std::vector<Entity> _entities;      // Entity owning each component
+    std::vector<unsigned int> _indices; // Position of the component of each entity
+};
+
+/**
+ * @brief Range of consecutive entities, iterated by value.
+ ********************************************************************************/
+class EntityRange
+{
+public:
+    /**
+     * @brief Iterator over the handles of the range.
+     ********************************************************************************/
+    class Iterator
+    {
+    public:
+        explicit Iterator(Entity entity) : _entity{entity} {}
+        Entity operator*() const { return _entity; }
+        Iterator &operator++()
+        {
+            _entity++;
+            return *this;
+        }
+        bool operator!=(const Iterator &other) const { return _entity != other._entity; }
+
+    private:
+        Entity _entity;
+    };
+
+    /**
+     * @brief Constructor of the class.
+     *
+     * @param first The first entity.
+     * @param count The amount of entities.
+     ********************************************************************************/
+    EntityRange(Entity first, unsigned int count) : _first{first}, _count{count} {}
+
+    Iterator begin() const { return Iterator(_first); }
+    Iterator end() const { return Iterator(_first + _count); }
+    unsigned int size() const { return _count; }
+
+private:
+    Entity _first;
+    unsigned int _count;
+};
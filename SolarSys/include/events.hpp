@@ -60,7 +60,7 @@ private:
     static double mouse_x;
     static double mouse_y;
     static unsigned int planet_idx;                            // Index of the planet whose POV is to be shown
-    static std::vector<std::unique_ptr<PlanetObject>> planets; // Vector of pointers toward planets from  which position will be recovered from.
+    static std::vector<Entity> planets;                        // Handles of the planets from which position will be recovered from.
 
     /**
      * @brief Callback function for the keys on the keyboard.
@@ -0,0 +1,66 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module describes the view frustum of the     =
+=  camera, used to skip the objects that can't be    =
+=  seen.                                             =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <glimac/glm.hpp>
+
+/**
+ * @brief Volume of the scene seen by the camera.
+ *
+ * It is described by 6 planes (left, right, bottom, top, near, far) in world
+ * coordinates, their normals point toward the inside of the volume.
+ * A point p is inside the half-space of a plane if dot(plane.xyz, p) + plane.w >= 0.
+ ********************************************************************************/
+class Frustum
+{
+public:
+    static constexpr unsigned int NB_PLANES = 6; // Amount of planes bounding the volume
+
+    /**
+     * @brief Constructor of the class.
+     *
+     * Builds a frustum containing the whole space (nothing is culled).
+     ********************************************************************************/
+    Frustum();
+
+    /**
+     * @brief Constructor of the class.
+     *
+     * Extracts the planes from the matrix going from the world coordinates to the
+     * clip coordinates.
+     *
+     * @param viewProjMatrix The projection matrix multiplied by the view matrix.
+     ********************************************************************************/
+    Frustum(const glm::mat4 &viewProjMatrix);
+
+    /**
+     * @brief Tells if a sphere is at least partially inside the frustum.
+     *
+     * @param center Center of the sphere in world coordinates.
+     * @param radius Radius of the sphere.
+     *
+     * @return False if the sphere is fully outside and True otherwise.
+     ********************************************************************************/
+    bool intersectsSphere(const glm::vec3 &center, float radius) const;
+
+    /**
+     * @brief Retrieves the planes of the frustum.
+     *
+     * @return A pointer on the NB_PLANES planes, ready to be sent to a shader.
+     ********************************************************************************/
+    const glm::vec4 *getPlanes() const;
+
+private:
+    glm::vec4 _planes[NB_PLANES]; // Normalized planes (normal in xyz, distance in w)
+};
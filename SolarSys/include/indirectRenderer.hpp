@@ -0,0 +1,200 @@
+/*
+======================================================
+=  													 =
+=     Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module defines the GPU driven rendering of   =
+=  the bodies: a compute shader culls them and picks =
+=  their level of detail, then all of them are drawn =
+=  with two indirect calls.                          =
+=  													 =
+======================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <glad/glad.h>
+#include <glimac/Sphere.hpp>
+#include <glimac/StreamBuffer.hpp>
+#include <glimac/GeometryArena.hpp>
+
+#include "include/solarSystem.hpp"
+#include "include/frustum.hpp"
+#include "include/shaderManager.hpp"
+
+/**
+ * @brief Data of a body read by the culling and the drawing shaders.
+ *
+ * The memory layout follows the std430 rules, it must match the `Body` structure
+ * declared in the shaders.
+ ********************************************************************************/
+struct IndirectBody
+{
+    glm::mat4 modelMatrix;    // Model matrix of the body
+    glm::vec4 boundingSphere; // Bounding sphere in model coordinates (the radius is stored in w)
+    glm::vec4 material;       // x: first texture layer, y: second texture layer (-1 if none)
+};
+
+/**
+ * @brief Texture layers and lighting of a body, resolved once when the renderer
+ *        is built instead of every frame.
+ ********************************************************************************/
+struct IndirectMaterial
+{
+    glm::vec4 layers = glm::vec4(-1, -1, 0, 0); // Copied to IndirectBody::material
+    bool isLighted = true;                      // Drawn with the lighted permutation, otherwise emissive (the sun)
+};
+
+/**
+ * @brief Command read by glMultiDrawElementsIndirect, filled by the culling shader.
+ ********************************************************************************/
+struct DrawElementsIndirectCommand
+{
+    GLuint count;         // Amount of indices of the level of detail
+    GLuint instanceCount; // 0 if the body is culled and 1 otherwise
+    GLuint firstIndex;    // First index of the level of detail in the index buffer
+    GLint baseVertex;     // First vertex of the level of detail in the vertex buffer
+    GLuint baseInstance;  // Index of the body
+};
+
+/**
+ * @brief Sphere mesh used when a body covers at least a given size on screen.
+ *
+ * The memory layout follows the std430 rules, it must match the `LevelOfDetail`
+ * structure declared in the culling shader.
+ ********************************************************************************/
+struct LevelOfDetail
+{
+    GLuint indexCount;    // Amount of indices of the mesh
+    GLuint firstIndex;    // First index of the mesh in the index buffer
+    GLint baseVertex;     // First vertex of the mesh in the vertex buffer
+    float minPixelRadius; // Smallest radius on screen (in pixels) using this level
+};
+
+/**
+ * @brief Draws every body of a solar system with a constant amount of calls.
+ *
+ * The bodies are written every frame in a streaming storage buffer (see
+ * StreamBuffer in the glimac library), a compute shader tests them against
+ * the frustum, picks a sphere mesh according to their size on screen and writes
+ * the draw commands. The commands are then consumed by one
+ * glMultiDrawElementsIndirect call for the emissive bodies and one for the
+ * lighted ones (two permutations of the body shader), the textures are
+ * gathered in a texture array.
+ *
+ * It needs OpenGL 4.3 (see `isSupported()`), the rings and the skybox are still
+ * drawn by the render engine.
+ ********************************************************************************/
+class IndirectRenderer
+{
+public:
+    static constexpr GLuint BODY_BINDING = 0;    // Storage binding point of the bodies
+    static constexpr GLuint COMMAND_BINDING = 1; // Storage binding point of the draw commands
+    static constexpr GLuint LOD_BINDING = 2;     // Storage binding point of the levels of detail
+
+    static constexpr GLsizei LAYER_WIDTH = 1024; // Width of the textures in the array
+    static constexpr GLsizei LAYER_HEIGHT = 512; // Height of the textures in the array
+
+    static constexpr GLuint WORK_GROUP_SIZE = 64; // Must match the local size of the culling shader
+
+    /**
+     * @brief Tells if the current OpenGL context can run the GPU driven path.
+     *
+     * @return True if compute shaders, indirect draws and storage buffers in the
+     *         vertex stage are available.
+     ********************************************************************************/
+    static bool isSupported();
+
+    /**
+     * @brief Constructor of the class.
+     *
+     * Builds the programs, the levels of detail and the texture array of the
+     * bodies of the solar system.
+     *
+     * @param applicationPath A FilePath (defined in the glimac library) describing
+     *                        the location where the app is ran.
+     * @param shaders The library sharing the shader managers.
+     * @param solarSys The solar system whose bodies are going to be drawn.
+     * @param geometry The shared geometry where the levels of detail are stored,
+     *                 it must outlive the renderer.
+     ********************************************************************************/
+    IndirectRenderer(const FilePath &applicationPath, ShaderLibrary &shaders, SolarSystem &solarSys, GeometryArena &geometry);
+
+    /**
+     * @brief Destructor of the class.
+     ********************************************************************************/
+    ~IndirectRenderer();
+
+    IndirectRenderer(const IndirectRenderer &) = delete;
+    IndirectRenderer &operator=(const IndirectRenderer &) = delete;
+
+    /**
+     * @brief Culls and draws the planets (and their satellites).
+     *
+     * The frame uniform buffer must already be up to date.
+     *
+     * @param solarSys The solar system to draw.
+     * @param frustum The frustum of the camera for this frame.
+     * @param viewportHeight Height of the rendered area (in pixels).
+     * @param drawSatellites If true, the satellites are also drawn.
+     ********************************************************************************/
+    void draw(SolarSystem &solarSys, const Frustum &frustum, float viewportHeight, bool drawSatellites);
+
+private:
+    /**
+     * @brief Adds all the sphere meshes to the shared geometry.
+     ********************************************************************************/
+    void createLevelsOfDetail();
+
+    /**
+     * @brief Copies the textures of the bodies in the layers of a texture array
+     *        and resolves the material of each body.
+     *
+     * @param solarSys The solar system whose textures are gathered.
+     ********************************************************************************/
+    void createTextureArray(SolarSystem &solarSys);
+
+    /**
+     * @brief Makes sure the buffers can store the given amount of bodies.
+     *
+     * @param nbBodies Amount of bodies to store.
+     ********************************************************************************/
+    void reserve(unsigned int nbBodies);
+
+    /**
+     * @brief Writes the data of a body to the ones sent this frame.
+     *
+     * @param material The resolved material of the planet or satellite to write.
+     * @param modelMatrix The model matrix of the planet or satellite.
+     * @param data Where to write the data (in the mapped storage buffer).
+     ********************************************************************************/
+    void writeBody(const IndirectMaterial &material, const glm::mat4 &modelMatrix, IndirectBody *data) const;
+
+    // Programs
+    Program _cullingProgram;           // Frustum culling and LOD selection (compute shader)
+    GLint _uBodyCount;                 // Uniform ID for the amount of bodies
+    GLint _uLodCount;                  // Uniform ID for the amount of levels of detail
+    GLint _uFrustumPlanes;             // Uniform ID for the frustum planes
+    GLint _uViewportHeight;            // Uniform ID for the height of the rendered area
+    std::shared_ptr<ShaderBody> _emissiveShader; // Draws the emissive bodies with their texture layers
+    std::shared_ptr<ShaderBody> _lightedShader;  // Draws the lighted bodies with their texture layers
+
+    // Meshes
+    GeometryArena &_geometry; // Shared geometry holding the levels of detail
+    GLuint _lodBuffer = 0;    // Levels of detail read by the culling shader
+    unsigned int _nbLods = 0; // Amount of levels of detail
+
+    // Bodies
+    std::unique_ptr<StreamBuffer> _bodyBuffer; // Storage buffer of the bodies, written by the CPU every frame
+    GLuint _commandBuffer = 0;                 // Draw commands written by the culling shader
+    GLuint _bodyIndexBuffer = 0;               // 0, 1, 2... read per instance to find the body
+    unsigned int _capacity = 0;                // Amount of bodies the buffers can store
+
+    // Textures
+    GLuint _textureArray = 0;                // Textures of every body
+    std::vector<IndirectMaterial> _materials; // Resolved material of each entity (indexed by entity)
+};
@@ -51,4 +51,5 @@ public:
     // Light attributes
     glm::vec3 _position;  // Position in the 3D world
     glm::vec3 _intensity; // Intensity on the axes
+    glm::vec3 _ambient;   // Minimum light factor received by the objects
 };
@@ -69,8 +69,13 @@ public:
 
     // Shaders
     static constexpr const char *RELATIVE_PATH_VERTEX = "SolarSys/shaders/3D.vs.glsl";                                 // Vertex shader path
-    static constexpr const char *RELATIVE_PATH_FRAGMENT_FULLYLIGHTED1T = "SolarSys/shaders/1TextFullyLighted.fs.glsl"; // Path of the shader for single textures fully lighted
-    static constexpr const char *RELATIVE_PATH_FRAGMENT_1T = "SolarSys/shaders/1Text.fs.glsl";                         // Single Texture shader path
-    static constexpr const char *RELATIVE_PATH_FRAGMENT_2T = "SolarSys/shaders/2Text.fs.glsl";                         // Multi texturing(2) shader path
-    static constexpr const char *RELATIVE_PATH_FRAGMENT_TORUS = "SolarSys/shaders/torusText.fs.glsl";
+    static constexpr const char *RELATIVE_PATH_VERTEX_IMPOSTOR = "SolarSys/shaders/impostor.vs.glsl";                  // Vertex shader of the ray-cast spheres
+    static constexpr const char *RELATIVE_PATH_VERTEX_POINT = "SolarSys/shaders/point.vs.glsl";                        // Vertex shader of the bodies smaller than a pixel
+    static constexpr const char *RELATIVE_PATH_VERTEX_RING = "SolarSys/shaders/ring.vs.glsl";                          // Vertex shader of the procedural rings
+    static constexpr const char *RELATIVE_PATH_FRAGMENT_BODY = "SolarSys/shaders/body.fs.glsl";                        // Fragment shader of every permutation (see ShaderBody)
+    static constexpr const char *RELATIVE_PATH_VERTEX_INDIRECT = "SolarSys/shaders/indirect.vs.glsl";   // Vertex shader of the GPU driven path
+    static constexpr const char *RELATIVE_PATH_COMPUTE_CULLING = "SolarSys/shaders/cull.cs.glsl";       // Frustum culling and LOD selection
+    static constexpr const char *RELATIVE_PATH_SHADER_CACHE = "SolarSys/shaderCache";                  // Binaries of the linked programs
+    static constexpr const char *RELATIVE_PATH_SCENE_SNAPSHOT = "SolarSys/sceneCache/scene.bin";       // Scene baked by the previous start
+    static constexpr const char *RELATIVE_PATH_PROFILE_TRACE = "SolarSys/profile/trace.json";        // Zones recorded by the profiler
 };
\ No newline at end of file
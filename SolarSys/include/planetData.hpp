@@ -14,6 +14,26 @@
 
 #pragma once
 
+/**
+ * @brief Values of a PlanetData, already converted to the units of the scene.
+ *
+ * A plain structure which can be written to a file as it is (see the
+ * sceneSnapshot module) and read back with a BakedData.
+ ********************************************************************************/
+struct PlanetValues
+{
+    float position;         // Unreal distance from the sun
+    float largePosition;    // Real distance from the sun
+    float rotationPeriod;   // Rotation period of the planet
+    float diameter;         // Size of the planet
+    float orbitInclination; // Angle of the inclination of the planet's orbit in degree
+    float angle;            // Angle of rotation of the ellipse in degree
+    float revolutionPeriod; // Revolution period of the planet
+    float ringDist;         // Distance of the ring from center of planet
+    float ringThickness;    // Thickness of the ring
+    unsigned int hasRing;   // Presence of a ring, an integer to keep the structure without padding
+};
+
 /**
  * @brief Class containing a planet's data.
  *
@@ -37,6 +57,13 @@ protected:
      ********************************************************************************/
     PlanetData(float rotation, float diameter, float position, float orbitInclination, float angle, float revPeriod, bool hasRing, float ringDist, float ringThickness);
 
+    /**
+     * @brief Constructor of the class from values already in the units of the scene.
+     *
+     * @param values The values, as given by `getValues()`.
+     ********************************************************************************/
+    explicit PlanetData(const PlanetValues &values);
+
     // These are protexted beacause we want to retrieve them from a getter
     // to be sure we are taking the right value between these two
     const float _position;      // Unreal distances form the sun (Better for visualisation)
@@ -53,6 +80,11 @@ public:
      ********************************************************************************/
     float getPosition();
 
+    /**
+     * @brief Retrieves the values of the planet, in the units of the scene.
+     ********************************************************************************/
+    PlanetValues getValues() const;
+
     const float _rotationPeriod;   // Rotation period of the planet
     const float _diameter;         // Size of the planet
     const float _orbitInclination; // Angle of the inclination of the planet's orbit in degree
@@ -401,3 +433,38 @@ public:
      */
     CharonData();
 };
+
+// ----------------------------------------- SNAPSHOT  -----------------------------------------
+
+/**
+ * @brief Contains data read back from a scene snapshot (see the sceneSnapshot module).
+ *
+ * A BakedData object is a kind of PlanetData.
+ ********************************************************************************/
+class BakedData : public PlanetData
+{
+public:
+    /**
+     * @brief Constructor of the class.
+     *
+     * @param values The values saved from the original data.
+     ********************************************************************************/
+    explicit BakedData(const PlanetValues &values);
+};
+
+// ----------------------------------------- STRESS SCENE  -----------------------------------------
+
+/**
+ * @brief Contains data made up by the stress scene generator (see the stressScene
+ *        module), in the units of the real bodies.
+ *
+ * A GeneratedData object is a kind of PlanetData.
+ ********************************************************************************/
+class GeneratedData : public PlanetData
+{
+public:
+    /**
+     * @brief Constructor of the class, the parameters are the ones of PlanetData.
+     ********************************************************************************/
+    GeneratedData(float rotation, float diameter, float position, float orbitInclination, float angle, float revPeriod, bool hasRing, float ringDist, float ringThickness);
+};
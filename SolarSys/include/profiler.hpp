@@ -0,0 +1,194 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module measures the time spent in the zones  =
+=  of the code, frame by frame, and exports them as  =
+=  a trace readable by Chrome or Perfetto.           =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glimac/FilePath.hpp>
+#include <glimac/GpuProfiler.hpp>
+
+using namespace glimac;
+
+/**
+ * @brief Records the zones of the code run by each thread and the frames.
+ *
+ * The recording is only compiled in when SOLARSYS_PROFILE is defined (CMake
+ * option of the same name): `PROFILE_ZONE()` and `PROFILE_FRAME()` are then
+ * expanded to the recording, otherwise to nothing and `isEnabled()` returns
+ * false.
+ *
+ * Each thread writes in its own buffer of BUFFER_EVENTS events, allocated on
+ * its first zone: recording a zone takes two reads of the clock and a store,
+ * without lock nor allocation. Once a buffer is full, the next events of its
+ * thread are dropped (and counted), the trace keeps the beginning of the run.
+ *
+ * The passes of the GPU are measured by a GpuProfiler (defined in the glimac
+ * library) with `PROFILE_GPU_ZONE()`, between `beginGpuFrame()` and
+ * `endGpuFrame()`. Their times arrive a few frames late, they are recorded on a
+ * track of their own, in the clock of the CPU zones.
+ *
+ * `writeTrace()` exports the events in the Trace Event format, open the file in
+ * chrome://tracing or in https://ui.perfetto.dev.
+ ********************************************************************************/
+class Profiler
+{
+public:
+    static constexpr unsigned int BUFFER_EVENTS = 1 << 16; // Events kept for each thread
+
+    /**
+     * @brief Tells if the zones are recorded (SOLARSYS_PROFILE).
+     ********************************************************************************/
+    static bool isEnabled();
+
+    /**
+     * @brief Retrieves the time elapsed since the start of the profiler.
+     *
+     * @return The time in nanoseconds.
+     ********************************************************************************/
+    static uint64_t now();
+
+    /**
+     * @brief Records a zone run by the current thread.
+     *
+     * @param name Name of the zone, a string literal (only its address is kept).
+     * @param begin Time when the zone was entered (see `now()`).
+     * @param end Time when the zone was left (see `now()`).
+     ********************************************************************************/
+    static void recordZone(const char *name, uint64_t begin, uint64_t end);
+
+    /**
+     * @brief Marks the end of a frame, the markers split the trace frame by frame.
+     ********************************************************************************/
+    static void endFrame();
+
+    /**
+     * @brief Records the GPU passes of the previous frames which are finished,
+     *        then starts measuring the passes of a new frame.
+     *
+     * Must be called by the thread owning the OpenGL context.
+     *
+     * @param gpuProfiler The profiler measuring the passes.
+     ********************************************************************************/
+    static void beginGpuFrame(GpuProfiler &gpuProfiler);
+
+    /**
+     * @brief Ends the measure of the GPU passes of the frame.
+     *
+     * @param gpuProfiler The profiler measuring the passes.
+     ********************************************************************************/
+    static void endGpuFrame(GpuProfiler &gpuProfiler);
+
+    /**
+     * @brief Retrieves the amount of events which didn't fit in the buffers.
+     ********************************************************************************/
+    static std::size_t getDroppedEvents();
+
+    /**
+     * @brief Writes the recorded events in the Trace Event format (JSON).
+     *
+     * The threads shouldn't record anything during the writing.
+     *
+     * @param file Path of the trace, its folder is created if needed.
+     *
+     * @return False if nothing is recorded or if the file can't be written.
+     ********************************************************************************/
+    static bool writeTrace(const FilePath &file);
+};
+
+#ifdef SOLARSYS_PROFILE
+
+/**
+ * @brief Records the time spent in a scope, from its construction to its
+ *        destruction. The zones nest like the scopes.
+ ********************************************************************************/
+class ProfileZone
+{
+public:
+    /**
+     * @brief Enters the zone.
+     *
+     * @param name Name of the zone, a string literal.
+     ********************************************************************************/
+    explicit ProfileZone(const char *name) : _name{name}, _begin{Profiler::now()}
+    {
+    }
+
+    /**
+     * @brief Leaves the zone and records it.
+     ********************************************************************************/
+    ~ProfileZone()
+    {
+        Profiler::recordZone(_name, _begin, Profiler::now());
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *_name; // Name of the zone
+    uint64_t _begin;   // Time when the zone was entered
+};
+
+/**
+ * @brief Measures the GPU time of the commands sent in a scope, from its
+ *        construction to its destruction.
+ ********************************************************************************/
+class GpuProfileZone
+{
+public:
+    /**
+     * @brief Enters the zone.
+     *
+     * @param gpuProfiler The profiler measuring the passes of the frame.
+     * @param name Name of the zone, a string literal.
+     ********************************************************************************/
+    GpuProfileZone(GpuProfiler &gpuProfiler, const char *name) : _gpuProfiler{gpuProfiler}, _zone{gpuProfiler.beginZone(name)}
+    {
+    }
+
+    /**
+     * @brief Leaves the zone.
+     ********************************************************************************/
+    ~GpuProfileZone()
+    {
+        _gpuProfiler.endZone(_zone);
+    }
+
+    GpuProfileZone(const GpuProfileZone &) = delete;
+    GpuProfileZone &operator=(const GpuProfileZone &) = delete;
+
+private:
+    GpuProfiler &_gpuProfiler; // Profiler of the frame
+    int _zone;                 // Index of the zone in the frame, -1 if it isn't measured
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+// Records the rest of the enclosing scope as a zone
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+
+// Measures the GPU time of the rest of the enclosing scope
+#define PROFILE_GPU_ZONE(gpuProfiler, name) GpuProfileZone PROFILE_CONCAT(gpuProfileZone, __LINE__)(gpuProfiler, name)
+
+// Marks the end of a frame
+#define PROFILE_FRAME() Profiler::endFrame()
+
+#else
+
+#define PROFILE_ZONE(name) static_cast<void>(0)
+#define PROFILE_GPU_ZONE(gpuProfiler, name) static_cast<void>(0)
+#define PROFILE_FRAME() static_cast<void>(0)
+
+#endif
@@ -12,16 +12,27 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
+#include <vector>
 #include <glad/glad.h>
 #include <glimac/Sphere.hpp>
+#include <glimac/GeometryArena.hpp>
+#include <glimac/RenderTarget.hpp>
+#include <glimac/GpuTimer.hpp>
+#include <glimac/GpuProfiler.hpp>
+#include <glimac/FrameArena.hpp>
 
 #include "include/textures.hpp"
 #include "include/tools.hpp"
-#include "include/planetObject.hpp"
+#include "include/solarSystem.hpp"
 #include "include/camera.hpp"
 #include "include/skybox.hpp"
 #include "include/light.hpp"
-#include "include/torus.hpp"
+#include "include/uniformBuffer.hpp"
+#include "include/frustum.hpp"
+#include "include/indirectRenderer.hpp"
+#include "include/dynamicResolution.hpp"
 
 /**
  * @brief Represents all the render engine part of the application.
@@ -31,10 +42,102 @@
 class RenderEngine
 {
 public:
+    static constexpr float IMPOSTOR_PIXEL_RADIUS = 48;   // Bodies smaller than this radius on screen (in pixels) are ray-cast
+    static constexpr float LOW_DETAIL_PIXEL_RADIUS = 6;  // Bodies smaller than this radius on screen are ray-cast with their average color
+    static constexpr float POINT_PIXEL_RADIUS = 0.5f;    // Bodies smaller than this radius on screen are drawn as a single point
+
+    static constexpr float FIELD_OF_VIEW = 70;   // Vertical field of view (in degrees)
+    static constexpr float NEAR_PLANE = 0.01f;   // Distance of the near plane, there is no far plane
+
+    static constexpr float RING_SEGMENT_PIXELS = 8;   // Length on screen (in pixels) of a segment along the ring
+    static constexpr GLint RING_MIN_SEGMENTS = 16;    // Segments around a ring, whatever its size on screen
+    static constexpr GLint RING_MAX_SEGMENTS = 512;   // Segments around a ring, when the camera is close to it
+    static constexpr GLint RING_PIPE_SEGMENTS = 16;   // Segments around the pipe of a torus ring
+
     /**
      * @brief Constructor of the class.
+     *
+     * Creates the uniform buffers shared by all the shaders and configures the
+     * reversed depth, an OpenGL context must be current.
+     ********************************************************************************/
+    RenderEngine();
+
+    /**
+     * @brief Destructor of the class.
+     ********************************************************************************/
+    ~RenderEngine();
+
+    RenderEngine(const RenderEngine &) = delete;
+    RenderEngine &operator=(const RenderEngine &) = delete;
+
+    /**
+     * @brief Builds the projection matrix shared by all the objects of the scene.
+     *
+     * The projection has no far plane and reverses the depth (1 on the near plane
+     * and 0 at infinity), with the floating point depth of the scene framebuffer
+     * the precision stays the same from the close-ups to the farthest planets.
+     * The scene framebuffer is resized to the rendered area.
+     *
+     * @param w Width of the rendered area.
+     * @param h Height of the rendered area.
+     ********************************************************************************/
+    void configureProjection(float w, float h);
+
+    /**
+     * @brief Starts the rendering of a frame in the scene framebuffer and clears it.
+     *
+     * The resolution of the frame is adapted to the GPU time of the previous ones
+     * (see the dynamicResolution module).
+     ********************************************************************************/
+    void startFrame();
+
+    /**
+     * @brief Copies the rendered frame to the window, stretched if it was rendered
+     *        with a lower resolution.
+     *
+     * It must be called before swapping the buffers of the window.
      ********************************************************************************/
-    RenderEngine() {}
+    void endFrame();
+
+    /**
+     * @brief Sets the GPU time allowed for a frame.
+     *
+     * @param budget Frame time budget (in ms), 0 to always render at the resolution
+     *               of the window.
+     ********************************************************************************/
+    void setFrameBudget(float budget);
+
+    /**
+     * @brief Retrieves the scale of the window resolution used by the frames.
+     ********************************************************************************/
+    float getResolutionScale() const;
+
+    /**
+     * @brief Retrieves the GPU times of the previous frames read by `startFrame()`,
+     *        they are a few frames late and several can arrive together.
+     *
+     * @return The times in ms, oldest first, none if no result was ready.
+     ********************************************************************************/
+    const std::vector<double> &getNewGpuFrameTimes() const;
+
+    /**
+     * @brief Retrieves the length on screen (in pixels) of one unit seen from a
+     *        distance of one unit, divide it by the distance of an object.
+     ********************************************************************************/
+    float getPixelScale() const;
+
+    /**
+     * @brief Sends the data that stays the same during the whole frame.
+     *
+     * The camera view, the projection, the light and the material coefficients are
+     * sent once in uniform buffers, every shader then reads them from there.
+     * The frustum used to skip the hidden objects is also updated.
+     * It must be called once per frame, before any drawing.
+     *
+     * @param camera The camera the scene is seen from.
+     * @param light The light source of the scene.
+     ********************************************************************************/
+    void updateFrameUniforms(const Camera &camera, const Light &light);
 
     /**
      * @brief Clears the display of the scene.   (CLEAR THE SCENE RATHER... MIGHT BE SMART TO RENAME IT clearScene)
@@ -70,48 +173,70 @@ public:
     /* ========================================================================================================== */
 
     /**
-     * @brief Create a Sphere object, fill the vao and vbo with
-     * its data.
-     *
-     * It configures the depth of the scene in OpenGL
+     * @brief Create a Sphere object and add it to the shared geometry.
      ********************************************************************************/
     void createSphere();
 
     /**
-     * @brief Create a Torus object, fill the vao and vbo with
-     * its data.
+     * @brief Adds prebuilt meshes to the shared geometry, in place of
+     *        `createSphere()` and `integrateSkybox()`.
+     *
+     * The vertices and the indices are the content of the shared geometry read
+     * back from a scene snapshot (see the sceneSnapshot module), copied with a
+     * single upload.
      *
-     * It configures the depth of the scene in OpenGL
-     * @param innerEdgeDist The distance from the center of the inner edge of the torus
-     * @param thickness The diameter of the torus pipe
+     * @param vertices The vertices, in the format of the shared geometry.
+     * @param nbVertices Amount of vertices.
+     * @param indices The indices of the meshes.
+     * @param nbIndices Amount of indices.
+     * @param sphereMesh Range of the sphere in the given data.
+     * @param skyboxMesh Range of the cube of the skybox in the given data.
      ********************************************************************************/
-    void createTorus(GLfloat innerEdgeDist, GLfloat thickness);
+    void integrateMeshes(const PackedVertex *vertices, GLsizei nbVertices, const uint32_t *indices, GLsizei nbIndices,
+                         const ArenaMesh &sphereMesh, const ArenaMesh &skyboxMesh);
+
+    /**
+     * @brief Retrieves the shared geometry and the ranges of the sphere and of
+     *        the cube of the skybox in it.
+     ********************************************************************************/
+    const GeometryArena &getGeometry() const;
+    const ArenaMesh &getSphereMesh() const;
+    const ArenaMesh &getSkyboxMesh() const;
 
     /**
      * @brief Configures the environment to allow the rendering.
      *
-     * Bind the textures of the planet object and the VAO.
+     * Bind the textures of a body and the VAO of the shared geometry.
      *
-     * @param planet A PlanetObject (defined in the planetObject module) we want
-     *               to configure the drawing environment for.
+     * @param material The material (defined in the components module) of the
+     *                 body we want to configure the drawing environment for.
      ********************************************************************************/
-    void start(const PlanetObject &planet);
+    void start(const MaterialComponent &material);
 
     /**
-     * @brief Launches the rendering of the given planet.
+     * @brief Draws the bodies of the solar system one by one, then their rings.
      *
-     * @param planet A PlanetObject (defined in the planetObject module) we want
-     *               to draw.
+     * The bodies outside of the frustum of the camera are skipped, the others
+     * are drawn at the shading level matching their size on screen (see
+     * `selectShadingLevel()`): the smaller they are, the cheaper their fragments
+     * are. The satellites are only drawn in the focused mode.
+     *
+     * The visible bodies are gathered in a list of the frame arena (glimac
+     * FrameArena) and sorted by shader and textures, so each program and each
+     * texture is bound once per frame.
+     *
+     * @param solarSys The solar system to draw.
+     * @param camera The camera the scene is seen from.
      ********************************************************************************/
-    void draw(PlanetObject &planet, Camera &camera, const Light &light);
+    void drawBodies(SolarSystem &solarSys, Camera &camera);
 
     /**
      * @brief Put an end to the current rendering environment.
      *
-     * @param planet A PlanetObject (defined in the planetObject module) we want
-     *               to put an end to the drawing environment for.
+     * @param material The material (defined in the components module) of the
+     *                 body we want to put an end to the drawing environment for.
      ********************************************************************************/
-    void end(const PlanetObject &planet);
+    void end(const MaterialComponent &material);
 
     /* ========================================================================================================== */
     /* =                                                SKYBOX                                                  = */
@@ -128,7 +253,7 @@ public:
     /**
      * @brief Configures the environment to allow the rendering.
      *
-     * Bind the textures of the skybox object and the VAO.
+     * Bind the textures of the skybox object and the VAO of the shared geometry.
      *
      * @param skybox A Skybox (see the skybox module) we want
      *               to configure the drawing environment for.
@@ -154,43 +279,129 @@ public:
     /**
      * @brief Configures the environment to allow the rendering.
      *
-     * Bind the textures of the torus object and the VAO.
+     * Bind the textures of the torus object and the VAO of the shared geometry.
      *
-     * @param planet The planet whose ring's texture we want to configure
+     * @param ring The ring whose texture we want to configure
      ********************************************************************************/
-    void startRing(const PlanetObject &planet);
+    void startRing(const RingComponent &ring);
 
     /**
-     * @brief Launches the rendering of the given planet.
+     * @brief Launches the rendering of the ring of the given planet.
      *
-     * @param planet A PlanetObject (defined in the planetObject module) we want
-     *               to draw.
+     * The ring is drawn with its own matrix, a child of the planet in the scene
+     * graph. It is built by the vertex shader from its radii, the amount of
+     * segments follows its size on screen.
+     *
+     * @param solarSys The solar system storing the planet.
+     * @param planet The planet whose ring we want to draw.
+     * @param camera The camera the scene is seen from.
      ********************************************************************************/
-    void drawRing(PlanetObject &planet, Camera &camera);
+    void drawRing(SolarSystem &solarSys, Entity planet, Camera &camera);
 
     /**
      * @brief Put an end to the current rendering environment.
      *
-     * @param planet A PlanetObject (defined in the planetObject module) we want
-     *               to put an end to the drawing environment for.
+     * @param ring The ring we want to put an end to the drawing environment for.
+     ********************************************************************************/
+    void endRing(const RingComponent &ring);
+
+    /* ========================================================================================================== */
+    /* =                                              GPU DRIVEN                                                = */
+    /* ========================================================================================================== */
+
+    /**
+     * @brief Prepares the GPU driven rendering of the bodies (see the indirectRenderer module).
+     *
+     * @param applicationPath A FilePath (defined in the glimac library) describing
+     *                        the location where the app is ran.
+     * @param shaders The library sharing the shader managers.
+     * @param solarSys The solar system whose bodies are going to be drawn.
+     *
+     * @return False if the OpenGL context doesn't support it and True otherwise.
+     ********************************************************************************/
+    bool integrateIndirectRendering(const FilePath &applicationPath, ShaderLibrary &shaders, SolarSystem &solarSys);
+
+    /**
+     * @brief Tells if the GPU driven rendering is ready to be used.
+     *
+     * @return True if `integrateIndirectRendering()` succeeded.
      ********************************************************************************/
-    void endRing(const PlanetObject &planet);
+    bool hasIndirectRendering() const;
 
-    void createPlanetRing(PlanetObject &planet);
+    /**
+     * @brief Draws the whole solar system with the GPU driven path.
+     *
+     * The bodies are culled and drawn with a constant amount of calls, the rings
+     * are drawn afterwards.
+     *
+     * @param solarSys The solar system to draw.
+     * @param camera The camera the scene is seen from.
+     ********************************************************************************/
+    void drawIndirect(SolarSystem &solarSys, Camera &camera);
 
 private:
-    // Planets
-    GLuint _vbo;                  // VertexBufferObject ID
-    GLuint _vao;                  // VertexArrayObject ID
-    unsigned int _nbVertices = 0; // Amount of vertices to draw
-
-    std::vector<GLuint> _vboTorus;
-    std::vector<GLuint> _vaoTorus;
-    unsigned int _nbVerticesTorus = 0;
-
-    // Skybox
-    GLuint _vboSkybox;
-    GLuint _vaoSkybox;
-    GLuint _ibo;
-    unsigned int _nbVerticesSkybox = 0;
+    /**
+     * @brief A visible body, waiting in the draw list of the frame.
+     ********************************************************************************/
+    struct DrawPacket
+    {
+        ShaderBody *shader;                 // Shader of the shading level
+        const MaterialComponent *material;  // Textures of the body
+        glm::mat4 MVMatrix;                 // Model view matrix
+        ShadingLevel level;                 // Shading level of the body
+    };
+
+    /**
+     * @brief Adds a body to the draw list of the frame if it is in the frustum
+     *        of the camera.
+     *
+     * @param packets The draw list of the frame.
+     * @param solarSys The solar system storing the body.
+     * @param body The planet or satellite.
+     * @param viewMatrix The view matrix of the camera.
+     ********************************************************************************/
+    void addDrawPacket(FrameVector<DrawPacket> &packets, SolarSystem &solarSys, Entity body, const glm::mat4 &viewMatrix) const;
+
+    /**
+     * @brief Selects the way of drawing a planet from its radius on screen.
+     *
+     * Under `IMPOSTOR_PIXEL_RADIUS` (or when forced with `MaterialComponent::alwaysImpostor`)
+     * the planet is ray-cast, under `LOW_DETAIL_PIXEL_RADIUS` its textures are reduced
+     * to their average color and under `POINT_PIXEL_RADIUS` it is a single point.
+     * The mesh is used when the camera is inside the planet, a level without shader
+     * falls back to the more detailed ones.
+     *
+     * @param material The material of the planet to draw.
+     * @param radius Radius of the planet.
+     * @param centerVC Center of the planet in view coordinates.
+     *
+     * @return The shading level of the planet.
+     ********************************************************************************/
+    ShadingLevel selectShadingLevel(const MaterialComponent &material, float radius, const glm::vec3 &centerVC) const;
+
+    // Frame constant data
+    glm::mat4 _projMatrix = glm::mat4(1);             // Projection matrix shared by all the objects
+    float _windowWidth = 1;                            // Width of the window (in pixels)
+    float _windowHeight = 1;                           // Height of the window (in pixels)
+    float _viewportHeight = 1;                         // Height of the rendered area (in pixels)
+    RenderTarget _sceneTarget;                         // Color and floating point depth the scene is rendered into
+    GpuTimer _frameTimer;                              // GPU time of the frames
+    std::vector<double> _newGpuFrameTimes;             // Times read from the frame timer at the start of the frame
+    std::array<float, GpuTimer::DEFAULT_QUERY_COUNT> _measuredScales = {}; // Scales of the frames measured but not read yet, oldest first
+    unsigned int _firstMeasuredScale = 0;              // Index of the oldest one in _measuredScales
+    unsigned int _nbMeasuredScales = 0;                // Frames measured but not read yet
+    GpuProfiler _gpuProfiler;                          // GPU time of the passes, in profiled builds (see the profiler module)
+    DynamicResolution _resolution;                     // Resolution scale following the frame time budget
+    Frustum _frustum;                                  // Volume seen by the camera this frame
+    UniformBuffer<FrameUniforms> _frameUniforms;       // Camera, projection and light data
+    UniformBuffer<MaterialUniforms> _materialUniforms; // Material coefficients
+
+    // Meshes, all stored in the same buffers and read through the same VAO
+    GeometryArena _geometry;              // Shared vertex and index buffers
+    ArenaMesh _sphereMesh;                // Sphere of the planets
+    ArenaMesh _skyboxMesh;                // Cube of the skybox
+    GLuint _emptyVAO = 0;                 // No attribute, for the shapes built from gl_VertexID (rings, impostors, points)
+
+    // GPU driven path
+    std::unique_ptr<IndirectRenderer> _indirectRenderer; // Null if not integrated
 };
\ No newline at end of file
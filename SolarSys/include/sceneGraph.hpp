@@ -0,0 +1,123 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module contains the transform hierarchy of   =
+=  the scene (star -> planet -> moon -> ring).       =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <vector>
+#include <glimac/glm.hpp>
+
+/**
+ * @brief Hierarchy of transforms, each node has a local matrix relative to its
+ * parent and a world matrix.
+ *
+ * The nodes are stored in flat arrays, added depth first: a parent always comes
+ * before its children and the nodes of a subtree are contiguous. A world matrix
+ * is computed once by `update()` and reused by every child.
+ *
+ * Changing a local matrix marks its node as dirty, only the dirty nodes and the
+ * descendants of the recomputed nodes are computed again, the unchanged
+ * subtrees are skipped.
+ ********************************************************************************/
+class SceneGraph
+{
+public:
+    using NodeId = unsigned int;
+    static constexpr NodeId NO_PARENT = ~0u; // Parent of the roots
+
+    /**
+     * @brief Adds a node at the end of the hierarchy.
+     *
+     * The nodes are added depth first: the parent must be the last added node
+     * or one of its ancestors, otherwise std::logic_error is thrown.
+     *
+     * @param parent The parent node, NO_PARENT for a root.
+     * @param localMatrix Transform relative to the parent.
+     *
+     * @return The ID of the new node.
+     ********************************************************************************/
+    NodeId addNode(NodeId parent, const glm::mat4 &localMatrix = glm::mat4(1));
+
+    /**
+     * @brief Replaces the whole hierarchy with saved nodes (see the sceneSnapshot
+     *        module).
+     *
+     * The nodes must be given depth first, otherwise std::logic_error is thrown.
+     * The world matrices are taken as they are, nothing is computed again.
+     *
+     * @param count The amount of nodes.
+     * @param parents The parent of each node.
+     * @param localMatrices The transform of each node relative to its parent.
+     * @param worldMatrices The transform of each node in the world.
+     ********************************************************************************/
+    void restore(unsigned int count, const NodeId *parents, const glm::mat4 *localMatrices, const glm::mat4 *worldMatrices);
+
+    /**
+     * @brief Sets the transform of a node relative to its parent, its world
+     *        matrix is computed by the next `update()`.
+     *
+     * @param node The node.
+     * @param localMatrix Transform relative to the parent.
+     ********************************************************************************/
+    void setLocalMatrix(NodeId node, const glm::mat4 &localMatrix);
+
+    /**
+     * @brief Retrieves the transform of a node relative to its parent.
+     ********************************************************************************/
+    const glm::mat4 &getLocalMatrix(NodeId node) const;
+
+    /**
+     * @brief Retrieves the transform of a node in the world, as computed by the
+     *        last `update()`.
+     ********************************************************************************/
+    const glm::mat4 &getWorldMatrix(NodeId node) const;
+
+    /**
+     * @brief Retrieves the parent of a node, NO_PARENT for a root.
+     ********************************************************************************/
+    NodeId getParent(NodeId node) const;
+
+    /**
+     * @brief Retrieves the amount of nodes.
+     ********************************************************************************/
+    unsigned int size() const;
+
+    /**
+     * @brief Computes the world matrices of the whole hierarchy.
+     ********************************************************************************/
+    void update();
+
+    /**
+     * @brief Computes the world matrices of a node and of its descendants.
+     *
+     * The world matrix of the parent of the node must be up to date.
+     *
+     * @param node The root of the subtree.
+     ********************************************************************************/
+    void updateSubtree(NodeId node);
+
+private:
+    /**
+     * @brief Computes the world matrices of a range of nodes.
+     *
+     * The parents outside of the range must be up to date.
+     *
+     * @param first The first node.
+     * @param end The node after the last one.
+     ********************************************************************************/
+    void update(NodeId first, NodeId end);
+
+    std::vector<glm::mat4> _localMatrices; // Transforms relative to the parents
+    std::vector<glm::mat4> _worldMatrices; // Transforms in the world
+    std::vector<NodeId> _parents;          // Parent of each node, always a smaller index
+    std::vector<NodeId> _subtreeEnds;      // Node following the last descendant of each node
+    std::vector<bool> _dirty;              // Local matrix changed, or world matrix recomputed during the current update
+};
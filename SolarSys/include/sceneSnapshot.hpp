@@ -0,0 +1,219 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module saves the scene built at the start    =
+=  in a binary file, the next starts map it instead  =
+=  of building the scene again.                      =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glimac/MappedFile.hpp>
+
+#include "include/solarSystem.hpp"
+#include "include/renderEngine.hpp"
+
+/**
+ * @brief The scene baked by a previous start, memory-mapped by the next ones.
+ *
+ * After a versioned header, the file holds:
+ *   - the tables of the entities: data, material, hierarchy and nodes of each
+ *     body, and the rings,
+ *   - the nodes of the scene graph with their matrices at the epoch,
+ *   - the content of the shared geometry (the sphere and the cube of the
+ *     skybox), already in the packed format of the GPU buffers,
+ *   - the paths of the textures, the bodies reference them by index.
+ *
+ * The shaders are referenced by their ShaderFeature flags, the library builds
+ * the same permutations (from its binary cache). Restoring the scene is a few
+ * table copies and a single upload of the geometry.
+ *
+ * A snapshot is tied to the executable which wrote it (its size and its
+ * modification time), so a new build bakes it again. FORMAT_VERSION must change
+ * with the layout of the file.
+ ********************************************************************************/
+class SceneSnapshot
+{
+public:
+    static constexpr uint32_t MAGIC = 0x504E5353;  // "SSNP" at the start of the file
+    static constexpr uint32_t FORMAT_VERSION = 1;  // Layout of the file
+    static constexpr uint32_t NO_REFERENCE = ~0u;  // Texture or shader which isn't in the snapshot
+    static constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+    /**
+     * @brief Constructor of the class.
+     *
+     * @param applicationPath A FilePath (defined in the glimac library) describing
+     *                        the location where the app is ran.
+     ********************************************************************************/
+    SceneSnapshot(const FilePath &applicationPath);
+
+    /**
+     * @brief Maps the snapshot written by a previous start.
+     *
+     * @return False if there is none, if it is damaged or if it was written by
+     *         another build or in another format.
+     ********************************************************************************/
+    bool open();
+
+    /**
+     * @brief Forgets a snapshot which can't be restored: unmaps it and deletes
+     *        the textures it loaded, before the scene is built from scratch.
+     ********************************************************************************/
+    void close();
+
+    /**
+     * @brief Loads a texture, its path is the reference saved in the snapshot.
+     *
+     * @param path Path of the texture.
+     *
+     * @return The ID of the texture (see `RenderEngine::createTexture()`).
+     ********************************************************************************/
+    GLuint loadTexture(const char *path);
+
+    /**
+     * @brief Fills an empty solar system with the mapped bodies.
+     *
+     * The referenced textures are loaded and the shaders are requested from the
+     * library. Throws a std::runtime_error if the tables don't match, the meshes
+     * are checked too so `restore(RenderEngine &)` can't fail afterwards.
+     *
+     * @param shaders The library sharing the shader managers between the planets.
+     * @param solarSys A SolarSystem object we want to fill.
+     ********************************************************************************/
+    void restore(ShaderLibrary &shaders, SolarSystem &solarSys);
+
+    /**
+     * @brief Uploads the mapped meshes to the shared geometry of a render engine,
+     *        in place of `RenderEngine::createSphere()` and `RenderEngine::integrateSkybox()`.
+     *
+     * @param renderEng The render engine.
+     ********************************************************************************/
+    void restore(RenderEngine &renderEng) const;
+
+    /**
+     * @brief Writes the snapshot of a scene built from scratch.
+     *
+     * The file is written beside and renamed, a start mapping the previous one
+     * keeps reading it.
+     *
+     * @param solarSys The solar system, its textures must come from `loadTexture()`.
+     * @param renderEng The render engine, with the sphere and the skybox integrated.
+     *
+     * @return False if the file can't be written.
+     ********************************************************************************/
+    bool write(const SolarSystem &solarSys, const RenderEngine &renderEng) const;
+
+private:
+    /**
+     * @brief Range of a mesh in the shared geometry.
+     ********************************************************************************/
+    struct BakedMesh
+    {
+        uint32_t mode;
+        uint32_t indexCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+    };
+
+    /**
+     * @brief Beginning of the file, the offsets are in bytes from its start.
+     ********************************************************************************/
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t buildStamp; // Size and modification time of the executable
+        uint64_t fileSize;
+        uint32_t nbBodies;
+        uint32_t nbRings;
+        uint32_t nbNodes;
+        uint32_t nbVertices;
+        uint32_t nbIndices;
+        uint32_t nbTextures;
+        BakedMesh sphereMesh;
+        BakedMesh skyboxMesh;
+        uint64_t bodiesOffset;
+        uint64_t ringsOffset;
+        uint64_t parentsOffset;
+        uint64_t localMatricesOffset;
+        uint64_t worldMatricesOffset;
+        uint64_t verticesOffset;
+        uint64_t indicesOffset;
+        uint64_t texturePathsOffset; // The paths one after the other, each one ends with a null character
+        uint64_t texturePathsSize;
+    };
+
+    /**
+     * @brief Components of a body, the entity is its index in the table.
+     ********************************************************************************/
+    struct BakedBody
+    {
+        PlanetValues data;
+        uint32_t orbitNode;
+        uint32_t bodyNode;
+        uint32_t parent;
+        uint32_t firstChild;
+        uint32_t nbChildren;
+        uint32_t nbTextures;
+        uint32_t textures[MaterialComponent::MAX_TEXTURES]; // Index of the texture paths
+        uint32_t shaders[NB_SHADING_LEVELS];                 // Features of each shading level
+        uint32_t alwaysImpostor;
+    };
+
+    /**
+     * @brief Ring of a planet.
+     ********************************************************************************/
+    struct BakedRing
+    {
+        uint32_t planet;
+        uint32_t texture; // Index of the texture paths
+        uint32_t shader;  // Features
+        uint32_t node;
+        float innerRadius;
+        float outerRadius;
+        uint32_t flat;
+    };
+
+    /**
+     * @brief Retrieves a table of the mapped file.
+     *
+     * Throws a std::runtime_error if it goes past the end of the file.
+     *
+     * @param offset Position of the table (in bytes).
+     * @param count Amount of elements.
+     ********************************************************************************/
+    template <typename T>
+    const T *getTable(uint64_t offset, uint64_t count) const;
+
+    /**
+     * @brief Retrieves the header of the mapped file.
+     ********************************************************************************/
+    const Header &getHeader() const;
+
+    /**
+     * @brief Retrieves the index of the path of a loaded texture, NO_REFERENCE if
+     *        it wasn't loaded by `loadTexture()`.
+     ********************************************************************************/
+    uint32_t getTextureIndex(GLuint texture) const;
+
+    /**
+     * @brief Retrieves a loaded texture from its index, 0 (no texture) for
+     *        NO_REFERENCE.
+     ********************************************************************************/
+    GLuint getTexture(uint32_t index) const;
+
+    FilePath _file;                         // Location of the snapshot
+    uint64_t _buildStamp;                   // Stamp of the executable
+    MappedFile _mapping;                    // The snapshot, once opened
+    std::vector<std::string> _texturePaths; // Path of each loaded texture
+    std::vector<GLuint> _textures;          // ID of each loaded texture
+};
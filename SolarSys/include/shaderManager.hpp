@@ -13,28 +13,70 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <typeindex>
 #include <vector>
 #include <glimac/Program.hpp>
+#include <glimac/ProgramRegistry.hpp>
 
 #include "include/pathStorage.hpp"
+#include "include/uniformBuffer.hpp"
 
 using namespace glimac;
 
 /**
  * @brief Structure that allows for better management of the shaders.
+ *
+ * The program comes from a ProgramRegistry (defined in the glimac library) and
+ * may still be compiling when the shader manager is built, the uniforms are
+ * retrieved by `loadUniforms()` once it is ready (see the ShaderLibrary class).
  ********************************************************************************/
 class ShaderManager
 {
+    std::shared_ptr<Program> _sharedProgram; // Keeps alive the program of the registry
+
 protected:
     /**
      * @brief Constructor of the class.
      *
+     * @param registry The registry building the programs.
      * @param applicationPath A FilePath (defined in the glimac library) describing
      *                        the location where the app is ran.
      * @param vertexShaderPath A path to the vertex shader.
      * @param fragmentShaderPath A path to the fragment shader.
+     * @param defines Lines inserted after the version of the shaders (see ProgramRegistry).
+     ********************************************************************************/
+    ShaderManager(ProgramRegistry &registry, const FilePath &applicationPath, const char *vertexShaderPath, const char *fragmentShaderPath,
+                  const std::string &defines = "");
+
+    /**
+     * @brief Links each texture uniform to the texture unit of the same index.
+     *
+     * The texture units never change, so this is done once when the program is
+     * built instead of on every draw.
+     ********************************************************************************/
+    void bindTextureUnits();
+
+    /**
+     * @brief Links a uniform block of the program to the binding point of its
+     * uniform buffer (see the uniformBuffer module).
+     *
+     * Nothing is done if the program doesn't use the block.
+     *
+     * @tparam BlockType A structure describing the block (FrameUniforms, MaterialUniforms...).
      ********************************************************************************/
-    ShaderManager(const FilePath &applicationPath, const char *vertexShaderPath, const char *fragmentShaderPath);
+    template <typename BlockType>
+    void bindUniformBlock()
+    {
+        GLuint blockIndex = glGetUniformBlockIndex(m_Program.getGLId(), BlockType::BLOCK_NAME);
+        if (blockIndex != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(m_Program.getGLId(), blockIndex, BlockType::BINDING);
+        }
+    }
 
 public:
     /**
@@ -42,71 +84,124 @@ public:
      ********************************************************************************/
     virtual ~ShaderManager() {}
 
-    Program m_Program;            // GLSL Program (defined in glimac library)
-    GLint uMVPMatrix;             // Uniform ID for Projection ModelView matrix
+    /**
+     * @brief Retrieves the uniform IDs and binds the textures and the uniform blocks.
+     *
+     * Must be called once the program is built (see `ProgramRegistry::finish()`).
+     ********************************************************************************/
+    virtual void loadUniforms();
+
+    Program &m_Program;           // GLSL Program (defined in glimac library), shared with the other users of the same files
     GLint uMVMatrix;              // Uniform ID for ModelView matrix
     GLint uNormalMatrix;          // Uniform ID for Normal matrix
     std::vector<GLint> uTextures; // Texture IDs
 
-    // Light components
-    GLint uKd;
-    GLint uKs;
-    GLint uShininess;
-    GLint uLightPosition;
-    GLint uLightIntensity;
-    GLint uIsLighted;
-    GLint uAmbientLight;
+    // Projection, view, light and material values are read from the uniform blocks
 };
 
 /**
- * @brief Shader structure for a single fully lighted texture.
+ * @brief Features of the body shader (see body.fs.glsl), combined as flags.
+ *
+ * Each combination is a permutation compiled with the matching defines, so a
+ * program only runs the work it needs.
  ********************************************************************************/
-class Shader1FullyLightedTexture : public ShaderManager
+enum ShaderFeature : unsigned int
 {
-public:
-    /**
-     * @brief Constructor of the class.
-     *
-     * @param applicationPath A FilePath (defined in the glimac library) describing
-     *                        the location where the app is ran.
-     ********************************************************************************/
-    Shader1FullyLightedTexture(const FilePath &applicationPath);
+    SHADER_EMISSIVE = 0,            // No lighting, the texture is shown as it is (the sun, the skybox)
+    SHADER_LIGHTED = 1 << 0,        // Blinn-Phong lighting
+    SHADER_SECOND_TEXTURE = 1 << 1, // A second texture added to the first one (the clouds of the Earth)
+    SHADER_RING = 1 << 2,           // Ring built from gl_VertexID (see ring.vs.glsl)
+    SHADER_IMPOSTOR = 1 << 3,       // Sphere ray-cast on a screen aligned quad (see impostor.vs.glsl)
+    SHADER_AVERAGE_COLOR = 1 << 4,  // Average color of the textures and diffuse lighting only (bodies a few pixels wide)
+    SHADER_POINT = 1 << 5,          // Single point at the center of the body (see point.vs.glsl), with SHADER_AVERAGE_COLOR
+    SHADER_INDIRECT = 1 << 6,       // Bodies of the GPU driven path (see indirect.vs.glsl), textures read from an array
 };
 
 /**
- * @brief Shader structure for single texture.
+ * @brief Shader structure for a permutation of the body shader.
  ********************************************************************************/
-class Shader1Texture : public ShaderManager
+class ShaderBody : public ShaderManager
 {
 public:
+    static constexpr unsigned int FEATURE_COUNT = 7;                       // Amount of ShaderFeature flags
+    static constexpr unsigned int PERMUTATION_COUNT = 1 << FEATURE_COUNT; // Features are below PERMUTATION_COUNT (see `isValid()`)
+
     /**
      * @brief Constructor of the class.
      *
+     * @param registry The registry building the programs.
      * @param applicationPath A FilePath (defined in the glimac library) describing
      *                        the location where the app is ran.
+     * @param features A combination of ShaderFeature flags.
      ********************************************************************************/
-    Shader1Texture(const FilePath &applicationPath);
-};
+    ShaderBody(ProgramRegistry &registry, const FilePath &applicationPath, unsigned int features);
 
-/**
- * @brief Shader structure for two textures.
- ********************************************************************************/
-class Shader2Texture : public ShaderManager
-{
-public:
     /**
-     * @brief Constructor of the class.
+     * @brief Tells if some features make a permutation that can be built.
      *
-     * @param applicationPath A FilePath (defined in the glimac library) describing
-     *                        the location where the app is ran.
+     * A single vertex shader builds the shape, so SHADER_RING, SHADER_IMPOSTOR,
+     * SHADER_POINT and SHADER_INDIRECT exclude each other. SHADER_POINT needs
+     * SHADER_AVERAGE_COLOR (a point has no texture coordinates) and SHADER_INDIRECT
+     * reads the texture layers of each body, it can't take SHADER_SECOND_TEXTURE
+     * or SHADER_AVERAGE_COLOR.
+     *
+     * @param features A combination of ShaderFeature flags.
+     *
+     * @return True if the features can be given to `ShaderLibrary::getBody()`.
      ********************************************************************************/
-    Shader2Texture(const FilePath &applicationPath);
+    static bool isValid(unsigned int features);
+
+    /**
+     * @brief Retrieves the defines selecting the features in the shader sources.
+     *
+     * @param features A combination of ShaderFeature flags.
+     *
+     * @return One "#define" line per feature.
+     ********************************************************************************/
+    static std::string getDefines(unsigned int features);
+
+    /**
+     * @brief Retrieves the vertex shader matching some features.
+     *
+     * @param features A combination of ShaderFeature flags.
+     *
+     * @return The relative path of the vertex shader (see PathStorage).
+     ********************************************************************************/
+    static const char *getVertexShader(unsigned int features);
+
+    /**
+     * @brief Retrieves the uniform IDs, including the ones of the second texture
+     *        and of the ring shape.
+     ********************************************************************************/
+    void loadUniforms() override;
+
+    /**
+     * @brief Retrieves the features of the permutation.
+     *
+     * @return A combination of ShaderFeature flags.
+     ********************************************************************************/
+    unsigned int getFeatures() const;
+
+    // Ring shape (SHADER_RING only)
+    GLint uRingRadii = -1;    // Uniform ID for the inner and outer radius
+    GLint uRingSegments = -1; // Uniform ID for the amount of segments around and across the ring
+    GLint uFlatRing = -1;     // Uniform ID selecting the flat annulus instead of the torus
+
+private:
+    unsigned int _features; // Combination of ShaderFeature flags
 };
 
 /**
- * @brief Shader structure for two textures.
+ * @brief Creates the shader managers and shares them between the objects.
+ *
+ * There is a single shader manager of each type (or of each permutation of the
+ * body shader), whatever the amount of objects using it. Their programs come from a ProgramRegistry (defined in the glimac
+ * library): each distinct program is compiled once and all of them are compiled
+ * at the same time, until `finish()` is called. The linked programs are cached
+ * on disk.
+ * The shader managers can't be used before `finish()`.
  ********************************************************************************/
-class ShaderTorusTexture : public ShaderManager
+class ShaderLibrary
 {
 public:
     /**
@@ -115,5 +210,70 @@ public:
      * @param applicationPath A FilePath (defined in the glimac library) describing
      *                        the location where the app is ran.
      ********************************************************************************/
-    ShaderTorusTexture(const FilePath &applicationPath);
-};
\ No newline at end of file
+    ShaderLibrary(const FilePath &applicationPath);
+
+    ShaderLibrary(const ShaderLibrary &) = delete;
+    ShaderLibrary &operator=(const ShaderLibrary &) = delete;
+
+    /**
+     * @brief Retrieves the shader manager of a type, it is created on the first call.
+     *
+     * @tparam ShaderType A ShaderManager derived class.
+     *
+     * @return A shared_ptr (defined in the memory library) of the shader manager.
+     ********************************************************************************/
+    template <typename ShaderType>
+    std::shared_ptr<ShaderType> get()
+    {
+        _nbRequests++;
+
+        auto &shader = _shaders[std::type_index(typeid(ShaderType))];
+        if (!shader)
+        {
+            shader = std::make_shared<ShaderType>(_registry, _applicationPath);
+            _pending.push_back(shader);
+        }
+        return std::static_pointer_cast<ShaderType>(shader);
+    }
+
+    /**
+     * @brief Retrieves a permutation of the body shader, it is created on the first call.
+     *
+     * Throws a std::invalid_argument if the features aren't valid (see
+     * `ShaderBody::isValid()`).
+     *
+     * @param features A combination of ShaderFeature flags.
+     *
+     * @return A shared_ptr (defined in the memory library) of the shader manager.
+     ********************************************************************************/
+    std::shared_ptr<ShaderBody> getBody(unsigned int features);
+
+    /**
+     * @brief Requests every valid permutation of the body shader, they are built
+     * by the next call to `finish()` and cached on disk with the other programs.
+     ********************************************************************************/
+    void precompileBodies();
+
+    /**
+     * @brief Waits for the programs being compiled and loads the uniforms of the
+     * new shader managers.
+     *
+     * Throws a std::runtime_error if a program can't be built.
+     ********************************************************************************/
+    void finish();
+
+    /**
+     * @brief Writes the compile and link time of each program.
+     *
+     * @param stream Where to write.
+     ********************************************************************************/
+    void printStats(std::ostream &stream) const;
+
+private:
+    FilePath _applicationPath;                                     // Location where the app is ran
+    ProgramRegistry _registry;                                     // Compiles each distinct program once
+    std::map<std::type_index, std::shared_ptr<ShaderManager>> _shaders; // Shader manager of each type
+    std::map<unsigned int, std::shared_ptr<ShaderBody>> _bodies;        // Shader manager of each body permutation
+    std::vector<std::shared_ptr<ShaderManager>> _pending;          // Shader managers waiting for their uniforms
+    unsigned int _nbRequests = 0;                                  // Amount of calls to `get()`
+};
@@ -36,12 +36,10 @@ public:
      * Makes a skybox representation using the index buffer system.
      * This means that there are both a data storage and an index one.
      *
-     * @param filePath A FilePath object (see the FilePath class in glimac).
+     * @param shaders The library sharing the shader managers.
      * @param textID An ID that describes a texture that has been loaded.
-     * @param w The width of the window (used for the projection matrix).
-     * @param h The height of the window (used for the projection matrix).
      ********************************************************************************/
-    Skybox(FilePath filePath, GLuint textID, float w, float h);
+    Skybox(ShaderLibrary &shaders, GLuint textID);
 
     /**
      * @brief Retrieves the number of vertices.
@@ -85,7 +83,7 @@ public:
     /**
      * @brief Retrieves the transformation matrices of the cube.
      *
-     * Brings a Matrices object (see the Matrices module), that contains MV, MVP and
+     * Brings a Matrices object (see the Matrices module), that contains MV and
      * normals matrices.
      *
      * @return A reference on the matrices.
@@ -118,13 +116,11 @@ private:
      * Creates a cube in 3D dimension thanks to 8 points defined and indexes that
      * describe how this shape can be drawn with triangles.
      *
-     * @param filePath A FilePath object.
+     * @param shaders The library sharing the shader managers.
      * @param textID An integer index describing the information of the texture to
      *               send to the shader.
-     * @param w The width of the window (used for the projection matrix).
-     * @param h The height of the window (used for the projection matrix).
      ********************************************************************************/
-    void build(FilePath filePath, GLuint textID, float w, float h);
+    void build(ShaderLibrary &shaders, GLuint textID);
 
     std::vector<ShapeVertex> _cube;         // Vertices that describe the shape
     std::shared_ptr<ShaderManager> _shader; // Shader binded to the cube
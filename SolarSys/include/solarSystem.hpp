@@ -5,9 +5,9 @@
 =													 =
 =													 =
 =  This module defines the SolarSystem class.        =
-=  A SolarSystem object contains planets and has     =
-=  several methods to iterate over them, access      =
-=  them, add new planets, ...                        =
+=  A SolarSystem object stores the components of     =
+=  the planets and of their satellites, and moves    =
+=  them.                                             =
 =													 =
 ======================================================
 */
@@ -15,141 +15,208 @@
 #pragma once
 
 #include <vector>
-#include <iterator>
 
-#include "include/planetObject.hpp"
+#include "include/components.hpp"
 
 /**
  * @brief A SolarSystem object
  *
- * It is a PlanetObject (defined in the planetObject module) container.
+ * The bodies are entities, their components (see the components module) are
+ * stored in dense arrays. The satellites of a planet are created right after
+ * it, so the bodies of a planet are contiguous in every array and the systems
+ * walk them without chasing pointers.
  ********************************************************************************/
 class SolarSystem
 {
 private:
+    ComponentArray<OrbitComponent> _orbits;          // Every body
+    ComponentArray<TransformComponent> _transforms;  // Every body
+    ComponentArray<MaterialComponent> _materials;    // Every body
+    ComponentArray<HierarchyComponent> _hierarchies; // Every body
+    ComponentArray<RingComponent> _rings;            // Planets with a ring
+
+    std::vector<Entity> _planets; // Planets, in the order they were added
+    unsigned int _nbEntities = 0;
+    SceneGraph _sceneGraph;       // Transforms of the planets, of their rings and of their satellites
+    SceneGraph::NodeId _starNode; // Root of the scene graph, the planets orbit around it
+
+    /**
+     * @brief Creates the entity of a body with all the components of a body.
+     *
+     * @param data Information about the body.
+     * @param material Textures and shaders of the body.
+     * @param parent The planet of a satellite, NO_ENTITY for a planet.
+     * @param parentNode The node the body orbits around.
+     *
+     * @return The handle of the body.
+     ********************************************************************************/
+    Entity createBody(const PlanetData &data, const MaterialComponent &material, Entity parent, SceneGraph::NodeId parentNode);
+
     /**
-     * @brief Iterator class used to iterate over the planets stored in
-     * the solar system.
-     ********************************************************************************/
-    class Iterator
-    {
-    public:
-        using iterator_category = std::forward_iterator_tag; // Want it to be forward to allow read and write operations
-        using difference_type = std::ptrdiff_t;
-        using value_type = PlanetObject;
-        using pointer = PlanetObject *;
-        using reference = PlanetObject &;
-
-        /**
-         * @brief Constructor of the class.
-         ********************************************************************************/
-        Iterator(std::vector<std::unique_ptr<PlanetObject>> &vec, size_t index);
-
-        /**
-         * @brief Moves the pointer of the iterator on the next element (after expression).
-         ********************************************************************************/
-        Iterator &operator++();
-
-        /**
-         * @brief Moves the pointer of the iterator on the next element (before expression).
-         ********************************************************************************/
-        Iterator operator++(int);
-
-        /**
-         * @brief Comparison operator (equality).
-         *
-         * Two iterators are equals if they points to the same index.
-         *
-         * @param other An iterator.
-         *
-         * @return True if the iterators are equals and False otherwise.
-         ********************************************************************************/
-        bool operator==(const Iterator &other) const;
-
-        /**
-         * @brief Comparison operator (unequality).
-         *
-         * @param other An iterator.
-         *
-         * @return True if the iterators aren't equals and False otherwise.
-         ********************************************************************************/
-        bool operator!=(const Iterator &other) const;
-
-        /**
-         * @brief Dereferencing operator.
-         *
-         * @return The object stored in the pointer.
-         ********************************************************************************/
-        reference operator*() const;
-
-        /**
-         * @brief Arrow operator.
-         *
-         * @return The pointer that stores the object.
-         ********************************************************************************/
-        pointer operator->() const;
-
-    private:
-        std::vector<std::unique_ptr<PlanetObject>> *planetsVec; // Storage of the Planets in the iterator context
-        size_t currentIndex;                                    // Value of the current index pointed by the iterator
-    };
-
-    std::vector<std::unique_ptr<PlanetObject>> _planets; // Planets storage (in SolarSystem)
+     * @brief Compute the matrix of a satellite relative to the orbit node of its planet.
+     *
+     * The world matrix is computed when the planet updates its subtree.
+     *
+     * @param satellite The satellite.
+     * @param rotation A float number that give information about the time spent.
+     ********************************************************************************/
+    void updateSatelliteMatrix(Entity satellite, float rotation);
 
 public:
     /**
      * @brief Constructor of the class.
      ********************************************************************************/
-    SolarSystem() {}
+    SolarSystem() : _starNode{_sceneGraph.addNode(SceneGraph::NO_PARENT)} {}
 
     /**
-     * @brief Adds a new planet.
+     * @brief Adds a new planet, orbiting around the sun.
+     *
+     * Its ring and its satellites must be added right after it.
      *
-     * @param planet A PlanetObject (defined in the planetObject module) to add
+     * @param data Information about the planet (defined in the planetData module).
+     * @param material Textures and shaders of the planet.
+     *
+     * @return The handle of the planet.
      ********************************************************************************/
-    void addPlanet(std::unique_ptr<PlanetObject> planet);
+    Entity addPlanet(const PlanetData &data, const MaterialComponent &material);
 
     /**
-     * @brief Get a collection of all the planets stored.
+     * @brief Adds a ring to the last added planet, before its satellites.
+     *
+     * The radii come from the data of the planet. Throws std::logic_error if the
+     * planet isn't the last added body.
      *
-     * @return A vector containing all the PlanetObject (defined in the planetObject module)
-     *         stored.
+     * @param planet The planet.
+     * @param texture ID of the texture of the ring.
+     * @param shader Shader of the ring, owned by the ShaderLibrary.
      ********************************************************************************/
-    const std::vector<std::unique_ptr<PlanetObject>> &getAllPlanets() const;
+    void addRing(Entity planet, GLuint texture, ShaderBody *shader);
 
     /**
-     * @brief Destructor of the class.
+     * @brief Adds a satellite to the last added planet.
+     *
+     * Throws std::logic_error if the planet isn't the last added one.
+     *
+     * @param planet The planet.
+     * @param data Information about the satellite (defined in the planetData module).
+     * @param material Textures and shaders of the satellite.
+     *
+     * @return The handle of the satellite.
      ********************************************************************************/
-    ~SolarSystem();
+    Entity addSatellite(Entity planet, const PlanetData &data, const MaterialComponent &material);
 
     /**
-     * @brief Returns a pointer on the first planet.
+     * @brief Adds a body read back from a scene snapshot (see the sceneSnapshot
+     *        module), nothing is computed.
+     *
+     * The bodies must be restored in the order of their entities, the nodes of
+     * their transforms come from the scene graph restored with them.
+     *
+     * @param data Information about the body.
+     * @param material Textures and shaders of the body.
+     * @param transform Nodes of the body in the scene graph.
+     * @param hierarchy Planet or satellites of the body.
      *
-     * @return A pointer on the first planet.
+     * @return The handle of the body.
      ********************************************************************************/
-    Iterator begin();
+    Entity restoreBody(const PlanetData &data, const MaterialComponent &material, const TransformComponent &transform, const HierarchyComponent &hierarchy);
 
     /**
-     * @brief Returns the end value of the iterator.
+     * @brief Adds a ring read back from a scene snapshot to a restored planet.
      *
-     * @return A pointer on the end of the of planet container
+     * @param planet The planet.
+     * @param ring The ring, its node comes from the restored scene graph.
+     ********************************************************************************/
+    void restoreRing(Entity planet, const RingComponent &ring);
+
+    /**
+     * @brief Apply transformations on the matrices of a planet.
+     *
+     * The local matrices are set and the world matrices of the subtree of the
+     * planet are computed again.
+     *
+     * @param planet The planet.
+     * @param rotation A float value that determines how much do we rotate.
+     * @param updateSatellites If true, then the satellites matrices are also
+     *                         updated.
+     ********************************************************************************/
+    void updateMatrices(Entity planet, float rotation, bool updateSatellites);
+
+    /**
+     * @brief Retrieves the model matrix of a body (its world matrix in the
+     *        scene graph).
+     ********************************************************************************/
+    const glm::mat4 &getModelMatrix(Entity body) const;
+
+    /**
+     * @brief Retrieves the model matrix of the ring of a planet (its world matrix
+     *        in the scene graph).
+     ********************************************************************************/
+    const glm::mat4 &getRingMatrix(Entity planet) const;
+
+    /**
+     * @brief Get the size of a body from its data.
+     ********************************************************************************/
+    float getSize(Entity body) const;
+
+    /**
+     * @brief Returns wether or not a planet has a ring.
+     ********************************************************************************/
+    bool hasRing(Entity planet) const;
+
+    /**
+     * @brief Retrieves the satellites of a planet.
+     ********************************************************************************/
+    EntityRange getSatellites(Entity planet) const;
+
+    /**
+     * @brief Retrieves the components of the bodies.
      ********************************************************************************/
-    Iterator end();
+    ComponentArray<OrbitComponent> &getOrbits();
+    ComponentArray<TransformComponent> &getTransforms();
+    ComponentArray<MaterialComponent> &getMaterials();
+    ComponentArray<HierarchyComponent> &getHierarchies();
+    ComponentArray<RingComponent> &getRings();
+    const ComponentArray<OrbitComponent> &getOrbits() const;
+    const ComponentArray<TransformComponent> &getTransforms() const;
+    const ComponentArray<MaterialComponent> &getMaterials() const;
+    const ComponentArray<HierarchyComponent> &getHierarchies() const;
+    const ComponentArray<RingComponent> &getRings() const;
+
+    /**
+     * @brief Retrieves the transform hierarchy of the solar system.
+     ********************************************************************************/
+    SceneGraph &getSceneGraph();
+    const SceneGraph &getSceneGraph() const;
+
+    /**
+     * @brief Returns an iterator on the first planet.
+     ********************************************************************************/
+    std::vector<Entity>::const_iterator begin() const;
+
+    /**
+     * @brief Returns an iterator after the last planet.
+     ********************************************************************************/
+    std::vector<Entity>::const_iterator end() const;
 
     /**
      * @brief Retrieves the amount of planets stored.
      *
      * @return The number of planets.
      ********************************************************************************/
-    unsigned int nbPlanets();
+    unsigned int nbPlanets() const;
+
+    /**
+     * @brief Retrieves the amount of bodies (planets and satellites) stored.
+     ********************************************************************************/
+    unsigned int nbBodies() const;
 
     /**
      * @brief Retrieves the planet at the given index.
      *
-     *
      * @param index The index which must belong to the [0, size - 1] interval.
      *
-     * @return The planet at the given index.
+     * @return The handle of the planet at the given index.
      ********************************************************************************/
-    PlanetObject &operator[](unsigned int index);
-};
\ No newline at end of file
+    Entity getPlanet(unsigned int index) const;
+};
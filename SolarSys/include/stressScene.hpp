@@ -0,0 +1,118 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module makes up scenes of any size, without  =
+=  asset files, to find where the engine stops       =
+=  scaling.                                          =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "include/planetData.hpp"
+#include "include/textures.hpp"
+
+/**
+ * @brief Settings and generator of a synthetic scene.
+ *
+ * The sun is followed by nbPlanets planets, each one with nbMoons satellites.
+ * nbRings of the planets have a ring, spread among them. The bodies share
+ * nbTextures procedural textures of textureSize x textureSize / 2 texels.
+ *
+ * The values of a body only depend on its index: the same settings always
+ * give the same scene, whatever the order the bodies are made in. They stay in
+ * the ranges of the real bodies (distances, sizes, periods).
+ ********************************************************************************/
+class StressScene
+{
+public:
+    static constexpr unsigned int DEFAULT_MOONS = 0;           // Satellites of each planet when the command line doesn't tell
+    static constexpr unsigned int DEFAULT_TEXTURE_SIZE = 256;  // Width of the textures when the command line doesn't tell
+    static constexpr unsigned int DEFAULT_TEXTURES = 8;        // Textures when the command line doesn't tell
+    static constexpr unsigned int MAX_TEXTURE_SIZE = 8192;     // Widest texture made
+
+    /**
+     * @brief Constructor of the class.
+     *
+     * Throws a std::invalid_argument if a setting is out of its range.
+     *
+     * @param nbPlanets Amount of planets orbiting around the sun, at least 1.
+     * @param nbMoons Amount of satellites of each planet.
+     * @param nbRings Amount of planets with a ring, at most nbPlanets.
+     * @param textureSize Width of the textures (in texels), at most MAX_TEXTURE_SIZE.
+     * @param nbTextures Amount of textures shared by the bodies, at least 1.
+     ********************************************************************************/
+    StressScene(unsigned int nbPlanets, unsigned int nbMoons, unsigned int nbRings, unsigned int textureSize, unsigned int nbTextures);
+
+    /**
+     * @brief Retrieves the settings of the scene.
+     ********************************************************************************/
+    unsigned int getNbPlanets() const;
+    unsigned int getNbMoons() const;
+    unsigned int getNbRings() const;
+    unsigned int getTextureSize() const;
+    unsigned int getNbTextures() const;
+
+    /**
+     * @brief Retrieves the amount of bodies of the scene, the sun included.
+     ********************************************************************************/
+    unsigned long long getNbBodies() const;
+
+    /**
+     * @brief Tells if a planet has a ring.
+     *
+     * @param planet Index of the planet, in the [0, nbPlanets - 1] interval.
+     ********************************************************************************/
+    bool hasRing(unsigned int planet) const;
+
+    /**
+     * @brief Makes up the data of a planet.
+     *
+     * @param planet Index of the planet, in the [0, nbPlanets - 1] interval.
+     ********************************************************************************/
+    GeneratedData createPlanetData(unsigned int planet) const;
+
+    /**
+     * @brief Makes up the data of a satellite.
+     *
+     * @param planet Index of its planet, in the [0, nbPlanets - 1] interval.
+     * @param moon Index of the satellite, in the [0, nbMoons - 1] interval.
+     ********************************************************************************/
+    GeneratedData createMoonData(unsigned int planet, unsigned int moon) const;
+
+    /**
+     * @brief Draws the textures and sends them to the GPU.
+     *
+     * Each texture has bands of a color of its own, broken by noise, like a
+     * gas giant. The bodies can use them as they are or as their ring.
+     *
+     * @return The IDs of the nbTextures textures.
+     ********************************************************************************/
+    std::vector<GLuint> createTextures() const;
+
+    /**
+     * @brief Writes the settings as a JSON object.
+     ********************************************************************************/
+    void writeSettings(std::ostream &out) const;
+
+private:
+    /**
+     * @brief Retrieves a pseudo random number in [0, 1), the same for the same
+     *        seed and index.
+     ********************************************************************************/
+    static float random(uint64_t seed, uint64_t index);
+
+    unsigned int _nbPlanets;   // Planets orbiting around the sun
+    unsigned int _nbMoons;     // Satellites of each planet
+    unsigned int _nbRings;     // Planets with a ring
+    unsigned int _textureSize; // Width of the textures (in texels)
+    unsigned int _nbTextures;  // Textures shared by the bodies
+};
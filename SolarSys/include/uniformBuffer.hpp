@@ -0,0 +1,104 @@
+/*
+======================================================
+=  													 =
+=     Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module defines the uniform blocks shared by  =
+=  the shaders (std140 layout) and the buffers       =
+=  used to send them to the GPU.                     =
+=  													 =
+======================================================
+*/
+
+#pragma once
+
+#include <glad/glad.h>
+#include <glimac/glm.hpp>
+
+/**
+ * @brief Data that stays the same for every object drawn during a frame.
+ *
+ * The memory layout follows the std140 rules, it must match the `FrameBlock`
+ * declared in the shaders (only vec4 and mat4 members to avoid any padding).
+ ********************************************************************************/
+struct FrameUniforms
+{
+    static constexpr GLuint BINDING = 0;                  // Binding point of the block
+    static constexpr const char *BLOCK_NAME = "FrameBlock"; // Name of the block in the shaders
+
+    glm::mat4 viewMatrix;     // View matrix of the camera
+    glm::mat4 projMatrix;     // Projection matrix
+    glm::vec4 lightPosition;  // Position of the light in view coordinates (w is unused)
+    glm::vec4 lightIntensity; // Intensity of the light (w is unused)
+    glm::vec4 ambientLight;   // Minimum light factor (w is unused)
+};
+
+/**
+ * @brief Material coefficients used by the lighting computations.
+ *
+ * The memory layout follows the std140 rules, it must match the `MaterialBlock`
+ * declared in the shaders.
+ ********************************************************************************/
+struct MaterialUniforms
+{
+    static constexpr GLuint BINDING = 1;                     // Binding point of the block
+    static constexpr const char *BLOCK_NAME = "MaterialBlock"; // Name of the block in the shaders
+
+    glm::vec4 Kd; // Diffuse reflection (w is unused)
+    glm::vec4 Ks; // Glossy reflection, the shininess is stored in w
+};
+
+/**
+ * @brief Uniform Buffer Object holding one uniform block.
+ *
+ * The buffer is bound once to the binding point of the block, the shaders
+ * linked to this binding point read the data sent with `update()`.
+ *
+ * @tparam BlockType A structure describing the block (FrameUniforms, MaterialUniforms...).
+ ********************************************************************************/
+template <typename BlockType>
+class UniformBuffer
+{
+public:
+    /**
+     * @brief Constructor of the class.
+     *
+     * Allocates the buffer on the GPU and binds it to the binding point of the block.
+     ********************************************************************************/
+    UniformBuffer()
+    {
+        glGenBuffers(1, &_ubo);
+        glBindBuffer(GL_UNIFORM_BUFFER, _ubo);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(BlockType), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        glBindBufferBase(GL_UNIFORM_BUFFER, BlockType::BINDING, _ubo); // Bound once for the whole app
+    }
+
+    /**
+     * @brief Destructor of the class.
+     ********************************************************************************/
+    ~UniformBuffer()
+    {
+        glDeleteBuffers(1, &_ubo);
+    }
+
+    UniformBuffer(const UniformBuffer &) = delete;
+    UniformBuffer &operator=(const UniformBuffer &) = delete;
+
+    /**
+     * @brief Sends new values of the block to the GPU.
+     *
+     * @param data The values of the block.
+     ********************************************************************************/
+    void update(const BlockType &data)
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, _ubo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(BlockType), &data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+private:
+    GLuint _ubo = 0; // Uniform Buffer Object ID
+};
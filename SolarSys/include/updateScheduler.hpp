@@ -0,0 +1,122 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module decides which planets have their      =
+=  matrices updated each frame, from their motion    =
+=  on screen.                                        =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "include/solarSystem.hpp"
+
+/**
+ * @brief Updates the matrices of a planet only when it moved enough on screen.
+ *
+ * The motion of every point of a planet (and of its satellites) is bounded from
+ * the difference between its two last updates, per unit of simulated time. Each
+ * frame, that rate gives the distance on screen the planet may have moved since
+ * its last update: it is updated once it reaches PIXEL_THRESHOLD, and at least
+ * every MAX_STALENESS frames. A slow or distant planet is updated a few times
+ * per second while a close one is updated every frame.
+ *
+ * The planets are identified by their index in the solar system. The forced
+ * updates are staggered by index, so the slow planets don't all come due on
+ * the same frame.
+ ********************************************************************************/
+class UpdateScheduler
+{
+public:
+    static constexpr float PIXEL_THRESHOLD = 0.25f;  // Estimated motion on screen (in pixels) a planet may lag behind
+    static constexpr unsigned int MAX_STALENESS = 8; // Frames a planet may go without being updated, whatever its motion
+    static constexpr float MIN_DISTANCE = 0.01f;     // Distance to the surface used when the camera is inside an object
+
+    /**
+     * @brief Starts a new frame.
+     *
+     * The motions measured before a switch of the distances (PlanetData::_largeView)
+     * or of the satellites update are dropped.
+     *
+     * @param viewMatrix View matrix of the previous frame.
+     * @param pixelScale Length on screen of one unit at a distance of one unit
+     *                   (see `RenderEngine::getPixelScale()`).
+     * @param updateSatellites If true, the satellites are updated with their planet.
+     ********************************************************************************/
+    void beginFrame(const glm::mat4 &viewMatrix, float pixelScale, bool updateSatellites);
+
+    /**
+     * @brief Updates the matrices of a planet if it is due.
+     *
+     * @param index Index of the planet in the solar system.
+     * @param solarSys The solar system storing the planet.
+     * @param planet The planet.
+     * @param time Simulated time the planet must reach (see `SolarSystem::updateMatrices()`).
+     *
+     * @return True if the planet was updated.
+     ********************************************************************************/
+    bool update(unsigned int index, SolarSystem &solarSys, Entity planet, float time);
+
+    /**
+     * @brief Forces the update of every planet on the next frame.
+     ********************************************************************************/
+    void invalidate();
+
+    /**
+     * @brief Enables or disables the scheduling.
+     *
+     * @param enabled If false, every planet is updated every frame.
+     ********************************************************************************/
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Retrieves the amount of planets updated during the current frame.
+     ********************************************************************************/
+    unsigned int getUpdateCount() const;
+
+private:
+    /**
+     * @brief State of a planet at its last update.
+     ********************************************************************************/
+    struct PlanetState
+    {
+        std::vector<glm::mat4> matrices; // Model matrices of the planet and of its satellites
+        std::vector<float> rates;        // Bound of the motion of their points per unit of simulated time
+        float time = 0;                  // Simulated time of the last update
+        bool measured = false;           // The rates are known
+    };
+
+    /**
+     * @brief Tells if a planet must be updated.
+     *
+     * @param index Index of the planet in the solar system.
+     * @param time Simulated time the planet must reach.
+     ********************************************************************************/
+    bool isDue(unsigned int index, float time) const;
+
+    /**
+     * @brief Stores the matrices of a planet which has just been updated and
+     * measures the rates of its motion.
+     *
+     * @param index Index of the planet in the solar system.
+     * @param solarSys The solar system storing the planet.
+     * @param planet The planet.
+     * @param time Simulated time of the planet.
+     ********************************************************************************/
+    void record(unsigned int index, const SolarSystem &solarSys, Entity planet, float time);
+
+    std::vector<PlanetState> _planets; // Indexed as the solar system
+    glm::mat4 _viewMatrix = glm::mat4(1);
+    float _pixelScale = 1;
+    bool _updateSatellites = false;
+    bool _largeView = false;      // Distances of the recorded matrices
+    bool _enabled = true;
+    unsigned int _frame = 0;
+    unsigned int _updateCount = 0; // Planets updated during the current frame
+};
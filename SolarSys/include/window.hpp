@@ -18,6 +18,7 @@
 
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
+#include <glimac/Extensions.hpp>
 
 #include "include/tools.hpp"
 #include "include/events.hpp"
@@ -47,9 +48,12 @@ public:
      *
      * @warning This must be called before the creation of the window
      *
+     * @param headless If true, the window is hidden. It needs no display at all
+     *                 when GLFW is built with GLFW_USE_OSMESA (software rendering).
+     *
      * @return 1 if the initialization is successfull, else 0.
      ********************************************************************************/
-    static int initWindowLib();
+    static int initWindowLib(bool headless = false);
 
     /**
      * @brief Frees properly the current window.
@@ -65,6 +69,14 @@ public:
      ********************************************************************************/
     void manageWindow();
 
+    /**
+     * @brief Enables or disables the synchronization of the swaps with the
+     *        refresh of the screen.
+     *
+     * @param enabled If false, the frames are shown as soon as they are rendered.
+     ********************************************************************************/
+    void setVSync(bool enabled);
+
     /**
      * @brief Checks if a window is still active/opened.
      *
@@ -103,6 +115,12 @@ private:
      ********************************************************************************/
     static void onError(int code, const char *desc);
 
+    /**
+     * @brief Sets the hints of the window and of its context.
+     ********************************************************************************/
+    static void setWindowHints();
+
+    static inline bool _headless = false; // Hidden window (see `initWindowLib()`)
     GLFWwindow *_window = NULL; // Pointer on a GLFW window
     bool _state = false;        // true if the window is open, false otherwise
 };
\ No newline at end of file
@@ -4,7 +4,15 @@ layout(location = 0) in vec3 aVertexPosition;
 layout(location = 1) in vec3 aVertexNormal;
 layout(location = 2) in vec2 aVertexTexCoords;
 
-uniform mat4 uMVPMatrix;
+// Data shared by every object of the frame
+layout(std140) uniform FrameBlock {
+  mat4 uViewMatrix;
+  mat4 uProjMatrix;
+  vec4 uLightPos;       // View coordinates
+  vec4 uLightIntensity;
+  vec4 uAmbientLight;
+};
+
 uniform mat4 uMVMatrix;
 uniform mat4 uNormalMatrix;
 
@@ -19,5 +27,5 @@ void main() {
   vVertexNormalVC = uNormalMatrix * vec4(aVertexNormal, 0);
   
   vFragText = aVertexTexCoords;
-  gl_Position = uMVPMatrix * vec4(aVertexPosition, 1);
+  gl_Position = uProjMatrix * vVertexPositionVC;
 }
\ No newline at end of file
@@ -0,0 +1,201 @@
+#version 330 core
+
+// Permutations are selected with defines inserted after the version:
+//   LIGHTED         Blinn-Phong lighting, otherwise the texture is emissive (shown as it is)
+//   SECOND_TEXTURE  A second texture added to the first one
+//   RING            Rings of ring.vs.glsl (flattened torus or flat annulus)
+//   IMPOSTOR        Sphere ray-cast on the quad of impostor.vs.glsl instead of a sphere mesh
+//   DEPTH_ZERO_TO_ONE  The clip depth goes from 0 to 1 (glClipControl), used by IMPOSTOR
+//   AVERAGE_COLOR   The textures are reduced to their average color and the lighting is only diffuse,
+//                   for the bodies a few pixels wide (IMPOSTOR) or smaller than a pixel (point.vs.glsl)
+//   INDIRECT        Bodies of indirect.vs.glsl, their textures are layers of an array
+
+#ifdef INDIRECT
+uniform sampler2DArray uTexture; // Every texture of the bodies, one per layer
+
+flat in vec2 vLayers; // First and second texture layer of the body, negative if none
+#else
+uniform sampler2D uTexture;
+#endif
+#ifdef SECOND_TEXTURE
+uniform sampler2D uSecondTexture;
+#endif
+
+#if defined(LIGHTED) || defined(IMPOSTOR)
+layout(std140) uniform FrameBlock {
+  mat4 uViewMatrix;
+  mat4 uProjMatrix;
+  vec4 uLightPos;       // View coordinates
+  vec4 uLightIntensity;
+  vec4 uAmbientLight;
+};
+#endif
+
+#ifdef LIGHTED
+// Material
+layout(std140) uniform MaterialBlock {
+  vec4 uKd;
+  vec4 uKs;             // w: shininess
+};
+#endif
+
+#ifdef RING
+uniform vec2 uRingRadii; // Inner and outer radius
+uniform bool uFlatRing;
+
+in vec2 vRingPosition;
+#endif
+
+#ifdef IMPOSTOR
+uniform mat4 uMVMatrix;
+
+in vec3 vViewRay;
+flat in vec4 vSphereVC; // Center (xyz) and radius (w)
+
+// Same values as the ones interpolated for a mesh, computed by castRay()
+vec4 vVertexPositionVC = vec4(0);
+vec4 vVertexNormalVC = vec4(0);
+vec2 vFragText = vec2(0);
+#else
+// View Coordinates
+in vec4 vVertexPositionVC;
+in vec4 vVertexNormalVC;
+
+in vec2 vFragText;
+#endif
+
+out vec4 fFragColor;
+
+#ifdef LIGHTED
+// Computes the fragment color
+vec3 blinnPhong(){
+  vec3 wi = normalize(uLightPos.xyz - vVertexPositionVC.xyz);
+  float d = distance(uLightPos.xyz, vVertexPositionVC.xyz);
+  vec3 li = uLightIntensity.rgb / (d * 1);
+  vec3 wo = normalize(-vVertexPositionVC.xyz);
+  vec3 halfV = (wo + wi) / 2;
+  vec3 n = normalize(vVertexNormalVC.xyz);
+
+  vec3 a = uKd.rgb * dot(wi, n);  // Diffuse component
+#ifdef AVERAGE_COLOR
+  vec3 formula = li * a; // The highlight is too small to be seen
+#else
+  vec3 b = uKs.rgb * pow(dot(halfV, n), uKs.w);  // Specular component
+  vec3 formula = li * (a + b);
+#endif
+
+  // Not really an ambient light but closer to a minimum light factor
+  return max(formula, uAmbientLight.rgb);
+}
+#endif
+
+#ifdef IMPOSTOR
+const float PI = 3.14159265359;
+
+// Intersects the ray from the eye with the sphere and fills the position, the normal,
+// the texture coordinates and the depth, returns false if the ray misses the sphere
+bool castRay() {
+  vec3 dir = normalize(vViewRay);
+  float b = dot(dir, vSphereVC.xyz);
+  float h = b * b - dot(vSphereVC.xyz, vSphereVC.xyz) + vSphereVC.w * vSphereVC.w;
+
+  // A missed fragment is only discarded after the texture fetches, they need the derivatives of its neighbours
+  vec3 position = dir * (b - sqrt(max(h, 0))); // Nearest intersection
+  vec3 normal = (position - vSphereVC.xyz) / vSphereVC.w;
+  vVertexPositionVC = vec4(position, 1);
+  vVertexNormalVC = vec4(normal, 0);
+
+#ifndef AVERAGE_COLOR
+  // Same parametrization as the sphere mesh of glimac (longitude on x, latitude on y)
+  vec3 modelDir = transpose(mat3(uMVMatrix)) * normal / vSphereVC.w;
+  vFragText = vec2(fract(atan(modelDir.x, modelDir.z) / (2 * PI)), 0.5 - asin(clamp(modelDir.y, -1, 1)) / PI);
+#endif
+
+  vec4 clipPosition = uProjMatrix * vVertexPositionVC;
+#ifdef DEPTH_ZERO_TO_ONE
+  gl_FragDepth = gl_DepthRange.near + gl_DepthRange.diff * clipPosition.z / clipPosition.w;
+#else
+  gl_FragDepth = (gl_DepthRange.diff * clipPosition.z / clipPosition.w + gl_DepthRange.near + gl_DepthRange.far) / 2;
+#endif
+
+  return h >= 0;
+}
+#endif
+
+// Samples a texture of the body
+vec4 sampleTexture(sampler2D sampler, vec2 textCoords) {
+#if defined(AVERAGE_COLOR)
+  // The last mipmap is a single texel, the average of the whole texture
+  return textureLod(sampler, vec2(0.5), 1000.0);
+#elif defined(IMPOSTOR)
+  // The longitude jumps from 1 to 0 on one side of the sphere, the derivatives are also taken on a
+  // copy jumping on the opposite side and the smallest ones are kept (no seam from the mipmaps)
+  vec2 dx = dFdx(textCoords);
+  vec2 dy = dFdy(textCoords);
+  vec2 shifted = vec2(fract(textCoords.x + 0.5), textCoords.y);
+  vec2 dxShifted = dFdx(shifted);
+  vec2 dyShifted = dFdy(shifted);
+  if (abs(dxShifted.x) + abs(dyShifted.x) < abs(dx.x) + abs(dy.x)) {
+    dx = dxShifted;
+    dy = dyShifted;
+  }
+  return textureGrad(sampler, textCoords, dx, dy);
+#else
+  return texture(sampler, textCoords);
+#endif
+}
+
+void main() {
+#ifdef IMPOSTOR
+  bool hit = castRay();
+#endif
+
+#ifdef RING
+  vec2 textCoords;
+  float ringCoord = 0;
+  if (uFlatRing) {
+    // Radial coordinate computed per fragment, 0 on the outer edge and 1 on the inner one like on the torus,
+    // the edges stay circles whatever the amount of segments
+    ringCoord = (uRingRadii.y - length(vRingPosition)) / (uRingRadii.y - uRingRadii.x);
+    textCoords = vec2(ringCoord);
+  } else {
+    // Repeat the texture twice (above and below the torus)
+    // Note that there is no need to handle the mirroring of the texture as the mode is set to GL_MIRRORED_REPEAT
+    // In other words, once the coordinates goes over 1, the texture is repeated in a mirrored way.
+    // The texture is applied horizontally along the torus and not vertically
+    textCoords = vFragText.yy * 2;
+  }
+#else
+  vec2 textCoords = vFragText;
+#endif
+
+#ifdef INDIRECT
+  // A negative first layer is a texture that couldn't be loaded, the second one is optional
+  vec4 text = (vLayers.x < 0) ? vec4(0, 0, 0, 1) : texture(uTexture, vec3(textCoords, vLayers.x));
+  if (vLayers.y >= 0) {
+    text += texture(uTexture, vec3(textCoords, vLayers.y));
+  }
+#else
+  vec4 text = sampleTexture(uTexture, textCoords);
+#endif
+#ifdef SECOND_TEXTURE
+  text += sampleTexture(uSecondTexture, textCoords);
+#endif
+
+#ifdef IMPOSTOR
+  if (!hit) {
+    discard;
+  }
+#endif
+#ifdef RING
+  if (ringCoord < 0 || ringCoord > 1) {
+    discard;
+  }
+#endif
+
+#ifdef LIGHTED
+  fFragColor = text * vec4(blinnPhong(), 1);
+#else
+  fFragColor = text;
+#endif
+}
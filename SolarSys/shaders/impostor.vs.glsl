@@ -0,0 +1,39 @@
+#version 330 core
+
+// Screen aligned quad covering a sphere, the sphere itself is ray-cast by body.fs.glsl (IMPOSTOR)
+// No vertex attribute is read: drawn with glDrawArrays(GL_TRIANGLE_STRIP, 0, 4)
+
+// Data shared by every object of the frame
+layout(std140) uniform FrameBlock {
+  mat4 uViewMatrix;
+  mat4 uProjMatrix;
+  vec4 uLightPos;       // View coordinates
+  vec4 uLightIntensity;
+  vec4 uAmbientLight;
+};
+
+uniform mat4 uMVMatrix; // Sphere of radius 1 centered on the origin in model coordinates
+
+out vec3 vViewRay;       // Point of the quad in view coordinates, the ray goes from the eye through it
+flat out vec4 vSphereVC; // Center (xyz) and radius (w) of the sphere in view coordinates
+
+void main() {
+  vec3 center = uMVMatrix[3].xyz;
+  float radius = length(uMVMatrix[0].xyz); // The scale is uniform
+
+  // The quad faces the eye, which is at the origin
+  float dist = length(center);
+  vec3 axis = center / dist;
+  vec3 right = normalize(cross(axis, abs(axis.y) < 0.99 ? vec3(0, 1, 0) : vec3(1, 0, 0)));
+  vec3 up = cross(right, axis);
+
+  // Half size of the quad in the plane of the center so the silhouette of the sphere fits in it
+  float halfSize = radius * dist / sqrt(max(dist * dist - radius * radius, 1e-6));
+
+  // 0: bottom left, 1: bottom right, 2: top left, 3: top right
+  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2 - 1;
+
+  vViewRay = center + (corner.x * right + corner.y * up) * halfSize;
+  vSphereVC = vec4(center, radius);
+  gl_Position = uProjMatrix * vec4(vViewRay, 1);
+}
@@ -0,0 +1,71 @@
+#version 330 core
+
+// Ring of a planet built from gl_VertexID, no vertex attribute is read
+// Drawn with glDrawArrays(GL_TRIANGLE_STRIP, 0, count):
+//   Torus:        count = uRingSegments.x * (uRingSegments.y + 1) * 2
+//   Flat annulus: count = (uRingSegments.x + 1) * 2
+
+// Data shared by every object of the frame
+layout(std140) uniform FrameBlock {
+  mat4 uViewMatrix;
+  mat4 uProjMatrix;
+  vec4 uLightPos;       // View coordinates
+  vec4 uLightIntensity;
+  vec4 uAmbientLight;
+};
+
+uniform mat4 uMVMatrix;
+uniform mat4 uNormalMatrix;
+
+uniform vec2 uRingRadii;     // Inner and outer radius (model coordinates)
+uniform ivec2 uRingSegments; // Segments around the ring and across the pipe of the torus
+uniform bool uFlatRing;      // Flat annulus instead of a flattened torus
+
+out vec4 vVertexPositionVC;
+out vec4 vVertexNormalVC;
+out vec2 vFragText;
+out vec2 vRingPosition; // Position in the plane of the ring (model coordinates)
+
+const float PI = 3.14159265359;
+
+void main() {
+  vec3 position;
+  vec3 normal;
+
+  if (uFlatRing) {
+    // Alternates between the inner and the outer edge, the outer vertices are pushed out
+    // so the edges of the segments contain the circle (the fragment shader cuts the exact one)
+    float u = float(gl_VertexID / 2) * 2 * PI / uRingSegments.x;
+    float radius = ((gl_VertexID & 1) == 0) ? uRingRadii.x : uRingRadii.y / cos(PI / uRingSegments.x);
+
+    position = vec3(radius * cos(u), radius * sin(u), 0);
+    normal = vec3(0, 0, 1);
+    vFragText = vec2(u / (2 * PI), 0); // The radial coordinate is computed per fragment
+  } else {
+    // One band of the torus after the other, each band going once around the pipe
+    int bandSize = (uRingSegments.y + 1) * 2;
+    int band = gl_VertexID / bandSize;
+    int index = gl_VertexID % bandSize;
+
+    float u = float(band + (index & 1)) * 2 * PI / uRingSegments.x; // Around the ring
+    float v = float(index / 2) * 2 * PI / uRingSegments.y;          // Around the pipe
+
+    float pipeRadius = (uRingRadii.y - uRingRadii.x) / 2;
+    float radius = uRingRadii.x + pipeRadius;
+
+    position = vec3((radius + pipeRadius * cos(v)) * cos(u), (radius + pipeRadius * cos(v)) * sin(u), pipeRadius / 20 * sin(v)); // Division by 20 to "flatten" the torus
+    normal = vec3(cos(v) * cos(u), cos(v) * sin(u), sin(v));
+    vFragText = vec2(u, v) / (2 * PI);
+  }
+
+  vRingPosition = position.xy;
+  vVertexPositionVC = uMVMatrix * vec4(position, 1);
+  vVertexNormalVC = uNormalMatrix * vec4(normal, 0);
+
+  // Both sides of the annulus are lighted, the normal faces the eye
+  if (uFlatRing && dot(vVertexNormalVC.xyz, vVertexPositionVC.xyz) > 0) {
+    vVertexNormalVC = -vVertexNormalVC;
+  }
+
+  gl_Position = uProjMatrix * vVertexPositionVC;
+}
@@ -0,0 +1,360 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module counts the heap allocations made      =
+=  during each frame, to keep the rendering loop     =
+=  free of them.                                     =
+=													 =
+======================================================
+*/
+
+#include "include/allocationTracker.hpp"
+
+#ifdef SOLARSYS_TRACK_ALLOCATIONS
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <cxxabi.h>
+#include <execinfo.h>
+
+namespace
+{
+    /**
+     * @brief Allocations coming from the same call stack.
+     ********************************************************************************/
+    struct CallSite
+    {
+        std::atomic<std::size_t> key{0};                   // Hash of the call stack, 0 while the entry is free
+        void *stack[AllocationTracker::STACK_DEPTH] = {};  // Return addresses, from the caller of operator new
+        int depth = 0;                                     // Amount of return addresses stored
+        std::atomic<std::size_t> allocations{0};           // During the current frame
+        std::atomic<std::size_t> bytes{0};                 // During the current frame
+    };
+
+    // The storage is static, the tracker can't allocate while it is called by operator new
+    CallSite sites[AllocationTracker::MAX_SITES + 1]; // The last entry gathers the call sites which don't fit
+    std::atomic<std::size_t> frameAllocations{0};
+    std::atomic<std::size_t> frameBytes{0};
+    std::atomic<std::size_t> frameDeallocations{0};
+    std::atomic<std::size_t> steadyAllocations{0};
+    unsigned int frameIndex = 0;
+    thread_local bool busy = false; // The tracker itself is running on this thread, its allocations aren't counted
+
+    /**
+     * @brief Finds the entry of a call stack, or creates it.
+     ********************************************************************************/
+    CallSite &findSite(void **stack, int depth)
+    {
+        std::size_t key = 0;
+        for (int i = 0; i < depth; i++)
+        {
+            key = key * 31 + reinterpret_cast<std::size_t>(stack[i]);
+        }
+        key |= 1; // 0 marks the free entries
+
+        // Open addressing, an entry is never released
+        for (unsigned int probe = 0; probe < AllocationTracker::MAX_SITES; probe++)
+        {
+            auto &site = sites[(key + probe) % AllocationTracker::MAX_SITES];
+            std::size_t expected = 0;
+            if (site.key.compare_exchange_strong(expected, key))
+            {
+                std::copy(stack, stack + depth, site.stack);
+                site.depth = depth;
+                return site;
+            }
+            if (expected == key)
+            {
+                return site;
+            }
+        }
+        return sites[AllocationTracker::MAX_SITES];
+    }
+
+    /**
+     * @brief Extracts the readable name of a function from a line given by
+     *        backtrace_symbols(), "module(mangledName+offset) [address]".
+     *
+     * The line is kept as it is when the function isn't exported (static or
+     * without ENABLE_EXPORTS), addr2line finds it from the module and the offset.
+     ********************************************************************************/
+    std::string symbolName(const char *symbol)
+    {
+        std::string line(symbol);
+        auto begin = line.find('(');
+        auto end = line.find('+', begin);
+        if (begin == std::string::npos || end == std::string::npos || end == begin + 1)
+        {
+            return line;
+        }
+
+        std::string mangled = line.substr(begin + 1, end - begin - 1);
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+        std::string name = status == 0 ? demangled : mangled;
+        std::free(demangled);
+        return name;
+    }
+}
+
+/**
+ * @brief Tells if the allocations are counted (SOLARSYS_TRACK_ALLOCATIONS).
+ ********************************************************************************/
+bool AllocationTracker::isEnabled()
+{
+    return true;
+}
+
+/**
+ * @brief Ends the current frame.
+ *
+ * Once the warm-up is done, a frame which allocated is reported with its
+ * allocations, their bytes and its main call sites.
+ *
+ * @param out The stream receiving the report.
+ *
+ * @return The amount of allocations made during the frame.
+ ********************************************************************************/
+std::size_t AllocationTracker::endFrame(std::ostream &out)
+{
+    busy = true; // The report itself allocates
+    std::size_t allocations = frameAllocations.exchange(0);
+    std::size_t bytes = frameBytes.exchange(0);
+    std::size_t deallocations = frameDeallocations.exchange(0);
+
+    if (frameIndex >= WARMUP_FRAMES && allocations > 0)
+    {
+        steadyAllocations += allocations;
+        out << "Frame " << frameIndex << ": " << allocations << " allocations (" << bytes << " bytes), "
+            << deallocations << " deallocations" << std::endl;
+
+        // The call sites which allocated the most often, in decreasing order
+        CallSite *reported[REPORTED_SITES] = {};
+        for (auto &site : sites)
+        {
+            CallSite *candidate = &site;
+            for (unsigned int i = 0; i < REPORTED_SITES && candidate->allocations > 0; i++)
+            {
+                if (!reported[i] || reported[i]->allocations < candidate->allocations)
+                {
+                    std::swap(reported[i], candidate);
+                    if (!candidate)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (auto site : reported)
+        {
+            if (!site)
+            {
+                break;
+            }
+            out << "  " << site->allocations << " allocations, " << site->bytes << " bytes:";
+            if (site == &sites[MAX_SITES])
+            {
+                out << " (call sites not told apart)" << std::endl;
+                continue;
+            }
+
+            // Functions of the call stack, from the first one outside of the standard library
+            char **symbols = backtrace_symbols(site->stack, site->depth);
+            bool inLibrary = true;
+            for (int i = 0; i < site->depth && symbols; i++)
+            {
+                std::string name = symbolName(symbols[i]);
+                inLibrary = inLibrary && name.rfind("std::", 0) == 0 && i + 1 < site->depth;
+                if (!inLibrary)
+                {
+                    out << std::endl
+                        << "      " << name;
+                }
+            }
+            out << std::endl;
+            std::free(symbols);
+        }
+    }
+
+    // Every call site starts the next frame from zero
+    for (auto &site : sites)
+    {
+        site.allocations = 0;
+        site.bytes = 0;
+    }
+    frameIndex++;
+    busy = false;
+    return allocations;
+}
+
+/**
+ * @brief Retrieves the amount of allocations made after the warm-up.
+ *
+ * @return 0 if the frame loop reached a steady state without allocation.
+ ********************************************************************************/
+std::size_t AllocationTracker::getSteadyAllocations()
+{
+    return steadyAllocations;
+}
+
+/**
+ * @brief Records an allocation, called by the replaced operator new.
+ *
+ * @param size Size of the allocation (in bytes).
+ ********************************************************************************/
+void AllocationTracker::recordAllocation(std::size_t size)
+{
+    if (busy)
+    {
+        return;
+    }
+    busy = true;
+
+    frameAllocations++;
+    frameBytes += size;
+
+    // Only the call sites of the steady frames are reported, the loading ones would fill the table
+    if (frameIndex < WARMUP_FRAMES)
+    {
+        busy = false;
+        return;
+    }
+
+    // The first return addresses are the ones of the tracker and of operator new
+    const int skipped = 2;
+    void *stack[STACK_DEPTH + skipped];
+    int depth = backtrace(stack, STACK_DEPTH + skipped) - skipped;
+    if (depth > 0)
+    {
+        auto &site = findSite(stack + skipped, depth);
+        site.allocations++;
+        site.bytes += size;
+    }
+
+    busy = false;
+}
+
+/**
+ * @brief Records a deallocation, called by the replaced operator delete.
+ ********************************************************************************/
+void AllocationTracker::recordDeallocation()
+{
+    if (!busy)
+    {
+        frameDeallocations++;
+    }
+}
+
+/* ========================================================================================================== */
+/* =                                          GLOBAL NEW AND DELETE                                         = */
+/* ========================================================================================================== */
+
+void *operator new(std::size_t size)
+{
+    AllocationTracker::recordAllocation(size);
+    if (void *pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    AllocationTracker::recordAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    if (pointer)
+    {
+        AllocationTracker::recordDeallocation();
+        std::free(pointer);
+    }
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    operator delete(pointer);
+}
+
+#else
+
+/**
+ * @brief Tells if the allocations are counted (SOLARSYS_TRACK_ALLOCATIONS).
+ ********************************************************************************/
+bool AllocationTracker::isEnabled()
+{
+    return false;
+}
+
+/**
+ * @brief Ends the current frame, nothing is counted.
+ ********************************************************************************/
+std::size_t AllocationTracker::endFrame([[maybe_unused]] std::ostream &out)
+{
+    return 0;
+}
+
+/**
+ * @brief Retrieves the amount of allocations made after the warm-up, nothing
+ *        is counted.
+ ********************************************************************************/
+std::size_t AllocationTracker::getSteadyAllocations()
+{
+    return 0;
+}
+
+/**
+ * @brief Records an allocation, nothing is counted.
+ ********************************************************************************/
+void AllocationTracker::recordAllocation([[maybe_unused]] std::size_t size)
+{
+}
+
+/**
+ * @brief Records a deallocation, nothing is counted.
+ ********************************************************************************/
+void AllocationTracker::recordDeallocation()
+{
+}
+
+#endif
@@ -0,0 +1,559 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module plays a scripted tour of the solar    =
+=  system with a fixed time step and measures the    =
+=  frames, to compare the performances of two runs.  =
+=													 =
+======================================================
+*/
+
+#include "include/benchmark.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <glimac/FrameArena.hpp>
+#include <glimac/GLInterceptor.hpp>
+#include <glimac/Json.hpp>
+
+#include "include/allocationTracker.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief Name of each action in the tour, with its amount of values.
+     ********************************************************************************/
+    struct ActionName
+    {
+        const char *name;
+        unsigned int nbValues;
+    };
+
+    // In the order of Benchmark::TourAction
+    const ActionName actionNames[] = {
+        {"overview", 0},
+        {"profile", 0},
+        {"next", 0},
+        {"previous", 0},
+        {"large", 0},
+        {"faster", 1},
+        {"slower", 1},
+        {"leap", 1},
+        {"zoom", 1},
+        {"rotate", 2},
+        {"gpu", 0},
+        {"impostors", 0},
+        {"rings", 0},
+        {"resolution", 0},
+        {"scheduling", 0}};
+
+    /**
+     * @brief Retrieves the time elapsed between two instants (in ms).
+     ********************************************************************************/
+    float elapsed(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<float, std::milli>(end - begin).count();
+    }
+
+    /**
+     * @brief Retrieves the peak of the memory used by the process (in KiB), 0
+     *        if the system doesn't tell.
+     ********************************************************************************/
+    long peakResidentMemory()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+        {
+#ifdef __APPLE__
+            return usage.ru_maxrss / 1024; // In bytes on macOS
+#else
+            return usage.ru_maxrss;
+#endif
+        }
+#endif
+        return 0;
+    }
+}
+
+/**
+ * @brief Reads the benchmark settings from the command line of the app.
+ *
+ * SolarSys_ --benchmark tour.txt [--frames N] [--output results.json] [--path cpu|gpu]
+ *           [--planets N [--moons N] [--rings N] [--texture-size N] [--textures N]]
+ *           [--gl-capture trace.bin]
+ *
+ * --path selects the rendering path of the bodies at the start, and --planets
+ * replaces the solar system with a stress scene with the given settings.
+ * --gl-capture records the OpenGL calls of the run (SOLARSYS_GL_TRACE builds).
+ *
+ * Throws a std::invalid_argument if the arguments are wrong, and a
+ * std::runtime_error if the tour can't be read.
+ *
+ * @param argc Amount of arguments, the name of the app included.
+ * @param argv The arguments.
+ *
+ * @return The benchmark to run, null without --benchmark.
+ ********************************************************************************/
+std::unique_ptr<Benchmark> Benchmark::fromArguments(int argc, char *argv[])
+{
+    std::string tourPath;
+    std::string outputPath = DEFAULT_OUTPUT;
+    unsigned int nbFrames = DEFAULT_FRAMES;
+    std::string path;
+    std::string glCapturePath;
+    unsigned int nbPlanets = 0;
+    unsigned int nbMoons = StressScene::DEFAULT_MOONS;
+    unsigned int nbRings = 0;
+    unsigned int textureSize = StressScene::DEFAULT_TEXTURE_SIZE;
+    unsigned int nbTextures = StressScene::DEFAULT_TEXTURES;
+    bool sceneSettings = false; // Settings of a stress scene given
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 == argc)
+        {
+            throw std::invalid_argument(std::string("Missing value after ") + argv[i]);
+        }
+
+        // Reads the amount following the argument, 0 is only allowed if it can be skipped
+        auto readAmount = [&](bool allowZero)
+        {
+            const char *name = argv[i++];
+            char *end = nullptr;
+            long value = std::strtol(argv[i], &end, 10);
+            if (*end != '\0' || value < (allowZero ? 0 : 1) || value > std::numeric_limits<int>::max())
+            {
+                throw std::invalid_argument(std::string("Wrong value after ") + name + ": " + argv[i]);
+            }
+            return static_cast<unsigned int>(value);
+        };
+
+        if (std::strcmp(argv[i], "--benchmark") == 0)
+        {
+            tourPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--output") == 0)
+        {
+            outputPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--frames") == 0)
+        {
+            nbFrames = readAmount(false);
+        }
+        else if (std::strcmp(argv[i], "--path") == 0)
+        {
+            path = argv[++i];
+            if (path != "cpu" && path != "gpu")
+            {
+                throw std::invalid_argument("Unknown rendering path: " + path + " (cpu or gpu)");
+            }
+        }
+        else if (std::strcmp(argv[i], "--gl-capture") == 0)
+        {
+#ifndef SOLARSYS_GL_TRACE
+            throw std::invalid_argument("--gl-capture needs a build with the OpenGL interceptor (SOLARSYS_GL_TRACE)");
+#endif
+            glCapturePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--planets") == 0)
+        {
+            nbPlanets = readAmount(false);
+        }
+        else if (std::strcmp(argv[i], "--moons") == 0)
+        {
+            nbMoons = readAmount(true);
+            sceneSettings = true;
+        }
+        else if (std::strcmp(argv[i], "--rings") == 0)
+        {
+            nbRings = readAmount(true);
+            sceneSettings = true;
+        }
+        else if (std::strcmp(argv[i], "--texture-size") == 0)
+        {
+            textureSize = readAmount(false);
+            sceneSettings = true;
+        }
+        else if (std::strcmp(argv[i], "--textures") == 0)
+        {
+            nbTextures = readAmount(false);
+            sceneSettings = true;
+        }
+        else
+        {
+            throw std::invalid_argument(std::string("Unknown argument: ") + argv[i]);
+        }
+    }
+
+    if (tourPath.empty())
+    {
+        if (argc > 1)
+        {
+            throw std::invalid_argument("The benchmark settings need --benchmark");
+        }
+        return nullptr;
+    }
+
+    // The settings of the stress scene are checked before the tour is read
+    std::unique_ptr<StressScene> stressScene;
+    if (nbPlanets > 0)
+    {
+        stressScene = std::make_unique<StressScene>(nbPlanets, nbMoons, nbRings, textureSize, nbTextures);
+    }
+    else if (sceneSettings)
+    {
+        throw std::invalid_argument("The settings of a stress scene need --planets");
+    }
+
+    auto benchmark = std::make_unique<Benchmark>(tourPath, nbFrames, outputPath);
+    benchmark->_stressScene = std::move(stressScene);
+    benchmark->_gpuDriven = path == "gpu";
+    benchmark->_glCapturePath = glCapturePath;
+    return benchmark;
+}
+
+/**
+ * @brief Loads a tour.
+ *
+ * Throws a std::runtime_error if the file can't be read or if a step is wrong.
+ *
+ * @param tourPath Path of the tour.
+ * @param nbFrames Amount of frames to play.
+ * @param outputPath Path of the results.
+ ********************************************************************************/
+Benchmark::Benchmark(const std::string &tourPath, unsigned int nbFrames, const std::string &outputPath)
+    : _tourPath{tourPath}, _outputPath{outputPath}, _nbFrames{nbFrames}
+{
+    std::ifstream file(tourPath);
+    if (!file)
+    {
+        throw std::runtime_error("The tour " + tourPath + " can't be read");
+    }
+
+    std::string line;
+    for (unsigned int lineIndex = 1; std::getline(file, line); lineIndex++)
+    {
+        std::istringstream stream(line);
+        std::string name;
+        TourStep step = {0, ACTION_OVERVIEW, {0, 0}};
+        stream >> std::ws;
+        if (stream.eof() || stream.peek() == '#')
+        {
+            continue; // Empty line or comment
+        }
+
+        auto error = [&](const std::string &message)
+        {
+            return std::runtime_error(tourPath + ":" + std::to_string(lineIndex) + ": " + message);
+        };
+
+        if (!(stream >> step.frame >> name))
+        {
+            throw error("expected a frame and an action");
+        }
+        auto action = std::find_if(std::begin(actionNames), std::end(actionNames), [&](const ActionName &action)
+                                   { return name == action.name; });
+        if (action == std::end(actionNames))
+        {
+            throw error("unknown action " + name);
+        }
+        step.action = static_cast<TourAction>(action - std::begin(actionNames));
+        for (unsigned int i = 0; i < action->nbValues; i++)
+        {
+            if (!(stream >> step.values[i]))
+            {
+                throw error(name + " needs " + std::to_string(action->nbValues) + " value(s)");
+            }
+        }
+        if (!_steps.empty() && step.frame < _steps.back().frame)
+        {
+            throw error("the steps must be sorted by frame");
+        }
+        _steps.push_back(step);
+    }
+
+    // The measures never reach the heap during the frames
+    for (auto &samples : _samples)
+    {
+        samples.reserve(nbFrames);
+    }
+}
+
+/**
+ * @brief Retrieves the stress scene to fly over.
+ *
+ * @return The settings of the scene, null to fly over the solar system.
+ ********************************************************************************/
+const StressScene *Benchmark::getStressScene() const
+{
+    return _stressScene.get();
+}
+
+/**
+ * @brief Retrieves the path of the trace of the OpenGL calls to record.
+ *
+ * @return The path, empty if the calls aren't recorded.
+ ********************************************************************************/
+const std::string &Benchmark::getGLCapturePath() const
+{
+    return _glCapturePath;
+}
+
+/**
+ * @brief Sets the context up for the run, before the first frame: the
+ *        rendering path is selected and the resolution follows the window.
+ *
+ * @param context The context the keys would act on.
+ * @param renderEng The render engine, it tells if the GPU driven path exists.
+ ********************************************************************************/
+void Benchmark::configure(Context &context, const RenderEngine &renderEng)
+{
+    // The resolution only changes if the tour asks for it, the frames stay the same from a run to another
+    if (context.isDynamicResolution())
+    {
+        context.toggleDynamicResolution();
+    }
+
+    if (context.isGpuDriven() != _gpuDriven)
+    {
+        context.toggleGpuDriven();
+    }
+    _gpuDriven = _gpuDriven && renderEng.hasIndirectRendering(); // The bodies are drawn by the CPU without it
+
+    auto &solarSys = context.getSolarSys();
+    _nbBodies = solarSys.nbBodies();
+    _nbRings = solarSys.getRings().size();
+}
+
+/**
+ * @brief Tells if frames are left to play.
+ ********************************************************************************/
+bool Benchmark::isRunning() const
+{
+    return _frameIndex < _nbFrames;
+}
+
+/**
+ * @brief Starts a frame: plays the steps of the tour due on this frame.
+ *
+ * @param context The context the keys would act on.
+ ********************************************************************************/
+void Benchmark::beginFrame(Context &context)
+{
+    _frameStart = _phaseStart = std::chrono::steady_clock::now();
+
+    for (; _nextStep < _steps.size() && _steps[_nextStep].frame <= _frameIndex; _nextStep++)
+    {
+        play(_steps[_nextStep], context);
+    }
+}
+
+/**
+ * @brief Ends the simulation phase of the frame (update of the matrices and
+ *        of the camera).
+ ********************************************************************************/
+void Benchmark::endSimulation()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (_frameIndex >= WARMUP_FRAMES)
+    {
+        _samples[MEASURE_SIMULATION].push_back(elapsed(_phaseStart, now));
+    }
+    _phaseStart = now;
+}
+
+/**
+ * @brief Ends the rendering phase of the frame (draw calls).
+ ********************************************************************************/
+void Benchmark::endRendering()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (_frameIndex >= WARMUP_FRAMES)
+    {
+        _samples[MEASURE_RENDERING].push_back(elapsed(_phaseStart, now));
+    }
+    _phaseStart = now;
+}
+
+/**
+ * @brief Ends the frame, after the swap of the buffers and the events.
+ *
+ * @param renderEng The render engine, it gives the GPU time of the frames.
+ ********************************************************************************/
+void Benchmark::endFrame(const RenderEngine &renderEng)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (_frameIndex >= WARMUP_FRAMES)
+    {
+        _samples[MEASURE_PRESENT].push_back(elapsed(_phaseStart, now));
+        _samples[MEASURE_FRAME].push_back(elapsed(_frameStart, now));
+
+        // The GPU times arrive late, a frame can read none or several of them
+        for (double gpuTime : renderEng.getNewGpuFrameTimes())
+        {
+            _samples[MEASURE_GPU].push_back(gpuTime);
+        }
+    }
+    _frameIndex++;
+}
+
+/**
+ * @brief Writes the results to the output given to the constructor.
+ *
+ * @return False if the file can't be written.
+ ********************************************************************************/
+bool Benchmark::writeResults() const
+{
+    std::ofstream out(_outputPath);
+    if (!out)
+    {
+        return false;
+    }
+
+    out << std::fixed << std::setprecision(3)
+        << "{" << std::endl
+        << "  \"tour\": ";
+    glimac::writeJsonString(out, _tourPath.c_str());
+    out << "," << std::endl
+        << "  \"renderer\": ";
+    glimac::writeJsonString(out, reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+    out << "," << std::endl
+        << "  \"version\": ";
+    glimac::writeJsonString(out, reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+    out << "," << std::endl
+        << "  \"frames\": " << _frameIndex << "," << std::endl
+        << "  \"measuredFrames\": " << _samples[MEASURE_FRAME].size() << "," << std::endl
+        << "  \"timeStep\": " << TIME_STEP * 1000 << "," << std::endl
+        << "  \"path\": \"" << (_gpuDriven ? "gpu" : "cpu") << "\"," << std::endl
+        << "  \"scene\": {\"bodies\": " << _nbBodies << ", \"rings\": " << _nbRings << ", \"stress\": ";
+    if (_stressScene)
+    {
+        _stressScene->writeSettings(out);
+    }
+    else
+    {
+        out << "null";
+    }
+    out << "}," << std::endl
+        << "  \"frameTime\": ";
+    glimac::writeJsonStatistics(out, _samples[MEASURE_FRAME]);
+    out << "," << std::endl
+        << "  \"cpu\": {" << std::endl
+        << "    \"simulation\": ";
+    glimac::writeJsonStatistics(out, _samples[MEASURE_SIMULATION]);
+    out << "," << std::endl
+        << "    \"rendering\": ";
+    glimac::writeJsonStatistics(out, _samples[MEASURE_RENDERING]);
+    out << "," << std::endl
+        << "    \"present\": ";
+    glimac::writeJsonStatistics(out, _samples[MEASURE_PRESENT]);
+    out << std::endl
+        << "  }," << std::endl
+        << "  \"gpu\": {" << std::endl
+        << "    \"frame\": ";
+    glimac::writeJsonStatistics(out, _samples[MEASURE_GPU]);
+    out << std::endl
+        << "  }," << std::endl
+        << "  \"memory\": {" << std::endl
+        << "    \"peakResidentKiB\": " << peakResidentMemory() << "," << std::endl
+        << "    \"frameArenaBytes\": " << glimac::FrameArena::getGlobalHighWaterMark() << "," << std::endl
+        << "    \"frameArenaCapacity\": " << glimac::FrameArena::getGlobalCapacity() << "," << std::endl
+        << "    \"frameArenaOverflows\": " << glimac::FrameArena::getGlobalOverflowCount() << "," << std::endl
+        << "    \"steadyAllocations\": " << AllocationTracker::getSteadyAllocations() << std::endl
+        << "  }," << std::endl
+        << "  \"gl\": ";
+    if (glimac::GLInterceptor::isInstalled())
+    {
+        glimac::GLInterceptor::writeStats(out);
+    }
+    else
+    {
+        out << "null";
+    }
+    out << std::endl
+        << "}" << std::endl;
+
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Plays a step of the tour.
+ ********************************************************************************/
+void Benchmark::play(const TourStep &step, Context &context)
+{
+    switch (step.action)
+    {
+    case ACTION_OVERVIEW:
+        context.resetCam();
+        break;
+    case ACTION_PROFILE:
+        context.profileCam();
+        break;
+    case ACTION_NEXT:
+    case ACTION_PREVIOUS:
+        // Like the arrow keys, the planets are focused in the large view
+        if (!PlanetData::_largeView)
+        {
+            context.toggleLargeView();
+        }
+        if (step.action == ACTION_NEXT)
+        {
+            context.next_planet();
+        }
+        else
+        {
+            context.previous_planet();
+        }
+        break;
+    case ACTION_LARGE:
+        if (!context.isCamFocused()) // Like the key, the distances only change in the initial pov
+        {
+            context.toggleLargeView();
+        }
+        break;
+    case ACTION_FASTER:
+        context.increaseSpeed(step.values[0]);
+        break;
+    case ACTION_SLOWER:
+        context.decreaseSpeed(step.values[0]);
+        break;
+    case ACTION_LEAP:
+        context.timeLeap(step.values[0]);
+        break;
+    case ACTION_ZOOM:
+        context.getCamera().moveFront(step.values[0]);
+        break;
+    case ACTION_ROTATE:
+        context.getCamera().rotateLeft(step.values[0]);
+        context.getCamera().rotateUp(step.values[1]);
+        break;
+    case ACTION_GPU:
+        context.toggleGpuDriven();
+        break;
+    case ACTION_IMPOSTORS:
+        context.toggleImpostors();
+        break;
+    case ACTION_RINGS:
+        context.toggleFlatRings();
+        break;
+    case ACTION_RESOLUTION:
+        context.toggleDynamicResolution();
+        break;
+    case ACTION_SCHEDULING:
+        context.toggleUpdateScheduling();
+        break;
+    }
+}
@@ -50,7 +50,7 @@ void Context::update_camera()
 {
     if (camera.isFocusedPov()) // If the camera is in planet focused mode, then the view matrix will be computed thanks to the planet position
     {
-        camera.update_position(solarSys[planet_idx].getMatrices().getMVMatrix()[3]);
+        camera.update_position(solarSys.getModelMatrix(solarSys.getPlanet(planet_idx))[3]);
     }
     else if (camera.isInitialPov() || camera.isProfilePov()) // We just restore the initial computations(transformations on matrices) for the view matrix for one of these two modes
     {
@@ -66,7 +66,7 @@ void Context::next_planet()
     planet_idx = (planet_idx == solarSys.nbPlanets() - 1) ? 0 : (planet_idx + 1);
 
     // camera settings
-    camera.set_distance(solarSys[planet_idx].getSize() * 2);
+    camera.set_distance(solarSys.getSize(solarSys.getPlanet(planet_idx)) * 2);
     camera.setFocusedPov();
 }
 
@@ -78,7 +78,7 @@ void Context::previous_planet()
     planet_idx = (planet_idx == 0) ? solarSys.nbPlanets() - 1 : (planet_idx - 1);
 
     // camera settings
-    camera.set_distance(solarSys[planet_idx].getSize() * 2);
+    camera.set_distance(solarSys.getSize(solarSys.getPlanet(planet_idx)) * 2);
     camera.setFocusedPov();
 }
 
@@ -189,4 +189,103 @@ bool Context::isProfileCam()
 */
 Light & Context::getLight(){
     return _light;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Switches between the classic rendering and the GPU driven one.
+ ********************************************************************************/
+void Context::toggleGpuDriven()
+{
+    _gpuDriven = !_gpuDriven;
+}
+
+/**
+ * @brief Tells if the bodies must be drawn with the GPU driven path.
+ *
+ * @return True if the GPU driven rendering is selected and false otherwise.
+ ********************************************************************************/
+bool Context::isGpuDriven()
+{
+    return _gpuDriven;
+}
+
+/**
+ * @brief Switches between impostors for every body and impostors only for the
+ *        bodies small on screen.
+ ********************************************************************************/
+void Context::toggleImpostors()
+{
+    _allImpostors = !_allImpostors;
+    for (auto &material : solarSys.getMaterials())
+    {
+        material.alwaysImpostor = _allImpostors;
+    }
+}
+
+/**
+ * @brief Switches the rings between flattened toruses and flat annuli.
+ ********************************************************************************/
+void Context::toggleFlatRings()
+{
+    _flatRings = !_flatRings;
+    for (auto &ring : solarSys.getRings())
+    {
+        ring.flat = _flatRings;
+    }
+}
+
+/**
+ * @brief Switches between a resolution following the frame time budget and
+ *        the resolution of the window.
+ ********************************************************************************/
+void Context::toggleDynamicResolution()
+{
+    _dynamicResolution = !_dynamicResolution;
+}
+
+/**
+ * @brief Tells if the resolution follows the frame time budget.
+ *
+ * @return True if the resolution is dynamic and false if the window one is kept.
+ ********************************************************************************/
+bool Context::isDynamicResolution()
+{
+    return _dynamicResolution;
+}
+
+/**
+ * @brief Switches between updating the planets from their motion on screen
+ *        and updating all of them every frame.
+ ********************************************************************************/
+void Context::toggleUpdateScheduling()
+{
+    _updateScheduling = !_updateScheduling;
+}
+
+/**
+ * @brief Tells if the planets are updated from their motion on screen.
+ *
+ * @return True if the slow planets skip some updates and false otherwise.
+ ********************************************************************************/
+bool Context::isUpdateScheduling()
+{
+    return _updateScheduling;
+}
+
+/**
+ * @brief Switches between the real distances and the large view, the light
+ *        intensity follows.
+ ********************************************************************************/
+void Context::toggleLargeView()
+{
+    PlanetData::_largeView = !PlanetData::_largeView;
+
+    if (PlanetData::_largeView)
+    {
+        _light.setIntensity(30.);
+    }
+    else
+    {
+        _light.setIntensity(7.5);
+    }
+}
@@ -17,262 +17,295 @@
 #include "include/coreEngine.hpp"
 
 /**
- * @brief Build a Planet object.
+ * @brief Gives a body the shaders of its cheaper shading levels (see the
+ * ShadingLevel enum of the components module).
  *
- * Thanks to IDs, it loads the corresponding textures to fill the planet to
- * create. It also needs information about the Data type we want to put inside
- * and the type of shader manager.
- * With these information it is possible to create a Planet Object and set its
- * initial matrices.
- * After the call of this function, it will be possible to display this object in
- * a 3D scene.
+ * Every level keeps the textures and the lighting of the mesh permutation.
+ *
+ * @param shaders The library sharing the shader managers between the planets.
+ * @param material The material of the body to configure.
+ * @param features The ShaderFeature flags of the mesh permutation.
+ ********************************************************************************/
+void setShadingLevels(ShaderLibrary &shaders, MaterialComponent &material, unsigned int features)
+{
+    material.shaders[SHADING_IMPOSTOR] = shaders.getBody(features | SHADER_IMPOSTOR).get();
+    material.shaders[SHADING_LOW_DETAIL] = shaders.getBody(features | SHADER_IMPOSTOR | SHADER_AVERAGE_COLOR).get();
+    material.shaders[SHADING_POINT] = shaders.getBody(features | SHADER_POINT | SHADER_AVERAGE_COLOR).get();
+}
+
+/**
+ * @brief Build the material of a body.
+ *
+ * The shaders are shared by all the bodies using the same permutation, they
+ * stay owned by the library.
+ *
+ * @tparam Features A combination of ShaderFeature flags (defined in the shaderManager module)
+ *         selecting the permutation of the body shader used by the body.
+ * @param shaders The library sharing the shader managers between the planets.
+ * @param nbTextures Amount of textures to bind from the given array, at most
+ *                   MaterialComponent::MAX_TEXTURES.
+ * @param textures An array of integers that contains textures ids.
+ *
+ * @return The material, to give to a body of the solar system.
+ ********************************************************************************/
+template <unsigned int Features = SHADER_LIGHTED>
+MaterialComponent createMaterial(ShaderLibrary &shaders, unsigned int nbTextures, const GLuint *textures)
+{
+    if (nbTextures > MaterialComponent::MAX_TEXTURES)
+    {
+        throw std::out_of_range("Too many textures for a body");
+    }
+
+    MaterialComponent material;
+    for (unsigned int i = 0; i < nbTextures; i++)
+    {
+        material.textures[i] = textures[i];
+    }
+    material.nbTextures = nbTextures;
+    material.shaders[SHADING_MESH] = shaders.getBody(Features).get();
+    setShadingLevels(shaders, material, Features); // Used when the body is small on screen
+    return material;
+}
+
+/**
+ * @brief Adds a planet to a solar system.
+ *
+ * Its matrices are set by the solar system (see `SolarSystem::addPlanet()`).
  *
  * @tparam DataType A type with information to bind to the planet, must be a PlanetData
  *         or a derived class.
- * @tparam ShaderType A type that gathers information about the shader management of the
- *         planet object, must be a ShaderManager or a derived class.
- * @param applicationPath A FilePath object (class of the glimac folder) to the folder where we find the shader files.
- * @param nbTextures Amount of textures to load from the given array.
+ * @tparam Features A combination of ShaderFeature flags (defined in the shaderManager module)
+ *         selecting the permutation of the body shader used by the planet.
+ * @param shaders The library sharing the shader managers between the planets.
+ * @param solarSys The solar system receiving the planet.
+ * @param nbTextures Amount of textures to bind from the given array.
  * @param textures An array of integers that contains textures ids.
- * @param windowWidth Width of the window.
- * @param windowHeight Height of the window.
  *
- * @return A PlanetObject, the object that can be displayed in a 3D scene.
+ * @return The handle of the planet.
  ********************************************************************************/
-template <typename DataType = PlanetData, typename ShaderType = ShaderManager, typename CelestialType = PlanetObject>
-CelestialType createPlanet(FilePath applicationPath, int nbTextures, unsigned int *textures, float windowWidth, float windowHeight)
+template <typename DataType, unsigned int Features = SHADER_LIGHTED>
+Entity createPlanet(ShaderLibrary &shaders, SolarSystem &solarSys, unsigned int nbTextures, const GLuint *textures)
 {
-    auto planetData = DataType();
-    auto shader = std::make_shared<ShaderType>(applicationPath); // Need a shared_ptr here to avoid C pointers
-    auto planet = CelestialType(nbTextures, textures, planetData, shader);
-    planet.configureMatrices(windowWidth, windowHeight); // Build the initial matrices linked to this planet
-    return planet;
+    return solarSys.addPlanet(DataType(), createMaterial<Features>(shaders, nbTextures, textures));
 }
 
 /**
- * @brief Build a Planet object.
- *
- * Thanks to an ID, it loads the corresponding texture to fill the planet to
- * create. It also needs information about the Data type we want to put inside
- * and the type of shader manager.
- * With these information it is possible to create a Planet Object and set its
- * initial matrices.
- * After the call of this function, it will be possible to display this object in
- * a 3D scene.
+ * @brief Adds a planet with a single texture to a solar system.
  *
  * @tparam DataType A type with information to bind to the planet, must be a PlanetData
  *         or a derived class.
- * @tparam ShaderType A type that gathers information about the shader management of the
- *         planet object, must be a ShaderManager or a derived class.
- * @param applicationPath A FilePath object (class of the glimac folder) to the folder where we find the shader files.
+ * @tparam Features A combination of ShaderFeature flags (defined in the shaderManager module)
+ *         selecting the permutation of the body shader used by the planet.
+ * @param shaders The library sharing the shader managers between the planets.
+ * @param solarSys The solar system receiving the planet.
  * @param texture An integer ID of the texture we want to bind.
- * @param windowWidth Width of the window.
- * @param windowHeight Height of the window.
  *
- * @return A PlanetObject, the object that can be displayed in a 3D scene.
+ * @return The handle of the planet.
  ********************************************************************************/
-template <typename DataType, typename ShaderType = ShaderManager, typename CelestialType = PlanetObject>
-CelestialType createPlanet(FilePath applicationPath, unsigned int texture, float windowWidth, float windowHeight)
+template <typename DataType, unsigned int Features = SHADER_LIGHTED>
+Entity createPlanet(ShaderLibrary &shaders, SolarSystem &solarSys, GLuint texture)
 {
-    auto planetData = DataType();
-    auto shader = std::make_shared<ShaderType>(applicationPath); // Need a shared_ptr here to avoid C pointers
-    auto planet = CelestialType(texture, planetData, shader);
-    planet.configureMatrices(windowWidth, windowHeight); // Build the initial matrices linked to this planet
-    return planet;
+    return createPlanet<DataType, Features>(shaders, solarSys, 1, &texture);
 }
 
 /**
- * @brief Build a Planet object.
- *
- * Thanks to an ID, it loads the corresponding texture to fill the planet to
- * create. It also needs information about the Data type we want to put inside
- * and the type of shader manager.
- * With these information it is possible to create a Planet Object and set its
- * initial matrices.
- * After the call of this function, it will be possible to display this object in
- * a 3D scene.
+ * @brief Adds a planet and its ring to a solar system.
  *
  * @tparam DataType A type with information to bind to the planet, must be a PlanetData
- *         or a derived class.
- * @tparam ShaderType A type that gathers information about the shader management of the
- *         planet object, must be a ShaderManager or a derived class.
- * @param applicationPath A FilePath object (class of the glimac folder) to the folder where we find the shader files.
+ *         or a derived class, with a ring.
+ * @tparam Features A combination of ShaderFeature flags (defined in the shaderManager module)
+ *         selecting the permutation of the body shader used by the planet.
+ * @param shaders The library sharing the shader managers between the planets.
+ * @param solarSys The solar system receiving the planet.
  * @param texture An integer ID of the texture we want to bind.
- * @param windowWidth Width of the window.
- * @param windowHeight Height of the window.
+ * @param ringText An integer ID of the texture of the ring.
  *
- * @return A PlanetObject, the object that can be displayed in a 3D scene.
+ * @return The handle of the planet.
  ********************************************************************************/
-template <typename DataType, typename ShaderType = ShaderManager, typename RingShaderType = ShaderManager>
-PlanetObject createPlanetWithRing(FilePath applicationPath, unsigned int texture, unsigned int ringText, float windowWidth, float windowHeight)
+template <typename DataType, unsigned int Features = SHADER_LIGHTED>
+Entity createPlanetWithRing(ShaderLibrary &shaders, SolarSystem &solarSys, GLuint texture, GLuint ringText)
 {
-    auto planetData = DataType();
-    auto shader = std::make_shared<ShaderType>(applicationPath); // Need a shared_ptr here to avoid C pointers
-    auto ringShader = std::make_shared<RingShaderType>(applicationPath);
-    auto planet = PlanetObject(texture, ringText, planetData, shader, ringShader);
-    planet.configureMatrices(windowWidth, windowHeight); // Build the initial matrices linked to this planet
+    Entity planet = createPlanet<DataType, Features>(shaders, solarSys, texture);
+    solarSys.addRing(planet, ringText, shaders.getBody(SHADER_LIGHTED | SHADER_RING).get());
     return planet;
 }
 
+/**
+ * @brief Adds a satellite to the last planet added to a solar system.
+ *
+ * @tparam DataType A type with information to bind to the satellite, must be a PlanetData
+ *         or a derived class.
+ * @tparam Features A combination of ShaderFeature flags (defined in the shaderManager module)
+ *         selecting the permutation of the body shader used by the satellite.
+ * @param shaders The library sharing the shader managers between the planets.
+ * @param solarSys The solar system storing the planet.
+ * @param planet The planet of the satellite.
+ * @param texture An integer ID of the texture we want to bind.
+ *
+ * @return The handle of the satellite.
+ ********************************************************************************/
+template <typename DataType, unsigned int Features = SHADER_LIGHTED>
+Entity createSatellite(ShaderLibrary &shaders, SolarSystem &solarSys, Entity planet, GLuint texture)
+{
+    return solarSys.addSatellite(planet, DataType(), createMaterial<Features>(shaders, 1, &texture));
+}
+
 /**
  * @brief Fills an empty solar sytem with all the information about it (planets...).
  *
  *  Creates planets and add them inside the given solar system object.
  *  It starts by creating and loading textures (at the Path stored in the PathStorage class
  *  defined in the pathStorage module).
- *  Then, it creates PlanetObject objects (class defined in the planetObject module) and store
- *  it inside a SolarSytem object (defined in the solarSystem module).
+ *  Then, it creates the bodies as entities of a SolarSytem object (defined in the
+ *  solarSystem module), each planet followed by its satellites.
  *
- * @param relativePath Path location where the app is ran.
- * @param windowWidth Width of the window.
- * @param windowHeight Height of the window.
+ * @param shaders The library sharing the shader managers between the planets.
  * @param solarSys A SolarSystem object we want to fill.
+ * @param snapshot Loads the textures, their paths are saved with the scene
+ *                 (see the sceneSnapshot module).
  ********************************************************************************/
-void createSolarSys(char *relativePath, float windowWidth, float windowHeight, SolarSystem &solarSys)
+void createSolarSys(ShaderLibrary &shaders, SolarSystem &solarSys, SceneSnapshot &snapshot)
 {
-
-    FilePath applicationPath(relativePath);
-
     // Textures loading
-    unsigned int sunText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_SUN);
-
-    unsigned int mercuryText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_MERCURY);
-
-    unsigned int venusText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_VENUS);
-
-    unsigned int earthText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_EARTH);
-    unsigned int cloudText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_CLOUDS);
-    unsigned int moonText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_MOON);
-
-    unsigned int marsText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_MARS);
-    unsigned int phobosText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_PHOBOS);
-    unsigned int deimosText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_DEIMOS);
-
-    unsigned int jupiterText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_JUPITER);
-    unsigned int callistoText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_CALLISTO);
-    unsigned int ganymedeText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_GANYMEDE);
-    unsigned int europaText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_EUROPA);
-    unsigned int ioText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_IO);
-
-    unsigned int saturnText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_SATURN);
-    unsigned int saturnRingText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_SATURN_RING);
-    unsigned int mimasText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_MIMAS);
-    unsigned int enceladusText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_ENCELADUS);
-    unsigned int tethysText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_TETHYS);
-    unsigned int dioneText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_DIONE);
-    unsigned int rehaText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_REHA);
-    unsigned int titanText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_TITAN);
-    unsigned int hyperionText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_HYPERION);
-    unsigned int iapetusText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_IAPETUS);
-
-    unsigned int uranusText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_URANUS);
-    unsigned int uranusRingText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_URANUS_RING);
-    unsigned int arielText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_ARIEL);
-    unsigned int umbrielText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_UMBRIEL);
-    unsigned int titaniaText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_TITANIA);
-    unsigned int oberonText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_OBERON);
-    unsigned int mirandaText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_MIRANDA);
-
-    unsigned int neptuneText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_NEPTUNE);
-    unsigned int tritonText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_TRITON);
-    unsigned int nereidText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_NEREID);
-
-    unsigned int plutoText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_PLUTO);
-    unsigned int charonText = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_CHARON);
+    unsigned int sunText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_SUN);
+
+    unsigned int mercuryText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_MERCURY);
+
+    unsigned int venusText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_VENUS);
+
+    unsigned int earthText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_EARTH);
+    unsigned int cloudText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_CLOUDS);
+    unsigned int moonText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_MOON);
+
+    unsigned int marsText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_MARS);
+    unsigned int phobosText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_PHOBOS);
+    unsigned int deimosText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_DEIMOS);
+
+    unsigned int jupiterText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_JUPITER);
+    unsigned int callistoText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_CALLISTO);
+    unsigned int ganymedeText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_GANYMEDE);
+    unsigned int europaText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_EUROPA);
+    unsigned int ioText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_IO);
+
+    unsigned int saturnText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_SATURN);
+    unsigned int saturnRingText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_SATURN_RING);
+    unsigned int mimasText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_MIMAS);
+    unsigned int enceladusText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_ENCELADUS);
+    unsigned int tethysText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_TETHYS);
+    unsigned int dioneText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_DIONE);
+    unsigned int rehaText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_REHA);
+    unsigned int titanText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_TITAN);
+    unsigned int hyperionText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_HYPERION);
+    unsigned int iapetusText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_IAPETUS);
+
+    unsigned int uranusText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_URANUS);
+    unsigned int uranusRingText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_URANUS_RING);
+    unsigned int arielText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_ARIEL);
+    unsigned int umbrielText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_UMBRIEL);
+    unsigned int titaniaText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_TITANIA);
+    unsigned int oberonText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_OBERON);
+    unsigned int mirandaText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_MIRANDA);
+
+    unsigned int neptuneText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_NEPTUNE);
+    unsigned int tritonText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_TRITON);
+    unsigned int nereidText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_NEREID);
+
+    unsigned int plutoText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_PLUTO);
+    unsigned int charonText = snapshot.loadTexture(PathStorage::PATH_TEXTURE_CHARON);
 
     // Sun
-    PlanetObject sun = createPlanet<SunData, Shader1FullyLightedTexture>(applicationPath, sunText, windowWidth, windowHeight); // The sun is fully lighted and doesn't depend on any source of light
+    createPlanet<SunData, SHADER_EMISSIVE>(shaders, solarSys, sunText); // The sun is fully lighted and doesn't depend on any source of light
 
     // Mercury
-    PlanetObject mercury = createPlanet<MercuryData, Shader1Texture>(applicationPath, mercuryText, windowWidth, windowHeight);
+    createPlanet<MercuryData>(shaders, solarSys, mercuryText);
 
     // Venus
-    PlanetObject venus = createPlanet<VenusData, Shader1Texture>(applicationPath, venusText, windowWidth, windowHeight);
+    createPlanet<VenusData>(shaders, solarSys, venusText);
 
-    // Earth
-    unsigned int earthTextures[] = {earthText, cloudText};
-    PlanetObject earth = createPlanet<EarthData, Shader2Texture>(applicationPath, 2, earthTextures, windowWidth, windowHeight);
-    SatelliteObject moon = createPlanet<MoonData, Shader1Texture, SatelliteObject>(applicationPath, moonText, windowWidth, windowHeight);
-    earth.addSatellite(moon);
+    // Earth, the satellites are added right after their planet
+    GLuint earthTextures[] = {earthText, cloudText};
+    Entity earth = createPlanet<EarthData, SHADER_LIGHTED | SHADER_SECOND_TEXTURE>(shaders, solarSys, 2, earthTextures);
+    createSatellite<MoonData>(shaders, solarSys, earth, moonText);
 
     // Mars
-    PlanetObject mars = createPlanet<MarsData, Shader1Texture>(applicationPath, marsText, windowWidth, windowHeight);
-    SatelliteObject phobos = createPlanet<PhobosData, Shader1Texture, SatelliteObject>(applicationPath, phobosText, windowWidth, windowHeight);
-    SatelliteObject deimos = createPlanet<DeimosData, Shader1Texture, SatelliteObject>(applicationPath, deimosText, windowWidth, windowHeight);
-
-    mars.addSatellite(phobos);
-    mars.addSatellite(deimos);
+    Entity mars = createPlanet<MarsData>(shaders, solarSys, marsText);
+    createSatellite<PhobosData>(shaders, solarSys, mars, phobosText);
+    createSatellite<DeimosData>(shaders, solarSys, mars, deimosText);
 
     // Jupiter
-    PlanetObject jupiter = createPlanet<JupiterData, Shader1Texture>(applicationPath, jupiterText, windowHeight, windowHeight);
-    SatelliteObject callisto = createPlanet<CallistoData, Shader1Texture, SatelliteObject>(applicationPath, callistoText, windowWidth, windowHeight);
-    SatelliteObject ganymede = createPlanet<GanymedeData, Shader1Texture, SatelliteObject>(applicationPath, ganymedeText, windowWidth, windowHeight);
-    SatelliteObject europa = createPlanet<EuropaData, Shader1Texture, SatelliteObject>(applicationPath, europaText, windowWidth, windowHeight);
-    SatelliteObject io = createPlanet<IoData, Shader1Texture, SatelliteObject>(applicationPath, ioText, windowWidth, windowHeight);
-
-    jupiter.addSatellite(callisto);
-    jupiter.addSatellite(ganymede);
-    jupiter.addSatellite(europa);
-    jupiter.addSatellite(io);
+    Entity jupiter = createPlanet<JupiterData>(shaders, solarSys, jupiterText);
+    createSatellite<CallistoData>(shaders, solarSys, jupiter, callistoText);
+    createSatellite<GanymedeData>(shaders, solarSys, jupiter, ganymedeText);
+    createSatellite<EuropaData>(shaders, solarSys, jupiter, europaText);
+    createSatellite<IoData>(shaders, solarSys, jupiter, ioText);
 
     // Saturn
-    PlanetObject saturn = createPlanetWithRing<SaturnData, Shader1Texture, ShaderTorusTexture>(applicationPath, saturnText, saturnRingText, windowWidth, windowHeight);
-    SatelliteObject mimas = createPlanet<MimasData, Shader1Texture, SatelliteObject>(applicationPath, mimasText, windowWidth, windowHeight);
-    SatelliteObject enceladus = createPlanet<EnceladusData, Shader1Texture, SatelliteObject>(applicationPath, enceladusText, windowWidth, windowHeight);
-    SatelliteObject tethys = createPlanet<TethysData, Shader1Texture, SatelliteObject>(applicationPath, tethysText, windowWidth, windowHeight);
-    SatelliteObject dione = createPlanet<DioneData, Shader1Texture, SatelliteObject>(applicationPath, dioneText, windowWidth, windowHeight);
-    SatelliteObject rhea = createPlanet<RheaData, Shader1Texture, SatelliteObject>(applicationPath, rehaText, windowWidth, windowHeight);
-    SatelliteObject titan = createPlanet<TitanData, Shader1Texture, SatelliteObject>(applicationPath, titanText, windowWidth, windowHeight);
-    SatelliteObject hyperion = createPlanet<HyperionData, Shader1Texture, SatelliteObject>(applicationPath, hyperionText, windowWidth, windowHeight);
-    SatelliteObject iapetus = createPlanet<IapetusData, Shader1Texture, SatelliteObject>(applicationPath, iapetusText, windowWidth, windowHeight);
-    saturn.addSatellite(mimas);
-    saturn.addSatellite(enceladus);
-    saturn.addSatellite(tethys);
-    saturn.addSatellite(dione);
-    saturn.addSatellite(rhea);
-    saturn.addSatellite(titan);
-    saturn.addSatellite(hyperion);
-    saturn.addSatellite(iapetus);
+    Entity saturn = createPlanetWithRing<SaturnData>(shaders, solarSys, saturnText, saturnRingText);
+    createSatellite<MimasData>(shaders, solarSys, saturn, mimasText);
+    createSatellite<EnceladusData>(shaders, solarSys, saturn, enceladusText);
+    createSatellite<TethysData>(shaders, solarSys, saturn, tethysText);
+    createSatellite<DioneData>(shaders, solarSys, saturn, dioneText);
+    createSatellite<RheaData>(shaders, solarSys, saturn, rehaText);
+    createSatellite<TitanData>(shaders, solarSys, saturn, titanText);
+    createSatellite<HyperionData>(shaders, solarSys, saturn, hyperionText);
+    createSatellite<IapetusData>(shaders, solarSys, saturn, iapetusText);
 
     // Uranus
-    PlanetObject uranus = createPlanetWithRing<UranusData, Shader1Texture, ShaderTorusTexture>(applicationPath, uranusText, uranusRingText, windowWidth, windowHeight);
-    SatelliteObject ariel = createPlanet<ArielData, Shader1Texture, SatelliteObject>(applicationPath, arielText, windowWidth, windowHeight);
-    SatelliteObject umbriel = createPlanet<UmbrielData, Shader1Texture, SatelliteObject>(applicationPath, umbrielText, windowWidth, windowHeight);
-    SatelliteObject titania = createPlanet<TitaniaData, Shader1Texture, SatelliteObject>(applicationPath, titaniaText, windowWidth, windowHeight);
-    SatelliteObject oberon = createPlanet<OberonData, Shader1Texture, SatelliteObject>(applicationPath, oberonText, windowWidth, windowHeight);
-    SatelliteObject miranda = createPlanet<MirandaData, Shader1Texture, SatelliteObject>(applicationPath, mirandaText, windowWidth, windowHeight);
-
-    uranus.addSatellite(ariel);
-    uranus.addSatellite(umbriel);
-    uranus.addSatellite(titania);
-    uranus.addSatellite(oberon);
-    uranus.addSatellite(miranda);
+    Entity uranus = createPlanetWithRing<UranusData>(shaders, solarSys, uranusText, uranusRingText);
+    createSatellite<ArielData>(shaders, solarSys, uranus, arielText);
+    createSatellite<UmbrielData>(shaders, solarSys, uranus, umbrielText);
+    createSatellite<TitaniaData>(shaders, solarSys, uranus, titaniaText);
+    createSatellite<OberonData>(shaders, solarSys, uranus, oberonText);
+    createSatellite<MirandaData>(shaders, solarSys, uranus, mirandaText);
 
     // Neptune
-    PlanetObject neptune = createPlanet<NeptuneData, Shader1Texture>(applicationPath, neptuneText, windowWidth, windowHeight);
-    SatelliteObject triton = createPlanet<TritonData, Shader1Texture, SatelliteObject>(applicationPath, tritonText, windowWidth, windowHeight);
-    SatelliteObject nereid = createPlanet<NereidData, Shader1Texture, SatelliteObject>(applicationPath, nereidText, windowWidth, windowHeight);
-
-    neptune.addSatellite(triton);
-    neptune.addSatellite(nereid);
+    Entity neptune = createPlanet<NeptuneData>(shaders, solarSys, neptuneText);
+    createSatellite<TritonData>(shaders, solarSys, neptune, tritonText);
+    createSatellite<NereidData>(shaders, solarSys, neptune, nereidText);
 
     // Pluto
-    PlanetObject pluto = createPlanet<PlutoData, Shader1Texture>(applicationPath, plutoText, windowWidth, windowHeight);
-    SatelliteObject charon = createPlanet<CharonData, Shader1Texture, SatelliteObject>(applicationPath, charonText, windowWidth, windowHeight);
-
-    pluto.addSatellite(charon);
-
-    // Fill the solar system
-    solarSys.addPlanet(std::make_unique<PlanetObject>(sun));
-    solarSys.addPlanet(std::make_unique<PlanetObject>(mercury));
-    solarSys.addPlanet(std::make_unique<PlanetObject>(venus));
-    solarSys.addPlanet(std::make_unique<PlanetObject>(earth));
-    solarSys.addPlanet(std::make_unique<PlanetObject>(mars));
-    solarSys.addPlanet(std::make_unique<PlanetObject>(jupiter));
-    solarSys.addPlanet(std::make_unique<PlanetObject>(saturn));
-    solarSys.addPlanet(std::make_unique<PlanetObject>(uranus));
-    solarSys.addPlanet(std::make_unique<PlanetObject>(neptune));
-    solarSys.addPlanet(std::make_unique<PlanetObject>(pluto));
+    Entity pluto = createPlanet<PlutoData>(shaders, solarSys, plutoText);
+    createSatellite<CharonData>(shaders, solarSys, pluto, charonText);
+}
+
+/**
+ * @brief Fills an empty solar system with a stress scene (see the stressScene module).
+ *
+ *  The textures are drawn by the scene, then the sun and the planets are created,
+ *  each planet followed by its satellites. The bodies using the same texture
+ *  share their material.
+ *
+ * @param shaders The library sharing the shader managers between the planets.
+ * @param solarSys A SolarSystem object we want to fill.
+ * @param scene The settings of the scene.
+ ********************************************************************************/
+void createStressSys(ShaderLibrary &shaders, SolarSystem &solarSys, const StressScene &scene)
+{
+    std::vector<GLuint> textures = scene.createTextures();
+
+    std::vector<MaterialComponent> materials;
+    for (GLuint texture : textures)
+    {
+        materials.push_back(createMaterial(shaders, 1, &texture));
+    }
+    auto ringShader = shaders.getBody(SHADER_LIGHTED | SHADER_RING).get();
+
+    // Sun, the source of light
+    solarSys.addPlanet(SunData(), createMaterial<SHADER_EMISSIVE>(shaders, 1, &textures[0]));
+
+    for (unsigned int i = 0; i < scene.getNbPlanets(); i++)
+    {
+        Entity planet = solarSys.addPlanet(scene.createPlanetData(i), materials[i % materials.size()]);
+        if (scene.hasRing(i))
+        {
+            solarSys.addRing(planet, textures[(i + 1) % textures.size()], ringShader);
+        }
+
+        for (unsigned int j = 0; j < scene.getNbMoons(); j++)
+        {
+            solarSys.addSatellite(planet, scene.createMoonData(i, j), materials[(i + j + 1) % materials.size()]);
+        }
+    }
 }
 
 /**
@@ -283,16 +316,20 @@ void createSolarSys(char *relativePath, float windowWidth, float windowHeight, S
  * and the rendering of a 3D environment.
  *
  * @param relativePath Path location where the app is ran.
+ * @param benchmark If not null, the tour it plays replaces the user (see the
+ *                  benchmark module), the window is headless. Its stress
+ *                  scene, if any, replaces the solar system.
  *
  * @return The code error of the core engine part.
  ********************************************************************************/
-int render3DScene(char *relativePath)
+int render3DScene(char *relativePath, Benchmark *benchmark)
 {
     /*************** WINDOW CREATION *****************/
     float windowWidth = 1000;
     float windowHeight = 1000;
+    float frameBudget = DynamicResolution::DEFAULT_BUDGET; // GPU time allowed for a frame (in ms), the resolution is lowered to stay under it
 
-    if (!Window::initWindowLib()) // Initialize the window library
+    if (!Window::initWindowLib(benchmark != nullptr)) // Initialize the window library
     {
         return ERR_INT_CODE; // defined inside the tools module
     }
@@ -303,11 +340,60 @@ int render3DScene(char *relativePath)
         return ERR_INT_CODE; // defined inside the tools module
     }
 
+    // A benchmark measures the frames, not the refresh of the screen
+    window->setVSync(!benchmark);
+
+#ifdef SOLARSYS_GL_TRACE
+    // Every OpenGL call goes through the interceptor, which counts them frame by frame
+    GLInterceptor::install();
+    if (benchmark && !benchmark->getGLCapturePath().empty() &&
+        !GLInterceptor::startCapture(benchmark->getGLCapturePath(), windowWidth, windowHeight))
+    {
+        std::cout << "The OpenGL trace " << benchmark->getGLCapturePath() << " can't be created" << std::endl;
+        return ERR_INT_CODE;
+    }
+#endif
+
     /********************* GRAPHIC OBJECTS CREATION ********************/
 
-    // Solar System
+    float startTime = getTime();
+
+    // Shaders, a single program is compiled for all the bodies using the same files
+    FilePath applicationPath(relativePath);
+    auto shaders = std::make_unique<ShaderLibrary>(applicationPath);
+
+    // Solar System, mapped from the snapshot of the previous start when there is one
+    // A stress scene is made up each time, the snapshot only keeps the solar system
+    const StressScene *stressScene = benchmark ? benchmark->getStressScene() : nullptr;
+    SceneSnapshot snapshot(applicationPath);
+    bool fromSnapshot = !stressScene && snapshot.open();
     auto solarSys = std::make_unique<SolarSystem>();
-    createSolarSys(relativePath, windowWidth, windowHeight, *solarSys);
+    if (fromSnapshot)
+    {
+        try
+        {
+            snapshot.restore(*shaders, *solarSys);
+        }
+        catch (const std::exception &error)
+        {
+            // A damaged snapshot is replaced by the one of the scene built again
+            std::cout << error.what() << ", the scene is built again" << std::endl;
+            snapshot.close();
+            solarSys = std::make_unique<SolarSystem>();
+            fromSnapshot = false;
+        }
+    }
+
+    if (stressScene)
+    {
+        PROFILE_ZONE("Scene build");
+        createStressSys(*shaders, *solarSys, *stressScene);
+    }
+    else if (!fromSnapshot)
+    {
+        PROFILE_ZONE("Scene build");
+        createSolarSys(*shaders, *solarSys, snapshot);
+    }
 
     // Camera initialization
     Camera camera = Camera();
@@ -318,7 +404,7 @@ int render3DScene(char *relativePath)
     /********************* CONTEXT OBJECT CREATION ********************/
 
     Context context = Context(camera, *solarSys, sunLight);
-    float inProgramElapsedTime = getTime();
+    float inProgramElapsedTime = benchmark ? 0 : getTime(); // A benchmark always starts from the same positions
     float currentElapsedTime = getTime();
 
     /********************* SETTING EVENTS AND PASSING CONTEXT ********************/
@@ -326,64 +412,186 @@ int render3DScene(char *relativePath)
     window->configureEvents(context);
 
     // Skybox
-    FilePath applicationPath(relativePath);
     auto textID = RenderEngine::createTexture(PathStorage::PATH_TEXTURE_SKYBOX);
-    auto skybox = std::make_unique<Skybox>(applicationPath, textID, windowWidth, windowHeight);
+    auto skybox = std::make_unique<Skybox>(*shaders, textID);
 
     /***************** INITIALIZE THE 3D CONFIGURATION (DEPTH) *******************/
 
     auto renderEng = std::make_unique<RenderEngine>();
-    renderEng->createSphere();
+    renderEng->configureProjection(windowWidth, windowHeight);
+    if (fromSnapshot)
+    {
+        snapshot.restore(*renderEng); // The sphere and the cube of the skybox, already built
+    }
+    else
+    {
+        renderEng->createSphere();
+        renderEng->integrateSkybox(*skybox); // Allows the render engine to add the cube of the skybox in vaos and vbos
+
+        if (!stressScene && !snapshot.write(*solarSys, *renderEng))
+        {
+            std::cout << "The scene snapshot can't be written, the next start builds the scene again" << std::endl;
+        }
+    }
 
-    for (auto &planet : (*solarSys))
+    if (!renderEng->integrateIndirectRendering(applicationPath, *shaders, *solarSys))
     {
-        renderEng->createPlanetRing(planet);
+        std::cout << "GPU driven rendering unavailable (needs OpenGL 4.3), the bodies are drawn one by one" << std::endl;
     }
 
-    renderEng->integrateSkybox(*skybox); // Allows the render engine to add the cube of the skybox in vaos and vbos
+    if (benchmark)
+    {
+        benchmark->configure(context, *renderEng);
+    }
+
+    // Every program has been requested, wait for the end of their compilation
+    shaders->finish();
+    shaders->printStats(std::cout);
+    std::cout << "Scene ready in " << (getTime() - startTime) * 1000 << " ms" << (fromSnapshot ? " (from the snapshot)" : "") << std::endl;
 
     /********************* RENDERING LOOP ********************/
 
+    // The calls of the loading are the first frame of the OpenGL trace, the statistics leave them out
+    GLInterceptor::endFrame();
+    GLInterceptor::resetStats();
+
     float step = 0;
+    UpdateScheduler scheduler; // Skips the planets which barely moved on screen
 
-    while (window->isWindowOpen())
+    while (window->isWindowOpen() && (!benchmark || benchmark->isRunning()))
     {
-        RenderEngine::clearDisplay(); // Allows the scene to update its rendering by clearing the display
+        if (benchmark)
+        {
+            benchmark->beginFrame(context); // Plays the tour in place of the user
+            step = Benchmark::TIME_STEP;
+        }
+        else
+        {
+            step = getTime() - currentElapsedTime;
+            currentElapsedTime = getTime();
+        }
 
-        RenderEngine::disableZBuffer();
+        {
+            PROFILE_ZONE("Simulation");
 
-        renderEng->start((*skybox));
-        renderEng->draw((*skybox));
-        renderEng->end((*skybox));
+            // The camera and the projection of the previous frame estimate the motions on screen
+            scheduler.setEnabled(context.isUpdateScheduling());
+            scheduler.beginFrame(camera.getViewMatrix(), renderEng->getPixelScale(), context.isCamFocused());
 
-        RenderEngine::enableZBuffer();
+            unsigned int planetIndex = 0;
+            for (Entity planet : (*solarSys))
+            {
+                inProgramElapsedTime += step * context.getSpeedMultiplier();
+                inProgramElapsedTime += context.consumeTimeLeap();
 
-        step = getTime() - currentElapsedTime;
-        currentElapsedTime = getTime();
+                // Update the matrices regarding the time, we want the satellites to update its matrices only in the focused mode
+                scheduler.update(planetIndex++, *solarSys, planet, inProgramElapsedTime);
+            }
+            context.update_camera();
+        }
+        if (benchmark)
+        {
+            benchmark->endSimulation();
+        }
 
-        for (auto &planet : (*solarSys))
         {
-            inProgramElapsedTime += step * context.getSpeedMultiplier();
-            inProgramElapsedTime += context.consumeTimeLeap();
+            PROFILE_ZONE("Rendering");
 
-            // Update the matrices regarding the time, we want the satellites to update its matrices only in the focused mode
-            planet.updateMatrices(inProgramElapsedTime, context.isCamFocused());
-            context.update_camera();
-            renderEng->draw(planet, camera, sunLight); // Draw the current planet
+            renderEng->setFrameBudget(context.isDynamicResolution() ? frameBudget : 0);
+
+            // Camera, projection and light are sent once for the whole frame
+            renderEng->updateFrameUniforms(camera, sunLight);
+
+            renderEng->startFrame(); // Allows the scene to update its rendering by clearing the display
+
+            RenderEngine::disableZBuffer();
+
+            renderEng->start((*skybox));
+            renderEng->draw((*skybox));
+            renderEng->end((*skybox));
+
+            RenderEngine::enableZBuffer();
+
+            if (context.isGpuDriven() && renderEng->hasIndirectRendering())
+            {
+                renderEng->drawIndirect(*solarSys, camera); // Culling and draw calls made by the GPU
+            }
+            else
+            {
+                renderEng->drawBodies(*solarSys, camera); // Culling and sorting made by the CPU
+            }
+
+            renderEng->endFrame(); // Copy the scene to the window
+        }
+        if (benchmark)
+        {
+            benchmark->endRendering();
         }
 
         window->manageWindow(); // Make the window active (events) and swap the buffers
+
+        FrameArena::nextFrameAll(); // The temporary data of the frame is released with a pointer move
+
+        AllocationTracker::endFrame(std::cout); // Reports the frames which still allocate once warmed up
+
+        GLInterceptor::endFrame(); // Adds up the OpenGL calls of the frame (SOLARSYS_GL_TRACE)
+
+        if (benchmark)
+        {
+            benchmark->endFrame(*renderEng);
+        }
+
+        PROFILE_FRAME();
+    }
+
+    // Profiled builds (SOLARSYS_PROFILE) leave the trace of the run beside the app
+    if (Profiler::isEnabled())
+    {
+        FilePath traceFile = applicationPath.dirPath() + PathStorage::RELATIVE_PATH_PROFILE_TRACE;
+        if (Profiler::writeTrace(traceFile))
+        {
+            std::cout << "Profile written to " << traceFile << " (" << Profiler::getDroppedEvents() << " events dropped)" << std::endl;
+        }
+    }
+
+    // Builds with the OpenGL interceptor (SOLARSYS_GL_TRACE) tell the calls of the frames
+    if (GLInterceptor::isInstalled())
+    {
+        if (GLInterceptor::isCapturing())
+        {
+            bool traceWritten = GLInterceptor::stopCapture();
+            std::cout << "OpenGL trace " << (traceWritten ? "written to " : "incomplete, the disk may be full: ") << benchmark->getGLCapturePath() << std::endl;
+        }
+        GLInterceptor::printStats(std::cout);
+    }
+
+    std::cout << "Frame arena: " << FrameArena::getGlobalHighWaterMark() << " bytes used at most out of "
+              << FrameArena::getGlobalCapacity() << ", " << FrameArena::getGlobalOverflowCount() << " overflows" << std::endl;
+
+    // A steady frame loop doesn't touch the heap, a run which did fails when the allocations are counted
+    bool allocationFree = AllocationTracker::getSteadyAllocations() == 0;
+    if (!allocationFree)
+    {
+        std::cout << AllocationTracker::getSteadyAllocations() << " heap allocations after the warm-up" << std::endl;
+    }
+
+    bool resultsWritten = !benchmark || benchmark->writeResults();
+    if (!resultsWritten)
+    {
+        std::cout << "The benchmark results can't be written" << std::endl;
     }
 
     // Reset the resources before the reset of the window library
     solarSys.reset();
     skybox.reset();
     renderEng.reset();
+    shaders.reset();
+    GLInterceptor::uninstall();
     window->freeCurrentWindow();
     window.reset();
 
     // Ends the lib
     Window::endWindowLib();
 
-    return SUCCESS_INT_CODE; // defined inside the tools module
+    return allocationFree && resultsWritten ? SUCCESS_INT_CODE : ERR_INT_CODE; // defined inside the tools module
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module adapts the rendering resolution to    =
+=  keep the GPU time of the frames under a budget.   =
+=													 =
+======================================================
+*/
+
+#include "include/dynamicResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Sets the frame time budget.
+ *
+ * @param budget GPU time allowed for a frame (in ms), 0 to always render at the
+ *               full resolution.
+ ********************************************************************************/
+void DynamicResolution::setBudget(float budget)
+{
+    _budget = budget;
+    if (_budget <= 0)
+    {
+        _scale = 1;
+    }
+}
+
+/**
+ * @brief Retrieves the frame time budget (in ms), 0 if the scaling is disabled.
+ ********************************************************************************/
+float DynamicResolution::getBudget() const
+{
+    return _budget;
+}
+
+/**
+ * @brief Adapts the scale to the GPU time of a frame.
+ *
+ * The times arrive a few frames late, the frame may have been rendered with
+ * an older scale.
+ *
+ * @param gpuTime GPU time of the frame (in ms).
+ * @param frameScale Scale the frame was rendered with.
+ ********************************************************************************/
+void DynamicResolution::update(double gpuTime, float frameScale)
+{
+    if (_budget <= 0 || gpuTime <= 0)
+    {
+        return;
+    }
+
+    // The amount of pixels, so the square of the scale, follows the time
+    float ideal = frameScale * std::sqrt(_budget * HEADROOM / gpuTime);
+
+    if (gpuTime > _budget)
+    {
+        // Over the budget: drop at once under the targeted time, rounded down to a step
+        // The late times of the frames before a drop don't lower the scale again
+        _scale = std::min(_scale, std::floor(ideal / SCALE_STEP) * SCALE_STEP);
+    }
+    else if (frameScale == _scale && ideal >= _scale + SCALE_STEP)
+    {
+        // Enough time left for the next step: grow slowly, once the frames of the
+        // current scale are measured
+        _scale = (std::round(_scale / SCALE_STEP) + 1) * SCALE_STEP;
+    }
+
+    _scale = std::clamp(_scale, MIN_SCALE, 1.f);
+}
+
+/**
+ * @brief Retrieves the scale to apply to the window resolution.
+ *
+ * @return A scale between MIN_SCALE and 1.
+ ********************************************************************************/
+float DynamicResolution::getScale() const
+{
+    return _scale;
+}
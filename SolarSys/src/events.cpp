@@ -108,8 +108,7 @@ void Events::onKey(GLFWwindow *window, int key, [[maybe_unused]] int scancode, i
         Context *context = static_cast<Context *>(glfwGetWindowUserPointer(window));
         if (!PlanetData::_largeView)
         {
-            PlanetData::_largeView = true;
-            context->getLight().setIntensity(30.);
+            context->toggleLargeView();
         }
         context->previous_planet();
     }
@@ -119,8 +118,7 @@ void Events::onKey(GLFWwindow *window, int key, [[maybe_unused]] int scancode, i
         Context *context = static_cast<Context *>(glfwGetWindowUserPointer(window));
         if (!PlanetData::_largeView)
         {
-            PlanetData::_largeView = true;
-            context->getLight().setIntensity(30.);
+            context->toggleLargeView();
         }
         context->next_planet();
     }
@@ -156,6 +154,39 @@ void Events::onKey(GLFWwindow *window, int key, [[maybe_unused]] int scancode, i
         context->timeLeap(100); // Set a 100 unity time leap
     }
 
+    /**************** Rendering path ****************/
+
+    // Switch between the classic and the GPU driven rendering
+    else if (key == GLFW_KEY_G && action == GLFW_RELEASE)
+    {
+        Context *context = static_cast<Context *>(glfwGetWindowUserPointer(window));
+        context->toggleGpuDriven();
+    }
+    // Switch between impostors for every body and only for the small ones
+    else if (key == GLFW_KEY_I && action == GLFW_RELEASE)
+    {
+        Context *context = static_cast<Context *>(glfwGetWindowUserPointer(window));
+        context->toggleImpostors();
+    }
+    // Switch the shape of the rings
+    else if (key == GLFW_KEY_R && action == GLFW_RELEASE)
+    {
+        Context *context = static_cast<Context *>(glfwGetWindowUserPointer(window));
+        context->toggleFlatRings();
+    }
+    // Switch between the dynamic resolution and the window one
+    else if (key == GLFW_KEY_F && action == GLFW_RELEASE)
+    {
+        Context *context = static_cast<Context *>(glfwGetWindowUserPointer(window));
+        context->toggleDynamicResolution();
+    }
+    // Switch between updating the planets from their motion on screen and every frame
+    else if (key == GLFW_KEY_U && action == GLFW_RELEASE)
+    {
+        Context *context = static_cast<Context *>(glfwGetWindowUserPointer(window));
+        context->toggleUpdateScheduling();
+    }
+
     /**************** Distance system ****************/
 
     // Make the distances
@@ -164,16 +195,7 @@ void Events::onKey(GLFWwindow *window, int key, [[maybe_unused]] int scancode, i
         Context *context = static_cast<Context *>(glfwGetWindowUserPointer(window));
         if (!context->isCamFocused()) // We want to change distances only in the initial pov
         {
-            PlanetData::_largeView = !PlanetData::_largeView;
-
-            if (PlanetData::_largeView)
-            {
-                context->getLight().setIntensity(30.);
-            }
-            else
-            {
-                context->getLight().setIntensity(7.5);
-            }
+            context->toggleLargeView();
         }
     }
 }
@@ -0,0 +1,89 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module describes the view frustum of the     =
+=  camera, used to skip the objects that can't be    =
+=  seen.                                             =
+=													 =
+======================================================
+*/
+
+#include "include/frustum.hpp"
+
+/**
+ * @brief Constructor of the class.
+ *
+ * Builds a frustum containing the whole space (nothing is culled).
+ ********************************************************************************/
+Frustum::Frustum()
+{
+    for (auto &plane : _planes)
+    {
+        plane = glm::vec4(0, 0, 0, 1); // Every point is at a positive distance
+    }
+}
+
+/**
+ * @brief Constructor of the class.
+ *
+ * Extracts the planes from the matrix going from the world coordinates to the
+ * clip coordinates.
+ *
+ * @param viewProjMatrix The projection matrix multiplied by the view matrix.
+ ********************************************************************************/
+Frustum::Frustum(const glm::mat4 &viewProjMatrix)
+{
+    // glm matrices are stored by columns, we need the rows of the matrix
+    auto row = [&viewProjMatrix](int i)
+    {
+        return glm::vec4(viewProjMatrix[0][i], viewProjMatrix[1][i], viewProjMatrix[2][i], viewProjMatrix[3][i]);
+    };
+
+    // A clip point is visible if -w <= x, y, z <= w
+    // With the reversed depth of the render engine, z <= w is the near plane and -w <= z never culls (no far plane)
+    _planes[0] = row(3) + row(0); // Left
+    _planes[1] = row(3) - row(0); // Right
+    _planes[2] = row(3) + row(1); // Bottom
+    _planes[3] = row(3) - row(1); // Top
+    _planes[4] = row(3) + row(2); // Near (far when reversed)
+    _planes[5] = row(3) - row(2); // Far (near when reversed)
+
+    // Normalized to compare the distances with a radius
+    for (auto &plane : _planes)
+    {
+        plane /= glm::length(glm::vec3(plane));
+    }
+}
+
+/**
+ * @brief Tells if a sphere is at least partially inside the frustum.
+ *
+ * @param center Center of the sphere in world coordinates.
+ * @param radius Radius of the sphere.
+ *
+ * @return False if the sphere is fully outside and True otherwise.
+ ********************************************************************************/
+bool Frustum::intersectsSphere(const glm::vec3 &center, float radius) const
+{
+    for (auto &plane : _planes)
+    {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Retrieves the planes of the frustum.
+ *
+ * @return A pointer on the NB_PLANES planes, ready to be sent to a shader.
+ ********************************************************************************/
+const glm::vec4 *Frustum::getPlanes() const
+{
+    return _planes;
+}
@@ -0,0 +1,339 @@
+/*
+======================================================
+=  													 =
+=     Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module defines the GPU driven rendering of   =
+=  the bodies: a compute shader culls them and picks =
+=  their level of detail, then all of them are drawn =
+=  with two indirect calls.                          =
+=  													 =
+======================================================
+*/
+
+#include "include/indirectRenderer.hpp"
+
+#include <map>
+
+/**
+ * @brief Tells if the current OpenGL context can run the GPU driven path.
+ *
+ * @return True if compute shaders, indirect draws and storage buffers in the
+ *         vertex stage are available.
+ ********************************************************************************/
+bool IndirectRenderer::isSupported()
+{
+    if (!GLAD_GL_VERSION_4_3)
+    {
+        return false;
+    }
+
+    // OpenGL 4.3 doesn't require storage buffers outside of the compute stage
+    GLint vertexStorageBlocks = 0;
+    glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS, &vertexStorageBlocks);
+    return vertexStorageBlocks > 0;
+}
+
+/**
+ * @brief Constructor of the class.
+ *
+ * Builds the programs, the levels of detail and the texture array of the
+ * bodies of the solar system.
+ *
+ * @param applicationPath A FilePath (defined in the glimac library) describing
+ *                        the location where the app is ran.
+ * @param shaders The library sharing the shader managers.
+ * @param solarSys The solar system whose bodies are going to be drawn.
+ * @param geometry The shared geometry where the levels of detail are stored,
+ *                 it must outlive the renderer.
+ ********************************************************************************/
+IndirectRenderer::IndirectRenderer(const FilePath &applicationPath, ShaderLibrary &shaders, SolarSystem &solarSys, GeometryArena &geometry)
+    : _cullingProgram{loadComputeProgram(applicationPath.dirPath() + PathStorage::RELATIVE_PATH_COMPUTE_CULLING)},
+      _emissiveShader{shaders.getBody(SHADER_INDIRECT)}, _lightedShader{shaders.getBody(SHADER_INDIRECT | SHADER_LIGHTED)}, _geometry{geometry}
+{
+    GLuint programID = _cullingProgram.getGLId();
+    _uBodyCount = glGetUniformLocation(programID, "uBodyCount");
+    _uLodCount = glGetUniformLocation(programID, "uLodCount");
+    _uFrustumPlanes = glGetUniformLocation(programID, "uFrustumPlanes");
+    _uViewportHeight = glGetUniformLocation(programID, "uViewportHeight");
+
+    // The view and the projection are read from the frame uniform buffer
+    glUniformBlockBinding(programID, glGetUniformBlockIndex(programID, FrameUniforms::BLOCK_NAME), FrameUniforms::BINDING);
+
+    createLevelsOfDetail();
+    createTextureArray(solarSys);
+}
+
+/**
+ * @brief Destructor of the class.
+ ********************************************************************************/
+IndirectRenderer::~IndirectRenderer()
+{
+    GLuint buffers[] = {_lodBuffer, _commandBuffer, _bodyIndexBuffer};
+    glDeleteBuffers(3, buffers);
+    glDeleteTextures(1, &_textureArray);
+}
+
+/**
+ * @brief Adds all the sphere meshes to the shared geometry.
+ ********************************************************************************/
+void IndirectRenderer::createLevelsOfDetail()
+{
+    // Sphere discretizations, from the most to the least detailed, with the smallest radius on screen using them
+    const GLsizei discretizations[][2] = {{64, 32}, {32, 16}, {16, 8}, {8, 4}};
+    const float minPixelRadius[] = {200, 60, 15, 0};
+
+    std::vector<LevelOfDetail> lods;
+
+    for (unsigned int i = 0; i < sizeof(minPixelRadius) / sizeof(float); i++)
+    {
+        auto sphere = Sphere(1, discretizations[i][0], discretizations[i][1]);
+        auto mesh = _geometry.add(sphere.getIndexedDataPointer(), sphere.getIndexedVertexCount(), sphere.getIndexPointer(), sphere.getIndexCount());
+
+        // The ranges of the shared geometry are used as they are in the draw commands
+        LevelOfDetail lod;
+        lod.indexCount = mesh.m_nIndexCount;
+        lod.firstIndex = mesh.m_nFirstIndex;
+        lod.baseVertex = mesh.m_nBaseVertex;
+        lod.minPixelRadius = minPixelRadius[i];
+        lods.push_back(lod);
+    }
+    _nbLods = lods.size();
+
+    // The data won't be modified in the future
+    glGenBuffers(1, &_lodBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _lodBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, lods.size() * sizeof(LevelOfDetail), lods.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/**
+ * @brief Copies the textures of the bodies in the layers of a texture array
+ *        and resolves the material of each body.
+ *
+ * @param solarSys The solar system whose textures are gathered.
+ ********************************************************************************/
+void IndirectRenderer::createTextureArray(SolarSystem &solarSys)
+{
+    // Gathers the textures that were loaded (an ID of 0 is a texture that couldn't be loaded)
+    std::vector<GLuint> textures;
+    std::map<GLuint, float> layers; // Layer of each texture ID in the array
+    auto &materials = solarSys.getMaterials();
+    for (auto &material : materials)
+    {
+        for (unsigned int i = 0; i < material.nbTextures; i++)
+        {
+            GLuint textureID = material.textures[i];
+            if (textureID != 0 && layers.find(textureID) == layers.end())
+            {
+                layers[textureID] = textures.size();
+                textures.push_back(textureID);
+            }
+        }
+    }
+
+    // The layers and the lighting of each body don't change, they are only copied every frame
+    auto getLayer = [&](GLuint textureID)
+    {
+        auto it = layers.find(textureID);
+        return it == layers.end() ? -1 : it->second;
+    };
+
+    for (unsigned int i = 0; i < materials.size(); i++)
+    {
+        auto &material = materials.begin()[i];
+        Entity entity = materials.getEntity(i);
+        if (entity >= _materials.size())
+        {
+            _materials.resize(entity + 1);
+        }
+
+        // The emissive bodies (the sun) aren't lighted
+        auto shader = material.shaders[SHADING_MESH];
+        _materials[entity].isLighted = shader == nullptr || (shader->getFeatures() & SHADER_LIGHTED);
+        _materials[entity].layers.x = getLayer(material.textures[0]);
+        _materials[entity].layers.y = material.nbTextures > 1 ? getLayer(material.textures[1]) : -1;
+    }
+
+    glGenTextures(1, &_textureArray);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _textureArray);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, LAYER_WIDTH, LAYER_HEIGHT, std::max<GLsizei>(textures.size(), 1));
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // Each texture is rescaled into its layer by the GPU
+    GLuint framebuffers[2];
+    glGenFramebuffers(2, framebuffers);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+
+    for (unsigned int layer = 0; layer < textures.size(); layer++)
+    {
+        GLint width, height;
+        glBindTexture(GL_TEXTURE_2D, textures[layer]);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textures[layer], 0);
+        glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, _textureArray, 0, layer);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, LAYER_WIDTH, LAYER_HEIGHT, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(2, framebuffers);
+}
+
+/**
+ * @brief Makes sure the buffers can store the given amount of bodies.
+ *
+ * @param nbBodies Amount of bodies to store.
+ ********************************************************************************/
+void IndirectRenderer::reserve(unsigned int nbBodies)
+{
+    if (nbBodies <= _capacity)
+    {
+        return;
+    }
+
+    _capacity = std::max(nbBodies, 2 * _capacity); // Grows like a vector to avoid frequent reallocations
+
+    if (_commandBuffer == 0)
+    {
+        glGenBuffers(1, &_commandBuffer);
+        glGenBuffers(1, &_bodyIndexBuffer);
+    }
+
+    // A new buffer, the previous one is released once the GPU doesn't use it anymore
+    _bodyBuffer = std::make_unique<StreamBuffer>(GL_SHADER_STORAGE_BUFFER, _capacity * sizeof(IndirectBody));
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _commandBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, _capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // The instanced attribute starts at the baseInstance of each command, so it gives the body index
+    std::vector<GLuint> bodyIndices(_capacity);
+    for (GLuint i = 0; i < _capacity; i++)
+    {
+        bodyIndices[i] = i;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, _bodyIndexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(GLuint), bodyIndices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Unused by the other shaders of the shared geometry
+    const GLuint ATTR_BODY_INDEX = 3;
+    _geometry.setInstanceAttribute(ATTR_BODY_INDEX, _bodyIndexBuffer);
+}
+
+/**
+ * @brief Writes the data of a body to the ones sent this frame.
+ *
+ * @param material The resolved material of the planet or satellite to write.
+ * @param modelMatrix The model matrix of the planet or satellite.
+ * @param data Where to write the data (in the mapped storage buffer).
+ ********************************************************************************/
+void IndirectRenderer::writeBody(const IndirectMaterial &material, const glm::mat4 &modelMatrix, IndirectBody *data) const
+{
+    data->modelMatrix = modelMatrix;
+    data->boundingSphere = glm::vec4(0, 0, 0, 1); // The sphere meshes have a radius of 1
+    data->material = material.layers;
+}
+
+/**
+ * @brief Culls and draws the planets (and their satellites).
+ *
+ * The frame uniform buffer must already be up to date.
+ *
+ * @param solarSys The solar system to draw.
+ * @param frustum The frustum of the camera for this frame.
+ * @param viewportHeight Height of the rendered area (in pixels).
+ * @param drawSatellites If true, the satellites are also drawn.
+ ********************************************************************************/
+void IndirectRenderer::draw(SolarSystem &solarSys, const Frustum &frustum, float viewportHeight, bool drawSatellites)
+{
+    unsigned int nbBodies = drawSatellites ? solarSys.nbBodies() : solarSys.nbPlanets();
+
+    if (nbBodies == 0)
+    {
+        return;
+    }
+
+    reserve(nbBodies);
+
+    // The bodies are written in place, in the region of the buffer the GPU is done with.
+    // The emissive ones (the sun) are written from the start and the lighted ones from the end,
+    // so each group is a range of draw commands drawn with its own permutation
+    auto bodies = static_cast<IndirectBody *>(_bodyBuffer->map());
+    IndirectBody *emissiveEnd = bodies;
+    IndirectBody *lightedBegin = bodies + nbBodies;
+    auto write = [&](Entity body)
+    {
+        auto &material = _materials[body];
+        writeBody(material, solarSys.getModelMatrix(body), material.isLighted ? --lightedBegin : emissiveEnd++);
+    };
+
+    if (drawSatellites)
+    {
+        // Every body, in the order of the dense arrays
+        auto &materials = solarSys.getMaterials();
+        for (unsigned int i = 0; i < materials.size(); i++)
+        {
+            write(materials.getEntity(i));
+        }
+    }
+    else
+    {
+        for (Entity planet : solarSys)
+        {
+            write(planet);
+        }
+    }
+    _bodyBuffer->unmap();
+    unsigned int nbEmissive = emissiveEnd - bodies;
+
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, BODY_BINDING, _bodyBuffer->getGLId(), _bodyBuffer->getOffset(), nbBodies * sizeof(IndirectBody));
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BINDING, _commandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LOD_BINDING, _lodBuffer);
+
+    /*********************** CULLING *********************/
+
+    _cullingProgram.use();
+    glUniform1ui(_uBodyCount, nbBodies);
+    glUniform1ui(_uLodCount, _nbLods);
+    glUniform4fv(_uFrustumPlanes, Frustum::NB_PLANES, glm::value_ptr(frustum.getPlanes()[0]));
+    glUniform1f(_uViewportHeight, viewportHeight);
+
+    glDispatchCompute((nbBodies + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE, 1, 1);
+
+    // The commands are read by the draw call and the bodies by the vertex shader
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+    /*********************** DRAWING *********************/
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _textureArray);
+    _geometry.bind();
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandBuffer);
+
+    if (nbEmissive > 0)
+    {
+        _emissiveShader->m_Program.use();
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, nbEmissive, 0);
+    }
+    if (nbEmissive < nbBodies)
+    {
+        _lightedShader->m_Program.use();
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const GLvoid *)(nbEmissive * sizeof(DrawElementsIndirectCommand)),
+                                    nbBodies - nbEmissive, 0);
+    }
+
+    // The region of the bodies can be written again once these commands are done
+    _bodyBuffer->fence();
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
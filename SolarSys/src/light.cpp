@@ -16,7 +16,7 @@
  * @brief Constructor of the class.
  ********************************************************************************/
 Light::Light()
-    : _Kd{glm::vec3(1, 1, 1)}, _Ks{glm::vec3(1, .3, .8)}, _shininess{32}, _position{glm::vec3(0, 0, 0)}, _intensity{glm::vec3(30, 30, 30)}
+    : _Kd{glm::vec3(1, 1, 1)}, _Ks{glm::vec3(1, .3, .8)}, _shininess{32}, _position{glm::vec3(0, 0, 0)}, _intensity{glm::vec3(30, 30, 30)}, _ambient{glm::vec3(0.4, 0.4, 0.4)}
 {
 }
 
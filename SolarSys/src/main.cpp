@@ -15,11 +15,26 @@
 
 /**
  * @brief Input of the app.
+ *
+ * Without argument the simulation is interactive, the arguments of the
+ * benchmark mode are described in the benchmark module.
  ********************************************************************************/
 int main(int argc, char *argv[])
 {
-    argc++;                     // Avoid the compilation flag of warning becoming errors
-    if (render3DScene(argv[0])) // Error code received
+    std::unique_ptr<Benchmark> benchmark;
+    try
+    {
+        benchmark = Benchmark::fromArguments(argc, argv);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl
+                  << "Usage: " << argv[0] << " [--benchmark tour.txt [--frames N] [--output results.json] [--path cpu|gpu]" << std::endl
+                  << "         [--planets N [--moons N] [--rings N] [--texture-size N] [--textures N]] [--gl-capture trace.bin]]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (render3DScene(argv[0], benchmark.get()) == ERR_INT_CODE) // Error code received
     {
         return EXIT_FAILURE;
     }
@@ -15,36 +15,19 @@
 /**
  * @brief Initialize the matrices.
  *
- * @param w Width used to build the projection matrix (with perspective
- * function).
- * @param h Height used to build the projection matrix (with perspective
- * function).
  * @param rotation A rotation value to represent the rotation based on the
  * ellipse.
  * @param translation A distance on the z axis.
  * @param scale A size transformation value.
  ********************************************************************************/
-void Matrices::init(float w, float h, float rotation, float translation, float scale)
+void Matrices::init(float rotation, float translation, float scale)
 {
-    _projMatrix = glm::perspective(glm::radians(70.f), w / h, 0.1f, 100.f);
-
     // Initial position of the object after transformations
     _MVMatrix = glm::translate(glm::mat4(1), glm::vec3(0.f, 0.f, translation));
     _MVMatrix = glm::rotate(_MVMatrix, rotation, glm::vec3(1, 0, 0));
     _MVMatrix = glm::scale(_MVMatrix, glm::vec3(scale, scale, scale));
 
     _normalMatrix = glm::transpose(glm::inverse(_MVMatrix));
-    _MVPMatrix = _projMatrix * _MVMatrix;
-}
-
-/**
- * @brief Retrieves the Projection ModelView matrix.
- *
- * @return A view of the 4x4 Projection ModelView matrix.
- ********************************************************************************/
-const glm::mat4 Matrices::getMVPMatrix() const
-{
-    return _MVPMatrix;
 }
 
 /**
@@ -67,26 +50,6 @@ const glm::mat4 Matrices::getNormalMatrix() const
     return _normalMatrix;
 }
 
-/**
- * @brief Retrieves the Projection matrix.
- *
- * @return A view of the 4x4 Projection matrix.
- ********************************************************************************/
-const glm::mat4 Matrices::getProjMatrix() const
-{
-    return _projMatrix;
-}
-
-/**
- * @brief Set a new value to the Projection ModelView matrix.
- *
- * @param newMatrix A 4x4 (glm::mat4 provided by the glm library) matrix.
- ********************************************************************************/
-void Matrices::setMVPMatrix(glm::mat4 newMatrix)
-{
-    _MVPMatrix = newMatrix;
-}
-
 /**
  * @brief Set a new value to the ModelView matrix.
  *
@@ -40,6 +40,18 @@ PlanetData::PlanetData(float rotation, float diameter, float position, float orb
 {
 }
 
+/**
+ * @brief Constructor of the class from values already in the units of the scene.
+ *
+ * @param values The values, as given by `getValues()`.
+ ********************************************************************************/
+PlanetData::PlanetData(const PlanetValues &values)
+    : _position{values.position}, _largePosition{values.largePosition}, _rotationPeriod{values.rotationPeriod}, _diameter{values.diameter},
+      _orbitInclination{values.orbitInclination}, _angle{values.angle}, _revolutionPeriod{values.revolutionPeriod},
+      _hasRing{values.hasRing != 0}, _ringDist{values.ringDist}, _ringThickness{values.ringThickness}
+{
+}
+
 /**
  * @brief Retrieves the value of the planet position from the sun.
  ********************************************************************************/
@@ -52,6 +64,25 @@ float PlanetData::getPosition()
   return _position;
 }
 
+/**
+ * @brief Retrieves the values of the planet, in the units of the scene.
+ ********************************************************************************/
+PlanetValues PlanetData::getValues() const
+{
+  PlanetValues values;
+  values.position = _position;
+  values.largePosition = _largePosition;
+  values.rotationPeriod = _rotationPeriod;
+  values.diameter = _diameter;
+  values.orbitInclination = _orbitInclination;
+  values.angle = _angle;
+  values.revolutionPeriod = _revolutionPeriod;
+  values.ringDist = _ringDist;
+  values.ringThickness = _ringThickness;
+  values.hasRing = _hasRing;
+  return values;
+}
+
 /*================================== SUN DATA ====================================*/
 
 /**
@@ -217,4 +248,25 @@ NereidData::NereidData() : PlanetData(8643.264, 340, 5513400 + satelliteOffset,
 
 CharonData::CharonData() : PlanetData(153.6, 1207, 19591 + satelliteOffset, 0.080, 0, 6.4)
 {
-}
\ No newline at end of file
+}
+
+// ----------------------------------------- SNAPSHOT  -----------------------------------------
+
+/**
+ * @brief Constructor of the class.
+ *
+ * @param values The values saved from the original data.
+ ********************************************************************************/
+BakedData::BakedData(const PlanetValues &values) : PlanetData(values)
+{
+}
+
+// ----------------------------------------- STRESS SCENE  -----------------------------------------
+
+/**
+ * @brief Constructor of the class, the parameters are the ones of PlanetData.
+ ********************************************************************************/
+GeneratedData::GeneratedData(float rotation, float diameter, float position, float orbitInclination, float angle, float revPeriod, bool hasRing, float ringDist, float ringThickness)
+    : PlanetData(rotation, diameter, position, orbitInclination, angle, revPeriod, hasRing, ringDist, ringThickness)
+{
+}
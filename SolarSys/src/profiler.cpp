@@ -0,0 +1,341 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module measures the time spent in the zones  =
+=  of the code, frame by frame, and exports them as  =
+=  a trace readable by Chrome or Perfetto.           =
+=													 =
+======================================================
+*/
+
+#include "include/profiler.hpp"
+
+#include <chrono>
+
+#ifdef SOLARSYS_PROFILE
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <glimac/Json.hpp>
+
+namespace
+{
+    /**
+     * @brief A zone, or a frame marker when there is no name.
+     ********************************************************************************/
+    struct Event
+    {
+        const char *name; // nullptr for a frame marker
+        uint64_t begin;   // Time of the marker for a frame marker
+        uint64_t end;     // Index of the frame for a frame marker
+    };
+
+    /**
+     * @brief Events of a thread, only this thread writes them.
+     ********************************************************************************/
+    struct ThreadBuffer
+    {
+        std::unique_ptr<Event[]> events{new Event[Profiler::BUFFER_EVENTS]};
+        std::atomic<unsigned int> count{0};     // Events written, published to the export
+        std::atomic<std::size_t> dropped{0};    // Events which didn't fit
+        unsigned int id = 0;                    // Index of the thread in the trace
+        const char *name = nullptr;             // Name of the track, nullptr for a thread
+    };
+
+    // The buffers outlive their threads, the trace is written at the end of the run
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> registry;
+    std::atomic<uint64_t> frameIndex{0};
+
+    /**
+     * @brief Retrieves the buffer of the current thread, it is registered on the
+     *        first call.
+     ********************************************************************************/
+    ThreadBuffer &localBuffer()
+    {
+        thread_local ThreadBuffer *buffer = nullptr;
+        if (!buffer)
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            registry.push_back(std::make_unique<ThreadBuffer>());
+            buffer = registry.back().get();
+            buffer->id = registry.size();
+        }
+        return *buffer;
+    }
+
+    /**
+     * @brief Retrieves the buffer of the GPU passes, it is registered on the
+     *        first call. Only the thread owning the OpenGL context writes it.
+     ********************************************************************************/
+    ThreadBuffer &gpuBuffer()
+    {
+        static ThreadBuffer *buffer = nullptr;
+        if (!buffer)
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            registry.push_back(std::make_unique<ThreadBuffer>());
+            buffer = registry.back().get();
+            buffer->id = registry.size();
+            buffer->name = "GPU";
+        }
+        return *buffer;
+    }
+
+    /**
+     * @brief Appends an event to a buffer.
+     ********************************************************************************/
+    void record(ThreadBuffer &buffer, const Event &event)
+    {
+        unsigned int count = buffer.count.load(std::memory_order_relaxed);
+        if (count == Profiler::BUFFER_EVENTS)
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events[count] = event;
+        buffer.count.store(count + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Writes a time in microseconds, the unit of the trace.
+     ********************************************************************************/
+    void writeTime(std::ostream &out, uint64_t nanoseconds)
+    {
+        out << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+    }
+}
+
+/**
+ * @brief Tells if the zones are recorded (SOLARSYS_PROFILE).
+ ********************************************************************************/
+bool Profiler::isEnabled()
+{
+    return true;
+}
+
+/**
+ * @brief Retrieves the time elapsed since the start of the profiler.
+ *
+ * @return The time in nanoseconds.
+ ********************************************************************************/
+uint64_t Profiler::now()
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Records a zone run by the current thread.
+ *
+ * @param name Name of the zone, a string literal (only its address is kept).
+ * @param begin Time when the zone was entered (see `now()`).
+ * @param end Time when the zone was left (see `now()`).
+ ********************************************************************************/
+void Profiler::recordZone(const char *name, uint64_t begin, uint64_t end)
+{
+    record(localBuffer(), {name, begin, end});
+}
+
+/**
+ * @brief Marks the end of a frame, the markers split the trace frame by frame.
+ ********************************************************************************/
+void Profiler::endFrame()
+{
+    record(localBuffer(), {nullptr, now(), frameIndex++});
+}
+
+/**
+ * @brief Records the GPU passes of the previous frames which are finished,
+ *        then starts measuring the passes of a new frame.
+ *
+ * Must be called by the thread owning the OpenGL context.
+ *
+ * @param gpuProfiler The profiler measuring the passes.
+ ********************************************************************************/
+void Profiler::beginGpuFrame(GpuProfiler &gpuProfiler)
+{
+    while (gpuProfiler.poll())
+    {
+        auto &buffer = gpuBuffer();
+        for (auto &zone : gpuProfiler.getZones())
+        {
+            record(buffer, {zone.m_pName, zone.m_nBegin, zone.m_nEnd});
+        }
+    }
+    gpuProfiler.beginFrame(now());
+}
+
+/**
+ * @brief Ends the measure of the GPU passes of the frame.
+ *
+ * @param gpuProfiler The profiler measuring the passes.
+ ********************************************************************************/
+void Profiler::endGpuFrame(GpuProfiler &gpuProfiler)
+{
+    gpuProfiler.endFrame();
+}
+
+/**
+ * @brief Retrieves the amount of events which didn't fit in the buffers.
+ ********************************************************************************/
+std::size_t Profiler::getDroppedEvents()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::size_t dropped = 0;
+    for (auto &buffer : registry)
+    {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+/**
+ * @brief Writes the recorded events in the Trace Event format (JSON).
+ *
+ * The threads shouldn't record anything during the writing.
+ *
+ * @param file Path of the trace, its folder is created if needed.
+ *
+ * @return False if nothing is recorded or if the file can't be written.
+ ********************************************************************************/
+bool Profiler::writeTrace(const FilePath &file)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (registry.empty())
+    {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(file.dirPath().str(), error);
+    std::ofstream out(file.str());
+    if (!out)
+    {
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (auto &buffer : registry)
+    {
+        out << (first ? "\n" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+            << ",\"args\":{\"name\":";
+        if (buffer->name)
+        {
+            writeJsonString(out, buffer->name);
+        }
+        else
+        {
+            out << "\"Thread " << buffer->id << '"';
+        }
+        out << "}}";
+        first = false;
+
+        unsigned int count = buffer->count.load(std::memory_order_acquire);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            const Event &event = buffer->events[i];
+            if (event.name)
+            {
+                // Complete event, its nesting comes from the times
+                out << ",\n{\"name\":";
+                writeJsonString(out, event.name);
+                out << ",\"ph\":\"X\",\"ts\":";
+                writeTime(out, event.begin);
+                out << ",\"dur\":";
+                writeTime(out, event.end - event.begin);
+            }
+            else
+            {
+                // Instant event across the whole trace
+                out << ",\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":";
+                writeTime(out, event.begin);
+                out << ",\"args\":{\"frame\":" << event.end << "}";
+            }
+            out << ",\"pid\":1,\"tid\":" << buffer->id << "}";
+        }
+    }
+    out << "\n]}" << std::endl;
+
+    return static_cast<bool>(out);
+}
+
+#else
+
+/**
+ * @brief Tells if the zones are recorded (SOLARSYS_PROFILE).
+ ********************************************************************************/
+bool Profiler::isEnabled()
+{
+    return false;
+}
+
+/**
+ * @brief Retrieves the time elapsed since the start of the profiler.
+ *
+ * @return The time in nanoseconds.
+ ********************************************************************************/
+uint64_t Profiler::now()
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Records a zone, nothing is recorded.
+ ********************************************************************************/
+void Profiler::recordZone([[maybe_unused]] const char *name, [[maybe_unused]] uint64_t begin, [[maybe_unused]] uint64_t end)
+{
+}
+
+/**
+ * @brief Marks the end of a frame, nothing is recorded.
+ ********************************************************************************/
+void Profiler::endFrame()
+{
+}
+
+/**
+ * @brief Starts a frame of GPU passes, nothing is measured.
+ ********************************************************************************/
+void Profiler::beginGpuFrame([[maybe_unused]] GpuProfiler &gpuProfiler)
+{
+}
+
+/**
+ * @brief Ends a frame of GPU passes, nothing is measured.
+ ********************************************************************************/
+void Profiler::endGpuFrame([[maybe_unused]] GpuProfiler &gpuProfiler)
+{
+}
+
+/**
+ * @brief Retrieves the amount of events which didn't fit in the buffers,
+ *        nothing is recorded.
+ ********************************************************************************/
+std::size_t Profiler::getDroppedEvents()
+{
+    return 0;
+}
+
+/**
+ * @brief Writes the recorded events, nothing is recorded.
+ *
+ * @return Always false.
+ ********************************************************************************/
+bool Profiler::writeTrace([[maybe_unused]] const FilePath &file)
+{
+    return false;
+}
+
+#endif
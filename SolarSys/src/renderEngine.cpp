@@ -12,6 +12,190 @@
 
 #include "include/renderEngine.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <glimac/Extensions.hpp>
+
+#include "include/profiler.hpp"
+
+/**
+ * @brief Constructor of the class.
+ *
+ * Creates the uniform buffers shared by all the shaders, an OpenGL context
+ * must be current.
+ ********************************************************************************/
+RenderEngine::RenderEngine()
+    : _frameUniforms{}, _materialUniforms{}, _geometry{}
+{
+    glGenVertexArrays(1, &_emptyVAO);
+    _newGpuFrameTimes.reserve(GpuTimer::DEFAULT_QUERY_COUNT); // At most a time per query, the frames don't allocate
+
+    // Reversed depth: the closest fragments have the greatest depth, the background is at 0
+    glClearDepth(0);
+    glDepthFunc(GL_GREATER);
+
+    // Without clip control, the depth is remapped from [-1, 1] and only half of the range is used
+    if (hasClipControl())
+    {
+        clipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE);
+    }
+}
+
+/**
+ * @brief Destructor of the class.
+ ********************************************************************************/
+RenderEngine::~RenderEngine()
+{
+    glDeleteVertexArrays(1, &_emptyVAO);
+}
+
+/**
+ * @brief Builds the projection matrix shared by all the objects of the scene.
+ *
+ * The projection has no far plane and reverses the depth (1 on the near plane
+ * and 0 at infinity), with the floating point depth of the scene framebuffer
+ * the precision stays the same from the close-ups to the farthest planets.
+ * The scene framebuffer is resized to the rendered area.
+ *
+ * @param w Width of the rendered area.
+ * @param h Height of the rendered area.
+ ********************************************************************************/
+void RenderEngine::configureProjection(float w, float h)
+{
+    float focal = 1 / std::tan(glm::radians(FIELD_OF_VIEW) / 2);
+
+    // The clip depth is the near distance and w the distance to the camera, so the depth is near / distance
+    _projMatrix = glm::mat4(0);
+    _projMatrix[0][0] = focal * h / w;
+    _projMatrix[1][1] = focal;
+    _projMatrix[2][3] = -1;
+    _projMatrix[3][2] = NEAR_PLANE;
+
+    _windowWidth = w;
+    _windowHeight = h;
+    _viewportHeight = h;
+    _sceneTarget.resize(w, h);
+}
+
+/**
+ * @brief Starts the rendering of a frame in the scene framebuffer and clears it.
+ *
+ * The resolution of the frame is adapted to the GPU time of the previous ones
+ * (see the dynamicResolution module).
+ ********************************************************************************/
+void RenderEngine::startFrame()
+{
+    // The times arrive a few frames late, each one with the scale its frame was rendered with
+    _newGpuFrameTimes.clear();
+    while (_frameTimer.poll())
+    {
+        _resolution.update(_frameTimer.getLastTime(), _measuredScales[_firstMeasuredScale]);
+        _firstMeasuredScale = (_firstMeasuredScale + 1) % _measuredScales.size();
+        _nbMeasuredScales--;
+        _newGpuFrameTimes.push_back(_frameTimer.getLastTime());
+    }
+
+    // Only a part of the framebuffer is used, the aspect ratio and so the projection don't change
+    float scale = _resolution.getScale();
+    _sceneTarget.setActiveArea(std::lround(_windowWidth * scale), std::lround(_windowHeight * scale));
+    _viewportHeight = _sceneTarget.getActiveHeight(); // The sizes on screen (LOD...) are in rendered pixels
+
+    if (_frameTimer.begin())
+    {
+        _measuredScales[(_firstMeasuredScale + _nbMeasuredScales) % _measuredScales.size()] = scale;
+        _nbMeasuredScales++;
+    }
+    Profiler::beginGpuFrame(_gpuProfiler);
+    _sceneTarget.bind();
+    clearDisplay();
+}
+
+/**
+ * @brief Copies the rendered frame to the window, stretched if it was rendered
+ *        with a lower resolution.
+ *
+ * It must be called before swapping the buffers of the window.
+ ********************************************************************************/
+void RenderEngine::endFrame()
+{
+    {
+        PROFILE_GPU_ZONE(_gpuProfiler, "Post-process");
+        _sceneTarget.blitToScreen(_windowWidth, _windowHeight);
+    }
+    Profiler::endGpuFrame(_gpuProfiler);
+    _frameTimer.end();
+}
+
+/**
+ * @brief Sets the GPU time allowed for a frame.
+ *
+ * @param budget Frame time budget (in ms), 0 to always render at the resolution
+ *               of the window.
+ ********************************************************************************/
+void RenderEngine::setFrameBudget(float budget)
+{
+    _resolution.setBudget(budget);
+}
+
+/**
+ * @brief Retrieves the scale of the window resolution used by the frames.
+ ********************************************************************************/
+float RenderEngine::getResolutionScale() const
+{
+    return _resolution.getScale();
+}
+
+/**
+ * @brief Retrieves the GPU times of the previous frames read by `startFrame()`,
+ *        they are a few frames late and several can arrive together.
+ *
+ * @return The times in ms, oldest first, none if no result was ready.
+ ********************************************************************************/
+const std::vector<double> &RenderEngine::getNewGpuFrameTimes() const
+{
+    return _newGpuFrameTimes;
+}
+
+/**
+ * @brief Retrieves the length on screen (in pixels) of one unit seen from a
+ *        distance of one unit, divide it by the distance of an object.
+ ********************************************************************************/
+float RenderEngine::getPixelScale() const
+{
+    return _projMatrix[1][1] * _viewportHeight / 2;
+}
+
+/**
+ * @brief Sends the data that stays the same during the whole frame.
+ *
+ * The camera view, the projection, the light and the material coefficients are
+ * sent once in uniform buffers, every shader then reads them from there.
+ * The frustum used to skip the hidden objects is also updated.
+ * It must be called once per frame, before any drawing.
+ *
+ * @param camera The camera the scene is seen from.
+ * @param light The light source of the scene.
+ ********************************************************************************/
+void RenderEngine::updateFrameUniforms(const Camera &camera, const Light &light)
+{
+    auto viewMatrix = camera.getViewMatrix();
+    _frustum = Frustum(_projMatrix * viewMatrix);
+
+    FrameUniforms frame;
+    frame.viewMatrix = viewMatrix;
+    frame.projMatrix = _projMatrix;
+    frame.lightPosition = viewMatrix * glm::vec4(light._position, 1); // The homogeneous coordinate must be 1
+    frame.lightIntensity = glm::vec4(light._intensity, 0);
+    frame.ambientLight = glm::vec4(light._ambient, 0);
+    _frameUniforms.update(frame);
+
+    MaterialUniforms material;
+    material.Kd = glm::vec4(light._Kd, 0);
+    material.Ks = glm::vec4(light._Ks, light._shininess);
+    _materialUniforms.update(material);
+}
+
 /**
  * @brief Clears the display of the scene.   (CLEAR THE SCENE RATHER... MIGHT BE SMART TO RENAME IT clearScene)
  *
@@ -44,116 +228,62 @@ void RenderEngine::disableZBuffer()
 }
 
 /**
- * @brief Create a Sphere object, fill the vao and vbo with
- * its data.
- *
- * It configures the depth of the scene in OpenGL
+ * @brief Create a Sphere object and add it to the shared geometry.
  ********************************************************************************/
 void RenderEngine::createSphere()
 {
+    PROFILE_ZONE("Mesh build");
     auto sphere = Sphere(1, 32, 16);
-    _nbVertices = sphere.getVertexCount();
-    auto ptrVertices = sphere.getDataPointer();
-
-    // Generates VBO buffer and binds it
-    glGenBuffers(1, &_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-
-    glBufferData(GL_ARRAY_BUFFER, _nbVertices * sizeof(ShapeVertex), ptrVertices, GL_STATIC_DRAW);
-    // Unbind because we need a static draw (we won't modify the data in the buffer in the future)
-    glBindBuffer(GL_ARRAY_BUFFER, 0); // Unbind thanks to the Buffer ID 0
-
-    // VAO generation
-    glGenVertexArrays(1, &_vao);
-    glBindVertexArray(_vao);
-
-    // Vertex Attributes
-    const GLuint ATTR_POSITION = 0;
-    const GLuint ATTR_NORMAL = 1;
-    const GLuint ATTR_TEXTURE = 2;
 
-    glEnableVertexAttribArray(ATTR_POSITION);
-    glEnableVertexAttribArray(ATTR_NORMAL);
-    glEnableVertexAttribArray(ATTR_TEXTURE);
-
-    // Set the information for GPU on how to read the vertex array
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    glVertexAttribPointer(ATTR_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const GLvoid *)offsetof(ShapeVertex, position)); // Positions
-    glVertexAttribPointer(ATTR_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const GLvoid *)offsetof(ShapeVertex, normal));     // Normals
-    glVertexAttribPointer(ATTR_TEXTURE, 2, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const GLvoid *)offsetof(ShapeVertex, texCoords)); // Textures coords
-    glBindBuffer(GL_ARRAY_BUFFER, 0);                                                                                                  // Unbind thanks to the Buffer ID 0
-
-    // Unbind the VAO
-    glBindVertexArray(0);
+    // Stored in the shared geometry, the shared vertices are indexed
+    _sphereMesh = _geometry.add(sphere.getIndexedDataPointer(), sphere.getIndexedVertexCount(), sphere.getIndexPointer(), sphere.getIndexCount());
 }
 
 /**
- * @brief Create a Torus object, fill the vao and vbo with
- * its data.
+ * @brief Adds prebuilt meshes to the shared geometry, in place of
+ *        `createSphere()` and `integrateSkybox()`.
  *
- * It configures the depth of the scene in OpenGL
- * @param innerEdgeDist The distance from the center of the inner edge of the torus
- * @param thickness The diameter of the torus pipe
+ * The vertices and the indices are the content of the shared geometry read
+ * back from a scene snapshot (see the sceneSnapshot module), copied with a
+ * single upload.
+ *
+ * @param vertices The vertices, in the format of the shared geometry.
+ * @param nbVertices Amount of vertices.
+ * @param indices The indices of the meshes.
+ * @param nbIndices Amount of indices.
+ * @param sphereMesh Range of the sphere in the given data.
+ * @param skyboxMesh Range of the cube of the skybox in the given data.
  ********************************************************************************/
-void RenderEngine::createTorus(GLfloat innerEdgeDist, GLfloat thickness)
+void RenderEngine::integrateMeshes(const PackedVertex *vertices, GLsizei nbVertices, const uint32_t *indices, GLsizei nbIndices,
+                                   const ArenaMesh &sphereMesh, const ArenaMesh &skyboxMesh)
 {
-    auto radius = innerEdgeDist + thickness;
-    auto pipeRadius = thickness;
-    auto torus = Torus(radius, pipeRadius, 64, 16);
-    _nbVerticesTorus = torus.getVertexCount();
-    auto ptrVertices = torus.getDataPointer();
-
-    GLuint vboTorus;
-    GLuint vaoTorus;
-
-    // Generates VBO buffer and binds it
-    glGenBuffers(1, &vboTorus);
-    glBindBuffer(GL_ARRAY_BUFFER, vboTorus);
-
-    glBufferData(GL_ARRAY_BUFFER, _nbVerticesTorus * sizeof(ShapeVertex), ptrVertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0); // Unbinding vbo
-
-    // VAO generation
-    glGenVertexArrays(1, &vaoTorus);
-    glBindVertexArray(vaoTorus);
-
-    // Vertex Attributes
-    const GLuint ATTR_POSITION = 0;
-    const GLuint ATTR_NORMAL = 1;
-    const GLuint ATTR_TEXTURE = 2;
-
-    glEnableVertexAttribArray(ATTR_POSITION);
-    glEnableVertexAttribArray(ATTR_NORMAL);
-    glEnableVertexAttribArray(ATTR_TEXTURE);
-
-    // Set the information for GPU on how to read the vertex array
-    glBindBuffer(GL_ARRAY_BUFFER, vboTorus);
-    glVertexAttribPointer(ATTR_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const GLvoid *)offsetof(ShapeVertex, position)); // Positions
-    glVertexAttribPointer(ATTR_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const GLvoid *)offsetof(ShapeVertex, normal));     // Normals
-    glVertexAttribPointer(ATTR_TEXTURE, 2, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const GLvoid *)offsetof(ShapeVertex, texCoords)); // Textures coords
-    glBindBuffer(GL_ARRAY_BUFFER, 0);                                                                                                  // Unbind thanks to the Buffer ID 0
-
-    // Unbind the VAO
-    glBindVertexArray(0);
-
-    _vaoTorus.emplace_back(vaoTorus);
-    _vboTorus.emplace_back(vboTorus);
+    PROFILE_ZONE("Mesh upload");
+    ArenaMesh content = _geometry.add(vertices, nbVertices, indices, nbIndices);
+
+    // The ranges were saved from an empty geometry, they move with the data
+    _sphereMesh = sphereMesh;
+    _sphereMesh.m_nFirstIndex += content.m_nFirstIndex;
+    _sphereMesh.m_nBaseVertex += content.m_nBaseVertex;
+    _skyboxMesh = skyboxMesh;
+    _skyboxMesh.m_nFirstIndex += content.m_nFirstIndex;
+    _skyboxMesh.m_nBaseVertex += content.m_nBaseVertex;
 }
 
-void RenderEngine::createPlanetRing(PlanetObject &planet)
+/**
+ * @brief Retrieves the shared geometry and the ranges of the sphere and of
+ *        the cube of the skybox in it.
+ ********************************************************************************/
+const GeometryArena &RenderEngine::getGeometry() const
 {
-    if (planet.hasRing())
-    {
-        auto data = planet.getPlanetData();
-        auto ringDistance = data._ringDist;
-        auto ringThickness = data._ringThickness;
-        createTorus(ringDistance, ringThickness);
-        planet.setRingID(_vaoTorus.size() - 1);
-    }
-    else
-    {
-        planet.setRingID(-1);
-    }
+    return _geometry;
+}
+const ArenaMesh &RenderEngine::getSphereMesh() const
+{
+    return _sphereMesh;
+}
+const ArenaMesh &RenderEngine::getSkyboxMesh() const
+{
+    return _skyboxMesh;
 }
 
 /**
@@ -163,173 +293,249 @@ void RenderEngine::createPlanetRing(PlanetObject &planet)
  ********************************************************************************/
 GLuint RenderEngine::createTexture(const char *path)
 {
-    auto ptrText = loadImgFromPath(path);
+    std::unique_ptr<Image> ptrText;
+    {
+        PROFILE_ZONE("Texture decode");
+        ptrText = loadImgFromPath(path);
+    }
     if (ptrText == NULL)
     {
         return ERR_INT_CODE;
     }
+
+    PROFILE_ZONE("Texture upload");
     return loadTexture(std::move(ptrText));
 }
 
 /**
  * @brief Configures the environment to allow the rendering.
  *
- * Bind the textures of the planet object and the VAO.
+ * Bind the textures of a body and the VAO of the shared geometry.
  *
- * @param planet A PlanetObject (defined in the planetObject module) we want
- *               to configure the drawing environment for.
+ * @param material The material (defined in the components module) of the
+ *                 body we want to configure the drawing environment for.
  ********************************************************************************/
-void RenderEngine::start(const PlanetObject &planet)
+void RenderEngine::start(const MaterialComponent &material)
 {
 
     // Bind the texture
-    auto planetTexts = planet.getTextIDs();
-    int i = 0;
-    for (auto it = planetTexts.begin(); it != planetTexts.end(); it++)
+    for (unsigned int i = 0; i < material.nbTextures; i++)
     {
         glActiveTexture(GL_TEXTURE0 + i);
-        glBindTexture(GL_TEXTURE_2D, *it); // Earth texture binded to #0
-        i++;
+        glBindTexture(GL_TEXTURE_2D, material.textures[i]); // Earth texture binded to #0
     }
 
-    // Bind the VAO to draw its data
-    glBindVertexArray(_vao);
+    // Every mesh is in the same VAO, the draws following this call use it (the packet loop of
+    // `drawBodies()` only binds it again after an impostor or a point)
+    _geometry.bind();
 }
 
 /**
- * @brief Launches the rendering of the given planet.
+ * @brief Selects the way of drawing a planet from its radius on screen.
  *
- * @param planet A PlanetObject (defined in the planetObject module) we want
- *               to draw.
+ * Under `IMPOSTOR_PIXEL_RADIUS` (or when forced with `MaterialComponent::alwaysImpostor`)
+ * the planet is ray-cast, under `LOW_DETAIL_PIXEL_RADIUS` its textures are reduced
+ * to their average color and under `POINT_PIXEL_RADIUS` it is a single point.
+ * The mesh is used when the camera is inside the planet, a level without shader
+ * falls back to the more detailed ones.
+ *
+ * @param material The material of the planet to draw.
+ * @param radius Radius of the planet.
+ * @param centerVC Center of the planet in view coordinates.
+ *
+ * @return The shading level of the planet.
  ********************************************************************************/
-void RenderEngine::draw(PlanetObject &planet, Camera &camera, const Light &light)
+ShadingLevel RenderEngine::selectShadingLevel(const MaterialComponent &material, float radius, const glm::vec3 &centerVC) const
 {
-    start(planet);
-    auto planetShader = planet.getShaderManager().get();
-    auto &planetProgram = planetShader->m_Program; // Use of reference to not call the copy constructor of Program (which is private)
-
-    planetProgram.use();
-
-    auto transfos = planet.getMatrices();
-    // auto MVPMatrix = transfos.getMVPMatrix();
-    auto viewMatrix = camera.getViewMatrix();
-    auto normalMatrix = transfos.getNormalMatrix();
-    auto projMatrix = transfos.getProjMatrix();
-    auto MVMatrix = viewMatrix * transfos.getMVMatrix();
-    auto MVPMatrix = projMatrix * MVMatrix;
+    float distance = glm::length(centerVC);
 
-    normalMatrix = glm::transpose(glm::inverse(MVMatrix));
-
-    // Send matrices
-    glUniformMatrix4fv(planetShader->uMVPMatrix, 1, GL_FALSE, glm::value_ptr(MVPMatrix));
-    glUniformMatrix4fv(planetShader->uMVMatrix, 1, GL_FALSE, glm::value_ptr(MVMatrix));
-    glUniformMatrix4fv(planetShader->uNormalMatrix, 1, GL_FALSE, glm::value_ptr(normalMatrix));
-
-    // Send Material Information
-    glUniform3fv(planetShader->uKd, 1, glm::value_ptr(light._Kd));
-    glUniform3fv(planetShader->uKs, 1, glm::value_ptr(light._Ks));
-    glUniform1f(planetShader->uShininess, light._shininess);
-
-    // Send Light Information
-    glm::vec3 lightPos = glm::vec3(viewMatrix * glm::vec4(light._position, 1)); // The homogeneous coordinate must be 1
-    glm::vec3 ambientLight = glm::vec3(0.4, 0.4, 0.4);                          // The homogeneous coordinate must be 1
-    glUniform3fv(planetShader->uLightPosition, 1, glm::value_ptr(lightPos));
-    glUniform3fv(planetShader->uLightIntensity, 1, glm::value_ptr(light._intensity));
-    glUniform1i(planetShader->uIsLighted, true);
-    glUniform3fv(planetShader->uAmbientLight, 1, glm::value_ptr(ambientLight));
-
-    // //Send the textures
-    int i = 0;
-    auto planetTexts = planet.getTextIDs();
-
-    for (auto it = planetTexts.begin(); it != planetTexts.end(); it++)
+    // The quad can't cover the sphere when the camera is inside (or almost touching) it
+    if (distance < radius * 1.01f)
     {
-        glUniform1i(planetShader->uTextures[i], i);
-        i++;
+        return SHADING_MESH;
     }
 
-    // Draw the vertices
-    glDrawArrays(GL_TRIANGLES, 0, _nbVertices);
+    float pixelRadius = radius * getPixelScale() / distance;
 
-    if (planet.hasRing())
+    ShadingLevel level = SHADING_MESH;
+    if (pixelRadius < POINT_PIXEL_RADIUS)
     {
+        level = SHADING_POINT;
+    }
+    else if (pixelRadius < LOW_DETAIL_PIXEL_RADIUS)
+    {
+        level = SHADING_LOW_DETAIL;
+    }
+    else if (pixelRadius < IMPOSTOR_PIXEL_RADIUS || material.alwaysImpostor)
+    {
+        level = SHADING_IMPOSTOR;
+    }
 
-        auto ringShader = planet.getRingShaderManager().get();
-        auto &ringProgram = ringShader->m_Program;
-
-        ringProgram.use();
-
-        // Draw torus
-        startRing(planet);
-
-        planet.updateMatricesTorus(); // Update the matrices for the torus
-
-        auto transfos = planet.getMatrices();
-        auto viewMatrix = camera.getViewMatrix();
-        auto normalMatrix = transfos.getNormalMatrix();
-        auto projMatrix = transfos.getProjMatrix();
-        auto MVMatrix = viewMatrix * transfos.getMVMatrix();
-        auto MVPMatrix = projMatrix * MVMatrix;
+    while (level != SHADING_MESH && !material.shaders[level])
+    {
+        level = static_cast<ShadingLevel>(level - 1);
+    }
+    return level;
+}
 
-        // Send matrices
-        glUniformMatrix4fv(ringShader->uMVPMatrix, 1, GL_FALSE, glm::value_ptr(MVPMatrix));
-        glUniformMatrix4fv(ringShader->uMVMatrix, 1, GL_FALSE, glm::value_ptr(MVMatrix));
-        glUniformMatrix4fv(ringShader->uNormalMatrix, 1, GL_FALSE, glm::value_ptr(normalMatrix));
+/**
+ * @brief Adds a body to the draw list of the frame if it is in the frustum
+ *        of the camera.
+ *
+ * @param packets The draw list of the frame.
+ * @param solarSys The solar system storing the body.
+ * @param body The planet or satellite.
+ * @param viewMatrix The view matrix of the camera.
+ ********************************************************************************/
+void RenderEngine::addDrawPacket(FrameVector<DrawPacket> &packets, SolarSystem &solarSys, Entity body, const glm::mat4 &viewMatrix) const
+{
+    auto &modelMatrix = solarSys.getModelMatrix(body);
+    glm::vec3 center = modelMatrix[3];
+    float radius = solarSys.getSize(body);
 
-        // Send Material Information
-        glUniform3fv(ringShader->uKd, 1, glm::value_ptr(light._Kd));
-        glUniform3fv(ringShader->uKs, 1, glm::value_ptr(light._Ks));
-        glUniform1f(ringShader->uShininess, light._shininess);
+    // The sphere has a radius of 1 before being scaled by the size of the body
+    if (!_frustum.intersectsSphere(center, radius))
+    {
+        return;
+    }
 
-        // Send Light Information
-        glUniform3fv(ringShader->uLightPosition, 1, glm::value_ptr(lightPos));
-        glUniform3fv(ringShader->uLightIntensity, 1, glm::value_ptr(light._intensity));
-        glUniform1i(ringShader->uIsLighted, true);
-        glUniform3fv(ringShader->uAmbientLight, 1, glm::value_ptr(ambientLight));
+    auto &material = solarSys.getMaterials()[body];
+    DrawPacket packet;
+    packet.material = &material;
+    packet.MVMatrix = viewMatrix * modelMatrix;
+    packet.level = selectShadingLevel(material, radius, packet.MVMatrix[3]);
+    packet.shader = material.shaders[packet.level];
+    packets.push_back(packet);
+}
 
-        // //Send the textures
-        int i = 0;
-        auto ringTexts = planet.getRingTextIDs();
+/**
+ * @brief Draws the bodies of the solar system one by one, then their rings.
+ *
+ * The bodies outside of the frustum of the camera are skipped, the others
+ * are drawn at the shading level matching their size on screen (see
+ * `selectShadingLevel()`): the smaller they are, the cheaper their fragments
+ * are. The satellites are only drawn in the focused mode.
+ *
+ * The visible bodies are gathered in a list of the frame arena (glimac
+ * FrameArena) and sorted by shader and textures, so each program and each
+ * texture is bound once per frame.
+ *
+ * @param solarSys The solar system to draw.
+ * @param camera The camera the scene is seen from.
+ ********************************************************************************/
+void RenderEngine::drawBodies(SolarSystem &solarSys, Camera &camera)
+{
+    auto viewMatrix = camera.getViewMatrix();
 
-        for (auto it = ringTexts.begin(); it != ringTexts.end(); it++)
+    // Released all at once at the end of the frame, the list never reaches the heap
+    FrameVector<DrawPacket> packets;
+    packets.reserve(solarSys.nbBodies());
+    {
+        PROFILE_ZONE("Culling");
+        for (Entity planet : solarSys)
         {
-            glUniform1i(ringShader->uTextures[i], i);
-            i++;
+            addDrawPacket(packets, solarSys, planet, viewMatrix);
+
+            if (camera.isFocusedPov()) // We draw the satellites only in the focused mode
+            {
+                for (Entity satellite : solarSys.getSatellites(planet))
+                {
+                    addDrawPacket(packets, solarSys, satellite, viewMatrix);
+                }
+            }
         }
-
-        // Draw the vertices
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, _nbVerticesTorus);
-
-        endRing(planet);
     }
 
-    end(planet);
-
-    if (camera.isFocusedPov()) // We draw the satellites only in the focused mode
+    PROFILE_ZONE("Submission");
     {
-        for (auto &satellite : planet.getSatellites())
+        PROFILE_GPU_ZONE(_gpuProfiler, "Bodies");
+
+        // The bodies are opaque, their order only decides how often the states change
+        std::sort(packets.begin(), packets.end(), [](const DrawPacket &lhs, const DrawPacket &rhs)
+                  {
+                      if (lhs.shader != rhs.shader)
+                      {
+                          return std::less<ShaderBody *>()(lhs.shader, rhs.shader);
+                      }
+                      return lhs.material->textures[0] < rhs.material->textures[0];
+                  });
+
+        const ShaderBody *currentShader = nullptr;
+        const MaterialComponent *currentMaterial = nullptr;
+        GLuint currentVAO = 0; // The impostors and the points bind the empty VAO, the meshes the shared geometry
+        for (auto &packet : packets)
+        {
+            if (packet.shader != currentShader)
+            {
+                packet.shader->m_Program.use();
+                currentShader = packet.shader;
+            }
+            if (!currentMaterial || currentMaterial->nbTextures != packet.material->nbTextures ||
+                !std::equal(currentMaterial->textures, currentMaterial->textures + currentMaterial->nbTextures, packet.material->textures))
+            {
+                start(*packet.material);
+                currentMaterial = packet.material;
+                currentVAO = _geometry.getVertexArray();
+            }
+
+            // Only the object matrices are sent, the projection, the light and the material are in the uniform buffers
+            glUniformMatrix4fv(packet.shader->uMVMatrix, 1, GL_FALSE, glm::value_ptr(packet.MVMatrix));
+
+            // The VAO only changes between a mesh and an impostor or a point
+            GLuint vertexArray = packet.level == SHADING_MESH ? _geometry.getVertexArray() : _emptyVAO;
+            if (vertexArray != currentVAO)
+            {
+                glBindVertexArray(vertexArray);
+                currentVAO = vertexArray;
+            }
+
+            if (packet.level == SHADING_POINT)
+            {
+                // The point is placed from the matrix alone, no vertex is read
+                glDrawArrays(GL_POINTS, 0, 1);
+            }
+            else if (packet.level != SHADING_MESH)
+            {
+                // The quad is built from gl_VertexID, no vertex is read
+                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            }
+            else
+            {
+                auto normalMatrix = glm::transpose(glm::inverse(packet.MVMatrix));
+                glUniformMatrix4fv(packet.shader->uNormalMatrix, 1, GL_FALSE, glm::value_ptr(normalMatrix));
+
+                // Draw the vertices
+                _geometry.draw(_sphereMesh);
+            }
+        }
+        if (currentMaterial)
         {
-            draw(satellite, camera, light);
+            end(*currentMaterial);
         }
     }
+
+    // Only the planets with a ring are visited
+    PROFILE_GPU_ZONE(_gpuProfiler, "Rings");
+    auto &rings = solarSys.getRings();
+    for (unsigned int i = 0; i < rings.size(); i++)
+    {
+        drawRing(solarSys, rings.getEntity(i), camera);
+    }
 }
 
 /**
  * @brief Put an end to the current rendering environment.
  *
- * @param planet A PlanetObject (defined in the planetObject module) we want
- *               to put an end to the drawing environment for.
+ * @param material The material (defined in the components module) of the
+ *                 body we want to put an end to the drawing environment for.
  ********************************************************************************/
-void RenderEngine::end(const PlanetObject &planet)
+void RenderEngine::end(const MaterialComponent &material)
 {
-    // Unbind textures
-    for (unsigned int i = 0; i < planet.getTextIDs().size(); i++)
+    // Unbind textures (the VAO of the shared geometry stays bound for the next meshes)
+    for (unsigned int i = 0; i < material.nbTextures; i++)
     {
         glBindTexture(GL_TEXTURE_2D, 0);
     }
-
-    // Unbind the VAO
-    glBindVertexArray(0);
 }
 
 /* ========================================================================================================== */
@@ -344,58 +550,14 @@ void RenderEngine::end(const PlanetObject &planet)
  ********************************************************************************/
 void RenderEngine::integrateSkybox(const Skybox &skybox)
 {
-    _nbVerticesSkybox = skybox.nbVertices();
-    auto ptrVertices = skybox.data();
-
-    // Generates VBO buffer and binds it
-    glGenBuffers(1, &_vboSkybox);
-    glBindBuffer(GL_ARRAY_BUFFER, _vboSkybox);
-
-    glBufferData(GL_ARRAY_BUFFER, _nbVerticesSkybox * sizeof(ShapeVertex), ptrVertices, GL_STATIC_DRAW);
-    // Unbind because we need a static draw (we won't modify the data in the buffer in the future)
-    glBindBuffer(GL_ARRAY_BUFFER, 0); // Unbind thanks to the Buffer ID 0
-
-    /*********************** IBO *********************/
-
-    glGenBuffers(1, &_ibo);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, skybox.nbIndexes() * sizeof(uint32_t), skybox.getIndexes(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-    /*********************** VAO *********************/
-
-    // VAO generation
-    glGenVertexArrays(1, &_vaoSkybox);
-    glBindVertexArray(_vaoSkybox);
-
-    // Bind the VBO to the current VAO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ibo);
-
-    // Vertex Attributes
-    const GLuint ATTR_POSITION = 0;
-    const GLuint ATTR_NORMAL = 1;
-    const GLuint ATTR_TEXTURE = 2;
-
-    glEnableVertexAttribArray(ATTR_POSITION);
-    glEnableVertexAttribArray(ATTR_NORMAL);
-    glEnableVertexAttribArray(ATTR_TEXTURE);
-
-    // Set the information for GPU on how to read the vertex array
-    glBindBuffer(GL_ARRAY_BUFFER, _vboSkybox);
-    glVertexAttribPointer(ATTR_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const GLvoid *)offsetof(ShapeVertex, position)); // Positions
-    glVertexAttribPointer(ATTR_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const GLvoid *)offsetof(ShapeVertex, normal));     // Normals
-    glVertexAttribPointer(ATTR_TEXTURE, 2, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const GLvoid *)offsetof(ShapeVertex, texCoords)); // Textures coords
-    glBindBuffer(GL_ARRAY_BUFFER, 0);                                                                                                  // Unbind thanks to the Buffer ID 0
-
-    // Unbind the VAO
-    glBindVertexArray(0);
+    PROFILE_ZONE("Mesh build");
+    _skyboxMesh = _geometry.add(skybox.data(), skybox.nbVertices(), skybox.getIndexes(), skybox.nbIndexes());
 }
 
 /**
  * @brief Configures the environment to allow the rendering.
  *
- * Bind the textures of the skybox object and the VAO.
+ * Bind the textures of the skybox object and the VAO of the shared geometry.
  *
  * @param skybox A Skybox (see the skybox module) we want
  *               to configure the drawing environment for.
@@ -403,7 +565,7 @@ void RenderEngine::integrateSkybox(const Skybox &skybox)
 void RenderEngine::start(const Skybox &skybox)
 {
     // Bind the texture
-    auto skyboxTexts = skybox.getTextIDs();
+    auto &skyboxTexts = skybox.getTextIDs(); // A reference, the vector isn't copied every frame
     int i = 0;
     for (auto it = skyboxTexts.begin(); it != skyboxTexts.end(); it++)
     {
@@ -412,8 +574,9 @@ void RenderEngine::start(const Skybox &skybox)
         i++;
     }
 
-    // Bind the VAO to draw its data
-    glBindVertexArray(_vaoSkybox);
+    // Every mesh is in the same VAO, the draws following this call use it (the packet loop of
+    // `drawBodies()` only binds it again after an impostor or a point)
+    _geometry.bind();
 }
 
 /**
@@ -424,34 +587,20 @@ void RenderEngine::start(const Skybox &skybox)
  ********************************************************************************/
 void RenderEngine::draw(Skybox &skybox)
 {
+    PROFILE_GPU_ZONE(_gpuProfiler, "Skybox");
     auto skyboxShader = skybox.getShaderManager().get();
     auto &skyboxProgram = skyboxShader->m_Program; // Use of reference to not call the copy constructor of Program (which is private)
 
     skyboxProgram.use();
 
-    auto transfos = skybox.getMatrices();
-    auto MVPMatrix = transfos.getMVPMatrix();
-    auto MVMatrix = transfos.getMVMatrix();
-    auto normalMatrix = transfos.getNormalMatrix();
+    // The skybox doesn't follow the camera view, its ModelView matrix is used as is
+    auto &transfos = skybox.getMatrices();
 
     // Send matrices
-    glUniformMatrix4fv(skyboxShader->uMVPMatrix, 1, GL_FALSE, glm::value_ptr(MVPMatrix));
-    glUniformMatrix4fv(skyboxShader->uMVMatrix, 1, GL_FALSE, glm::value_ptr(MVMatrix));
-    glUniformMatrix4fv(skyboxShader->uNormalMatrix, 1, GL_FALSE, glm::value_ptr(normalMatrix));
-
-    glUniform1i(skyboxShader->uIsLighted, false); // We don't want the cube to be lighted
-
-    // //Send the textures
-    int i = 0;
-    auto skyboxTexts = skybox.getTextIDs();
+    glUniformMatrix4fv(skyboxShader->uMVMatrix, 1, GL_FALSE, glm::value_ptr(transfos.getMVMatrix()));
+    glUniformMatrix4fv(skyboxShader->uNormalMatrix, 1, GL_FALSE, glm::value_ptr(transfos.getNormalMatrix()));
 
-    for (auto it = skyboxTexts.begin(); it != skyboxTexts.end(); it++)
-    {
-        glUniform1i(skyboxShader->uTextures[i], i);
-        i++;
-    }
-
-    glDrawElements(GL_TRIANGLES, skybox.nbIndexes(), GL_UNSIGNED_INT, 0);
+    _geometry.draw(_skyboxMesh);
 }
 
 /**
@@ -462,55 +611,155 @@ void RenderEngine::draw(Skybox &skybox)
  ********************************************************************************/
 void RenderEngine::end(const Skybox &skybox)
 {
-    // Unbind textures
+    // Unbind textures (the VAO of the shared geometry stays bound for the next meshes)
     for (unsigned int i = 0; i < skybox.getTextIDs().size(); i++)
     {
         glBindTexture(GL_TEXTURE_2D, 0);
     }
-    // Unbind the VAO
-    glBindVertexArray(0);
 }
 
 /**
  * @brief Configures the environment to allow the rendering.
  *
- * Bind the textures of the torus object and the VAO.
+ * Bind the textures of the ring and the VAO without attributes.
  *
- * @param planet The planet whose ring's texture we want to configure
+ * @param ring The ring whose texture we want to configure
  ********************************************************************************/
-void RenderEngine::startRing(const PlanetObject &planet)
+void RenderEngine::startRing(const RingComponent &ring)
 {
-    auto ringTextIDs = planet.getRingTextIDs();
-    int i = 0;
-    for (auto it = ringTextIDs.begin(); it != ringTextIDs.end(); it++)
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, ring.texture);
+
+    // GL_MIRRORED_REPEAT to repeat the texture above and below the torus in a mirrored way
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+
+    // The ring is built from gl_VertexID
+    glBindVertexArray(_emptyVAO);
+}
+
+/**
+ * @brief Launches the rendering of the ring of the given planet.
+ *
+ * The ring is drawn with its own matrix, a child of the planet in the scene graph.
+ *
+ * @param solarSys The solar system storing the planet.
+ * @param planet The planet whose ring we want to draw.
+ * @param camera The camera the scene is seen from.
+ ********************************************************************************/
+void RenderEngine::drawRing(SolarSystem &solarSys, Entity planet, Camera &camera)
+{
+    auto &ring = solarSys.getRings()[planet];
+    glm::vec3 center = solarSys.getModelMatrix(planet)[3];
+
+    glm::vec2 radii(ring.innerRadius, ring.outerRadius);
+    if (!_frustum.intersectsSphere(center, radii.y))
     {
-        glActiveTexture(GL_TEXTURE0 + i);
-        glBindTexture(GL_TEXTURE_2D, *it); // Earth texture binded to #0
+        return;
+    }
 
-        // GL_MIRRORED_REPEAT to repeat the texture above and below the torus in a mirrored way
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+    auto ringShader = ring.shader;
+    auto &ringProgram = ringShader->m_Program;
 
-        i++;
+    ringProgram.use();
+
+    // Draw the ring
+    startRing(ring);
+
+    auto &ringMatrix = solarSys.getRingMatrix(planet);
+    auto normalMatrix = glm::transpose(glm::inverse(ringMatrix));
+    auto MVMatrix = camera.getViewMatrix() * ringMatrix;
+
+    // One segment every few pixels along the outer edge, as many as possible when the camera is in the ring
+    float distance = glm::length(glm::vec3(MVMatrix[3]));
+    GLint segments = RING_MAX_SEGMENTS;
+    if (distance > radii.y)
+    {
+        float pixelRadius = radii.y * getPixelScale() / distance;
+        segments = glm::clamp(GLint(2 * glm::pi<float>() * pixelRadius / RING_SEGMENT_PIXELS), RING_MIN_SEGMENTS, RING_MAX_SEGMENTS);
     }
 
-    // Bind the VAO to draw its data
-    glBindVertexArray(_vaoTorus[planet.getRingID()]);
+    // Send matrices and shape
+    glUniformMatrix4fv(ringShader->uMVMatrix, 1, GL_FALSE, glm::value_ptr(MVMatrix));
+    glUniformMatrix4fv(ringShader->uNormalMatrix, 1, GL_FALSE, glm::value_ptr(normalMatrix));
+    glUniform2fv(ringShader->uRingRadii, 1, glm::value_ptr(radii));
+    glUniform2i(ringShader->uRingSegments, segments, RING_PIPE_SEGMENTS);
+    glUniform1i(ringShader->uFlatRing, ring.flat);
+
+    // Draw the strips built by the vertex shader
+    GLsizei vertexCount = ring.flat ? (segments + 1) * 2 : segments * (RING_PIPE_SEGMENTS + 1) * 2;
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, vertexCount);
+
+    endRing(ring);
 }
 
 /**
  * @brief Put an end to the current rendering environment.
  *
- * @param planet A PlanetObject (defined in the planetObject module) we want
- *               to put an end to the drawing environment for.
+ * @param ring The ring we want to put an end to the drawing environment for.
+ ********************************************************************************/
+void RenderEngine::endRing([[maybe_unused]] const RingComponent &ring)
+{
+    // Unbind the texture (the VAO of the shared geometry stays bound for the next meshes)
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/* ========================================================================================================== */
+/* =                                              GPU DRIVEN                                                = */
+/* ========================================================================================================== */
+
+/**
+ * @brief Prepares the GPU driven rendering of the bodies (see the indirectRenderer module).
+ *
+ * @param applicationPath A FilePath (defined in the glimac library) describing
+ *                        the location where the app is ran.
+ * @param shaders The library sharing the shader managers.
+ * @param solarSys The solar system whose bodies are going to be drawn.
+ *
+ * @return False if the OpenGL context doesn't support it and True otherwise.
  ********************************************************************************/
-void RenderEngine::endRing(const PlanetObject &planet)
+bool RenderEngine::integrateIndirectRendering(const FilePath &applicationPath, ShaderLibrary &shaders, SolarSystem &solarSys)
 {
-    // Unbind textures
-    for (unsigned int i = 0; i < planet.getRingTextIDs().size(); i++)
+    if (!IndirectRenderer::isSupported())
     {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        return false;
+    }
+    _indirectRenderer = std::make_unique<IndirectRenderer>(applicationPath, shaders, solarSys, _geometry);
+    return true;
+}
+
+/**
+ * @brief Tells if the GPU driven rendering is ready to be used.
+ *
+ * @return True if `integrateIndirectRendering()` succeeded.
+ ********************************************************************************/
+bool RenderEngine::hasIndirectRendering() const
+{
+    return _indirectRenderer != nullptr;
+}
+
+/**
+ * @brief Draws the whole solar system with the GPU driven path.
+ *
+ * The bodies are culled and drawn with a constant amount of calls, the rings
+ * are drawn afterwards.
+ *
+ * @param solarSys The solar system to draw.
+ * @param camera The camera the scene is seen from.
+ ********************************************************************************/
+void RenderEngine::drawIndirect(SolarSystem &solarSys, Camera &camera)
+{
+    PROFILE_ZONE("Submission"); // The culling is made by the GPU
+    {
+        PROFILE_GPU_ZONE(_gpuProfiler, "Bodies");
+        _indirectRenderer->draw(solarSys, _frustum, _viewportHeight, camera.isFocusedPov());
+    }
+
+    // Only the planets with a ring are visited
+    PROFILE_GPU_ZONE(_gpuProfiler, "Rings");
+    auto &rings = solarSys.getRings();
+    for (unsigned int i = 0; i < rings.size(); i++)
+    {
+        drawRing(solarSys, rings.getEntity(i), camera);
     }
-    // Unbind the VAO
-    glBindVertexArray(0);
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module contains the transform hierarchy of   =
+=  the scene (star -> planet -> moon -> ring).       =
+=													 =
+======================================================
+*/
+
+#include "include/sceneGraph.hpp"
+
+#include <stdexcept>
+
+/**
+ * @brief Adds a node at the end of the hierarchy.
+ *
+ * The nodes are added depth first: the parent must be the last added node
+ * or one of its ancestors, otherwise std::logic_error is thrown.
+ *
+ * @param parent The parent node, NO_PARENT for a root.
+ * @param localMatrix Transform relative to the parent.
+ *
+ * @return The ID of the new node.
+ ********************************************************************************/
+SceneGraph::NodeId SceneGraph::addNode(NodeId parent, const glm::mat4 &localMatrix)
+{
+    NodeId node = size();
+
+    // The subtree of the parent must still be open to stay contiguous
+    if (parent != NO_PARENT && _subtreeEnds.at(parent) != node)
+    {
+        throw std::logic_error("The nodes of the scene graph must be added depth first");
+    }
+
+    _localMatrices.push_back(localMatrix);
+    _worldMatrices.push_back(parent == NO_PARENT ? localMatrix : _worldMatrices[parent] * localMatrix);
+    _parents.push_back(parent);
+    _subtreeEnds.push_back(node + 1);
+    _dirty.push_back(false);
+
+    for (NodeId ancestor = parent; ancestor != NO_PARENT; ancestor = _parents[ancestor])
+    {
+        _subtreeEnds[ancestor] = node + 1;
+    }
+    return node;
+}
+
+/**
+ * @brief Replaces the whole hierarchy with saved nodes (see the sceneSnapshot
+ *        module).
+ *
+ * The nodes must be given depth first, otherwise std::logic_error is thrown.
+ * The world matrices are taken as they are, nothing is computed again.
+ *
+ * @param count The amount of nodes.
+ * @param parents The parent of each node.
+ * @param localMatrices The transform of each node relative to its parent.
+ * @param worldMatrices The transform of each node in the world.
+ ********************************************************************************/
+void SceneGraph::restore(unsigned int count, const NodeId *parents, const glm::mat4 *localMatrices, const glm::mat4 *worldMatrices)
+{
+    _localMatrices.clear();
+    _worldMatrices.clear();
+    _parents.clear();
+    _subtreeEnds.clear();
+    _dirty.clear();
+
+    // Added one by one, the order of the nodes is checked on the way
+    for (NodeId node = 0; node < count; node++)
+    {
+        addNode(parents[node], localMatrices[node]);
+    }
+    _worldMatrices.assign(worldMatrices, worldMatrices + count);
+}
+
+/**
+ * @brief Sets the transform of a node relative to its parent, its world
+ *        matrix is computed by the next `update()`.
+ *
+ * @param node The node.
+ * @param localMatrix Transform relative to the parent.
+ ********************************************************************************/
+void SceneGraph::setLocalMatrix(NodeId node, const glm::mat4 &localMatrix)
+{
+    _localMatrices[node] = localMatrix;
+    _dirty[node] = true;
+}
+
+/**
+ * @brief Retrieves the transform of a node relative to its parent.
+ ********************************************************************************/
+const glm::mat4 &SceneGraph::getLocalMatrix(NodeId node) const
+{
+    return _localMatrices[node];
+}
+
+/**
+ * @brief Retrieves the transform of a node in the world, as computed by the
+ *        last `update()`.
+ ********************************************************************************/
+const glm::mat4 &SceneGraph::getWorldMatrix(NodeId node) const
+{
+    return _worldMatrices[node];
+}
+
+/**
+ * @brief Retrieves the parent of a node, NO_PARENT for a root.
+ ********************************************************************************/
+SceneGraph::NodeId SceneGraph::getParent(NodeId node) const
+{
+    return _parents[node];
+}
+
+/**
+ * @brief Retrieves the amount of nodes.
+ ********************************************************************************/
+unsigned int SceneGraph::size() const
+{
+    return _parents.size();
+}
+
+/**
+ * @brief Computes the world matrices of the whole hierarchy.
+ ********************************************************************************/
+void SceneGraph::update()
+{
+    update(0, size());
+}
+
+/**
+ * @brief Computes the world matrices of a node and of its descendants.
+ *
+ * The world matrix of the parent of the node must be up to date.
+ *
+ * @param node The root of the subtree.
+ ********************************************************************************/
+void SceneGraph::updateSubtree(NodeId node)
+{
+    update(node, _subtreeEnds[node]);
+}
+
+/**
+ * @brief Computes the world matrices of a range of nodes.
+ *
+ * The parents outside of the range must be up to date.
+ *
+ * @param first The first node.
+ * @param end The node after the last one.
+ ********************************************************************************/
+void SceneGraph::update(NodeId first, NodeId end)
+{
+    for (NodeId node = first; node < end; node++)
+    {
+        NodeId parent = _parents[node];
+        bool parentChanged = parent != NO_PARENT && parent >= first && _dirty[parent];
+
+        if (_dirty[node] || parentChanged)
+        {
+            _worldMatrices[node] = parent == NO_PARENT ? _localMatrices[node] : _worldMatrices[parent] * _localMatrices[node];
+            _dirty[node] = true; // The children are computed again
+        }
+    }
+
+    for (NodeId node = first; node < end; node++)
+    {
+        _dirty[node] = false;
+    }
+}
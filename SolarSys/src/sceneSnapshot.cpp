@@ -0,0 +1,471 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module saves the scene built at the start    =
+=  in a binary file, the next starts map it instead  =
+=  of building the scene again.                      =
+=													 =
+======================================================
+*/
+
+#include "include/sceneSnapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "include/profiler.hpp"
+
+// The tables are copied as they are, a change of their layout needs a new FORMAT_VERSION
+static_assert(sizeof(PlanetValues) == 40, "Change SceneSnapshot::FORMAT_VERSION with the layout of PlanetValues");
+static_assert(sizeof(PackedVertex) == 16, "Change SceneSnapshot::FORMAT_VERSION with the layout of PackedVertex");
+static_assert(sizeof(glm::mat4) == 64, "The matrices are saved as 16 floats");
+
+namespace
+{
+    /**
+     * @brief Rounds an offset up to the alignment of the sections.
+     ********************************************************************************/
+    uint64_t alignSection(uint64_t offset)
+    {
+        return (offset + SceneSnapshot::SECTION_ALIGNMENT - 1) / SceneSnapshot::SECTION_ALIGNMENT * SceneSnapshot::SECTION_ALIGNMENT;
+    }
+
+    /**
+     * @brief Computes the stamp of the executable, from its size and its
+     *        modification time.
+     *
+     * @return 0 if the executable can't be found.
+     ********************************************************************************/
+    uint64_t getBuildStamp(const FilePath &applicationPath)
+    {
+        std::error_code error;
+        auto size = std::filesystem::file_size(applicationPath.str(), error);
+        if (error)
+        {
+            return 0;
+        }
+        auto time = std::filesystem::last_write_time(applicationPath.str(), error);
+        if (error)
+        {
+            return 0;
+        }
+        return uint64_t(time.time_since_epoch().count()) * 31 + size;
+    }
+
+    /**
+     * @brief Retrieves the features of a shader, NO_REFERENCE without shader.
+     ********************************************************************************/
+    uint32_t getShaderReference(const ShaderBody *shader)
+    {
+        return shader ? shader->getFeatures() : SceneSnapshot::NO_REFERENCE;
+    }
+
+    /**
+     * @brief Retrieves the shader of some features, null for NO_REFERENCE.
+     ********************************************************************************/
+    ShaderBody *getShader(ShaderLibrary &shaders, uint32_t features)
+    {
+        if (features == SceneSnapshot::NO_REFERENCE)
+        {
+            return nullptr;
+        }
+        // Checked here so restore() throws before any program is built
+        if (!ShaderBody::isValid(features))
+        {
+            throw std::runtime_error("Unknown shader in the scene snapshot");
+        }
+        return shaders.getBody(features).get();
+    }
+}
+
+/**
+ * @brief Constructor of the class.
+ *
+ * @param applicationPath A FilePath (defined in the glimac library) describing
+ *                        the location where the app is ran.
+ ********************************************************************************/
+SceneSnapshot::SceneSnapshot(const FilePath &applicationPath)
+    : _file{applicationPath.dirPath() + PathStorage::RELATIVE_PATH_SCENE_SNAPSHOT}, _buildStamp{getBuildStamp(applicationPath)}
+{
+}
+
+/**
+ * @brief Maps the snapshot written by a previous start.
+ *
+ * @return False if there is none, if it is damaged or if it was written by
+ *         another build or in another format.
+ ********************************************************************************/
+bool SceneSnapshot::open()
+{
+    if (!_mapping.open(_file))
+    {
+        return false;
+    }
+
+    // Only the header is checked here, the tables are checked when they are read
+    if (_mapping.size() < sizeof(Header) || getHeader().magic != MAGIC || getHeader().version != FORMAT_VERSION ||
+        getHeader().buildStamp != _buildStamp || getHeader().fileSize != _mapping.size())
+    {
+        _mapping.close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Forgets a snapshot which can't be restored: unmaps it and deletes
+ *        the textures it loaded, before the scene is built from scratch.
+ ********************************************************************************/
+void SceneSnapshot::close()
+{
+    glDeleteTextures(_textures.size(), _textures.data());
+    _textures.clear();
+    _texturePaths.clear();
+    _mapping.close();
+}
+
+/**
+ * @brief Loads a texture, its path is the reference saved in the snapshot.
+ *
+ * @param path Path of the texture.
+ *
+ * @return The ID of the texture (see `RenderEngine::createTexture()`).
+ ********************************************************************************/
+GLuint SceneSnapshot::loadTexture(const char *path)
+{
+    GLuint texture = RenderEngine::createTexture(path);
+    _texturePaths.emplace_back(path);
+    _textures.push_back(texture);
+    return texture;
+}
+
+/**
+ * @brief Fills an empty solar system with the mapped bodies.
+ *
+ * The referenced textures are loaded and the shaders are requested from the
+ * library. Throws a std::runtime_error if the tables don't match, the meshes
+ * are checked too so `restore(RenderEngine &)` can't fail afterwards.
+ *
+ * @param shaders The library sharing the shader managers between the planets.
+ * @param solarSys A SolarSystem object we want to fill.
+ ********************************************************************************/
+void SceneSnapshot::restore(ShaderLibrary &shaders, SolarSystem &solarSys)
+{
+    PROFILE_ZONE("Snapshot restore");
+    auto &header = getHeader();
+
+    // Meshes, uploaded later by restore(RenderEngine &)
+    getTable<PackedVertex>(header.verticesOffset, header.nbVertices);
+    getTable<uint32_t>(header.indicesOffset, header.nbIndices);
+    for (auto &mesh : {header.sphereMesh, header.skyboxMesh})
+    {
+        if (mesh.firstIndex > header.nbIndices || mesh.indexCount > header.nbIndices - mesh.firstIndex)
+        {
+            throw std::runtime_error("Damaged mesh in the scene snapshot");
+        }
+    }
+
+    // Textures, in the order they were loaded
+    const char *paths = getTable<char>(header.texturePathsOffset, header.texturePathsSize);
+    const char *pathsEnd = paths + header.texturePathsSize;
+    for (uint32_t i = 0; i < header.nbTextures; i++)
+    {
+        const char *pathEnd = std::find(paths, pathsEnd, '\0');
+        if (pathEnd == pathsEnd)
+        {
+            throw std::runtime_error("Damaged texture paths in the scene snapshot");
+        }
+        loadTexture(paths);
+        paths = pathEnd + 1;
+    }
+
+    // Transforms at the epoch, nothing is computed
+    solarSys.getSceneGraph().restore(header.nbNodes, getTable<SceneGraph::NodeId>(header.parentsOffset, header.nbNodes),
+                                     getTable<glm::mat4>(header.localMatricesOffset, header.nbNodes),
+                                     getTable<glm::mat4>(header.worldMatricesOffset, header.nbNodes));
+
+    const BakedBody *bodies = getTable<BakedBody>(header.bodiesOffset, header.nbBodies);
+    for (uint32_t i = 0; i < header.nbBodies; i++)
+    {
+        auto &body = bodies[i];
+        if (body.orbitNode >= header.nbNodes || body.bodyNode >= header.nbNodes || body.nbTextures > MaterialComponent::MAX_TEXTURES)
+        {
+            throw std::runtime_error("Damaged body in the scene snapshot");
+        }
+
+        // The satellites are a range of bodies, read without checks by SolarSystem::getSatellites()
+        bool validParent = body.parent == NO_ENTITY || body.parent < header.nbBodies;
+        bool validChildren = body.nbChildren == 0 || (body.firstChild < header.nbBodies && body.nbChildren <= header.nbBodies - body.firstChild);
+        if (!validParent || !validChildren)
+        {
+            throw std::runtime_error("Damaged hierarchy in the scene snapshot");
+        }
+
+        MaterialComponent material;
+        material.nbTextures = body.nbTextures;
+        for (unsigned int t = 0; t < body.nbTextures; t++)
+        {
+            material.textures[t] = getTexture(body.textures[t]);
+        }
+        for (unsigned int level = 0; level < NB_SHADING_LEVELS; level++)
+        {
+            material.shaders[level] = getShader(shaders, body.shaders[level]);
+        }
+        material.alwaysImpostor = body.alwaysImpostor != 0;
+
+        TransformComponent transform;
+        transform.orbitNode = body.orbitNode;
+        transform.bodyNode = body.bodyNode;
+
+        HierarchyComponent hierarchy;
+        hierarchy.parent = body.parent;
+        hierarchy.firstChild = body.firstChild;
+        hierarchy.nbChildren = body.nbChildren;
+
+        solarSys.restoreBody(BakedData(body.data), material, transform, hierarchy);
+    }
+
+    const BakedRing *rings = getTable<BakedRing>(header.ringsOffset, header.nbRings);
+    for (uint32_t i = 0; i < header.nbRings; i++)
+    {
+        if (rings[i].planet >= header.nbBodies || rings[i].node >= header.nbNodes)
+        {
+            throw std::runtime_error("Damaged ring in the scene snapshot");
+        }
+
+        RingComponent ring;
+        ring.texture = getTexture(rings[i].texture);
+        ring.shader = getShader(shaders, rings[i].shader);
+        ring.node = rings[i].node;
+        ring.innerRadius = rings[i].innerRadius;
+        ring.outerRadius = rings[i].outerRadius;
+        ring.flat = rings[i].flat != 0;
+        solarSys.restoreRing(rings[i].planet, ring);
+    }
+}
+
+/**
+ * @brief Uploads the mapped meshes to the shared geometry of a render engine,
+ *        in place of `RenderEngine::createSphere()` and `RenderEngine::integrateSkybox()`.
+ *
+ * @param renderEng The render engine.
+ ********************************************************************************/
+void SceneSnapshot::restore(RenderEngine &renderEng) const
+{
+    auto &header = getHeader();
+    auto toArenaMesh = [](const BakedMesh &baked)
+    {
+        ArenaMesh mesh;
+        mesh.m_Mode = baked.mode;
+        mesh.m_nIndexCount = baked.indexCount;
+        mesh.m_nFirstIndex = baked.firstIndex;
+        mesh.m_nBaseVertex = baked.baseVertex;
+        return mesh;
+    };
+
+    renderEng.integrateMeshes(getTable<PackedVertex>(header.verticesOffset, header.nbVertices), header.nbVertices,
+                              getTable<uint32_t>(header.indicesOffset, header.nbIndices), header.nbIndices,
+                              toArenaMesh(header.sphereMesh), toArenaMesh(header.skyboxMesh));
+}
+
+/**
+ * @brief Writes the snapshot of a scene built from scratch.
+ *
+ * The file is written beside and renamed, a start mapping the previous one
+ * keeps reading it.
+ *
+ * @param solarSys The solar system, its textures must come from `loadTexture()`.
+ * @param renderEng The render engine, with the sphere and the skybox integrated.
+ *
+ * @return False if the file can't be written.
+ ********************************************************************************/
+bool SceneSnapshot::write(const SolarSystem &solarSys, const RenderEngine &renderEng) const
+{
+    PROFILE_ZONE("Snapshot write");
+    auto &orbits = solarSys.getOrbits();
+    auto &transforms = solarSys.getTransforms();
+    auto &materials = solarSys.getMaterials();
+    auto &hierarchies = solarSys.getHierarchies();
+    auto &rings = solarSys.getRings();
+    auto &sceneGraph = solarSys.getSceneGraph();
+
+    // Entity tables
+    std::vector<BakedBody> bodies(solarSys.nbBodies());
+    for (Entity entity = 0; entity < bodies.size(); entity++)
+    {
+        auto &body = bodies[entity];
+        auto &material = materials[entity];
+        body.data = orbits[entity].data.getValues();
+        body.orbitNode = transforms[entity].orbitNode;
+        body.bodyNode = transforms[entity].bodyNode;
+        body.parent = hierarchies[entity].parent;
+        body.firstChild = hierarchies[entity].firstChild;
+        body.nbChildren = hierarchies[entity].nbChildren;
+        body.nbTextures = material.nbTextures;
+        for (unsigned int t = 0; t < MaterialComponent::MAX_TEXTURES; t++)
+        {
+            body.textures[t] = t < material.nbTextures ? getTextureIndex(material.textures[t]) : NO_REFERENCE;
+        }
+        for (unsigned int level = 0; level < NB_SHADING_LEVELS; level++)
+        {
+            body.shaders[level] = getShaderReference(material.shaders[level]);
+        }
+        body.alwaysImpostor = material.alwaysImpostor;
+    }
+
+    std::vector<BakedRing> bakedRings(rings.size());
+    for (unsigned int i = 0; i < rings.size(); i++)
+    {
+        auto &ring = rings[rings.getEntity(i)];
+        bakedRings[i] = BakedRing{rings.getEntity(i), getTextureIndex(ring.texture), getShaderReference(ring.shader),
+                                  ring.node, ring.innerRadius, ring.outerRadius, ring.flat};
+    }
+
+    // Scene graph at the epoch
+    std::vector<SceneGraph::NodeId> parents(sceneGraph.size());
+    std::vector<glm::mat4> localMatrices(sceneGraph.size());
+    std::vector<glm::mat4> worldMatrices(sceneGraph.size());
+    for (SceneGraph::NodeId node = 0; node < sceneGraph.size(); node++)
+    {
+        parents[node] = sceneGraph.getParent(node);
+        localMatrices[node] = sceneGraph.getLocalMatrix(node);
+        worldMatrices[node] = sceneGraph.getWorldMatrix(node);
+    }
+
+    // Meshes, as stored on the GPU
+    std::vector<PackedVertex> vertices;
+    std::vector<uint32_t> indices;
+    renderEng.getGeometry().getContent(vertices, indices);
+
+    std::string texturePaths;
+    for (auto &path : _texturePaths)
+    {
+        texturePaths.append(path.c_str(), path.size() + 1); // With its null character
+    }
+
+    auto toBakedMesh = [](const ArenaMesh &mesh)
+    {
+        return BakedMesh{mesh.m_Mode, uint32_t(mesh.m_nIndexCount), mesh.m_nFirstIndex, mesh.m_nBaseVertex};
+    };
+
+    Header header = {};
+    header.magic = MAGIC;
+    header.version = FORMAT_VERSION;
+    header.buildStamp = _buildStamp;
+    header.nbBodies = bodies.size();
+    header.nbRings = bakedRings.size();
+    header.nbNodes = sceneGraph.size();
+    header.nbVertices = vertices.size();
+    header.nbIndices = indices.size();
+    header.nbTextures = _texturePaths.size();
+    header.sphereMesh = toBakedMesh(renderEng.getSphereMesh());
+    header.skyboxMesh = toBakedMesh(renderEng.getSkyboxMesh());
+
+    // Each section starts aligned, the tables are used in place once mapped
+    struct Section
+    {
+        uint64_t &offset;
+        const void *data;
+        uint64_t size;
+    };
+    Section sections[] = {
+        {header.bodiesOffset, bodies.data(), bodies.size() * sizeof(BakedBody)},
+        {header.ringsOffset, bakedRings.data(), bakedRings.size() * sizeof(BakedRing)},
+        {header.parentsOffset, parents.data(), parents.size() * sizeof(SceneGraph::NodeId)},
+        {header.localMatricesOffset, localMatrices.data(), localMatrices.size() * sizeof(glm::mat4)},
+        {header.worldMatricesOffset, worldMatrices.data(), worldMatrices.size() * sizeof(glm::mat4)},
+        {header.verticesOffset, vertices.data(), vertices.size() * sizeof(PackedVertex)},
+        {header.indicesOffset, indices.data(), indices.size() * sizeof(uint32_t)},
+        {header.texturePathsOffset, texturePaths.data(), texturePaths.size()},
+    };
+    uint64_t offset = sizeof(Header);
+    for (auto &section : sections)
+    {
+        section.offset = offset = alignSection(offset);
+        offset += section.size;
+    }
+    header.texturePathsSize = texturePaths.size();
+    header.fileSize = offset;
+
+    // A start mapping the previous snapshot keeps its pages, the new file replaces it once complete
+    std::error_code error;
+    std::filesystem::create_directories(_file.dirPath().str(), error);
+    std::string temporaryFile = _file.str() + ".tmp";
+    {
+        std::ofstream output(temporaryFile, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        uint64_t written = sizeof(header);
+        const char padding[SECTION_ALIGNMENT] = {};
+        for (auto &section : sections)
+        {
+            output.write(padding, section.offset - written);
+            output.write(static_cast<const char *>(section.data), section.size);
+            written = section.offset + section.size;
+        }
+        if (!output)
+        {
+            return false;
+        }
+    }
+    std::filesystem::rename(temporaryFile, _file.str(), error);
+    return !error;
+}
+
+/**
+ * @brief Retrieves a table of the mapped file.
+ *
+ * Throws a std::runtime_error if it goes past the end of the file.
+ *
+ * @param offset Position of the table (in bytes).
+ * @param count Amount of elements.
+ ********************************************************************************/
+template <typename T>
+const T *SceneSnapshot::getTable(uint64_t offset, uint64_t count) const
+{
+    if (offset % alignof(T) != 0 || offset > _mapping.size() || count > (_mapping.size() - offset) / sizeof(T))
+    {
+        throw std::runtime_error("Damaged table in the scene snapshot");
+    }
+    return reinterpret_cast<const T *>(_mapping.data() + offset);
+}
+
+/**
+ * @brief Retrieves the header of the mapped file.
+ ********************************************************************************/
+const SceneSnapshot::Header &SceneSnapshot::getHeader() const
+{
+    return *reinterpret_cast<const Header *>(_mapping.data());
+}
+
+/**
+ * @brief Retrieves the index of the path of a loaded texture, NO_REFERENCE if
+ *        it wasn't loaded by `loadTexture()`.
+ ********************************************************************************/
+uint32_t SceneSnapshot::getTextureIndex(GLuint texture) const
+{
+    auto found = std::find(_textures.begin(), _textures.end(), texture);
+    return found == _textures.end() ? NO_REFERENCE : found - _textures.begin();
+}
+
+/**
+ * @brief Retrieves a loaded texture from its index, 0 (no texture) for
+ *        NO_REFERENCE.
+ ********************************************************************************/
+GLuint SceneSnapshot::getTexture(uint32_t index) const
+{
+    if (index == NO_REFERENCE)
+    {
+        return 0;
+    }
+    if (index >= _textures.size())
+    {
+        throw std::runtime_error("Unknown texture in the scene snapshot");
+    }
+    return _textures[index];
+}
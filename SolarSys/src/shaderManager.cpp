@@ -13,83 +13,309 @@
 
 #include "include/shaderManager.hpp"
 
+#include <iomanip>
+#include <stdexcept>
+#include <glimac/Extensions.hpp>
+
+#include "include/profiler.hpp"
+
 /* ================================= SHADER MANAGER ======================================= */
 
 /**
  * @brief Constructor of the class.
  *
+ * @param registry The registry building the programs.
  * @param applicationPath A FilePath (defined in the glimac library) describing
  *                        the location where the app is ran.
  * @param vertexShaderPath A path to the vertex shader.
  * @param fragmentShaderPath A path to the fragment shader.
+ * @param defines Lines inserted after the version of the shaders (see ProgramRegistry).
+ ********************************************************************************/
+ShaderManager::ShaderManager(ProgramRegistry &registry, const FilePath &applicationPath, const char *vertexShaderPath, const char *fragmentShaderPath,
+                             const std::string &defines)
+    : _sharedProgram{registry.get(applicationPath.dirPath() + vertexShaderPath, applicationPath.dirPath() + fragmentShaderPath, defines)},
+      m_Program{*_sharedProgram}
+{
+}
+
+/**
+ * @brief Retrieves the uniform IDs and binds the textures and the uniform blocks.
+ *
+ * Must be called once the program is built (see `ProgramRegistry::finish()`).
  ********************************************************************************/
-ShaderManager::ShaderManager(const FilePath &applicationPath, const char *vertexShaderPath, const char *fragmentShaderPath) : m_Program(loadProgram(applicationPath.dirPath() + vertexShaderPath,
-                                                                                                                                                    applicationPath.dirPath() + fragmentShaderPath))
+void ShaderManager::loadUniforms()
 {
     // Matrices
-    uMVPMatrix = glGetUniformLocation(m_Program.getGLId(), "uMVPMatrix");
     uMVMatrix = glGetUniformLocation(m_Program.getGLId(), "uMVMatrix");
     uNormalMatrix = glGetUniformLocation(m_Program.getGLId(), "uNormalMatrix");
 
     // Textures
-    uTextures.emplace_back(glGetUniformLocation(m_Program.getGLId(), "uTexture"));
-
-    // Light
-    uKd = glGetUniformLocation(m_Program.getGLId(), "uKd");
-    uKs = glGetUniformLocation(m_Program.getGLId(), "uKs");
-    uShininess = glGetUniformLocation(m_Program.getGLId(), "uShininess");
-    uLightPosition = glGetUniformLocation(m_Program.getGLId(), "uLightPos");
-    uLightIntensity = glGetUniformLocation(m_Program.getGLId(), "uLightIntensity");
-    uIsLighted = glGetUniformLocation(m_Program.getGLId(), "uIsLighted");
-    uAmbientLight = glGetUniformLocation(m_Program.getGLId(), "uAmbientLight");
+    uTextures.assign(1, glGetUniformLocation(m_Program.getGLId(), "uTexture"));
+    bindTextureUnits();
+
+    // Frame and material data shared by all the programs
+    bindUniformBlock<FrameUniforms>();
+    bindUniformBlock<MaterialUniforms>();
 }
 
-/* ================================= SHADER1FULLYLIGHTEDTEXTURE ======================================= */
+/**
+ * @brief Links each texture uniform to the texture unit of the same index.
+ *
+ * The texture units never change, so this is done once when the program is
+ * built instead of on every draw.
+ ********************************************************************************/
+void ShaderManager::bindTextureUnits()
+{
+    m_Program.use();
+    for (unsigned int i = 0; i < uTextures.size(); i++)
+    {
+        glUniform1i(uTextures[i], i);
+    }
+    glUseProgram(0);
+}
+
+/* ================================= SHADERBODY ======================================= */
 
 /**
  * @brief Constructor of the class.
  *
+ * @param registry The registry building the programs.
  * @param applicationPath A FilePath (defined in the glimac library) describing
  *                        the location where the app is ran.
+ * @param features A combination of ShaderFeature flags.
  ********************************************************************************/
-Shader1FullyLightedTexture::Shader1FullyLightedTexture(const FilePath &applicationPath)
-    : ShaderManager(applicationPath, PathStorage::RELATIVE_PATH_VERTEX, PathStorage::RELATIVE_PATH_FRAGMENT_FULLYLIGHTED1T)
+ShaderBody::ShaderBody(ProgramRegistry &registry, const FilePath &applicationPath, unsigned int features)
+    : ShaderManager(registry, applicationPath, getVertexShader(features), PathStorage::RELATIVE_PATH_FRAGMENT_BODY, getDefines(features)),
+      _features{features}
 {
 }
 
-/* ================================= SHADER1TEXTURE ======================================= */
+/**
+ * @brief Tells if some features make a permutation that can be built.
+ *
+ * A single vertex shader builds the shape, so SHADER_RING, SHADER_IMPOSTOR,
+ * SHADER_POINT and SHADER_INDIRECT exclude each other. SHADER_POINT needs
+ * SHADER_AVERAGE_COLOR (a point has no texture coordinates) and SHADER_INDIRECT
+ * reads the texture layers of each body, it can't take SHADER_SECOND_TEXTURE
+ * or SHADER_AVERAGE_COLOR.
+ *
+ * @param features A combination of ShaderFeature flags.
+ *
+ * @return True if the features can be given to `ShaderLibrary::getBody()`.
+ ********************************************************************************/
+bool ShaderBody::isValid(unsigned int features)
+{
+    if (features >= PERMUTATION_COUNT)
+    {
+        return false;
+    }
+
+    unsigned int nbShapes = ((features & SHADER_RING) != 0) + ((features & SHADER_IMPOSTOR) != 0) + ((features & SHADER_POINT) != 0) +
+                            ((features & SHADER_INDIRECT) != 0);
+    if (nbShapes > 1)
+    {
+        return false;
+    }
+    if ((features & SHADER_POINT) && !(features & SHADER_AVERAGE_COLOR))
+    {
+        return false;
+    }
+    return !(features & SHADER_INDIRECT) || !(features & (SHADER_SECOND_TEXTURE | SHADER_AVERAGE_COLOR));
+}
 
 /**
- * @brief Constructor of the class.
+ * @brief Retrieves the defines selecting the features in the shader sources.
  *
- * @param applicationPath A FilePath (defined in the glimac library) describing
- *                        the location where the app is ran.
+ * @param features A combination of ShaderFeature flags.
+ *
+ * @return One "#define" line per feature.
  ********************************************************************************/
-Shader1Texture::Shader1Texture(const FilePath &applicationPath)
-    : ShaderManager(applicationPath, PathStorage::RELATIVE_PATH_VERTEX, PathStorage::RELATIVE_PATH_FRAGMENT_1T)
+std::string ShaderBody::getDefines(unsigned int features)
 {
+    std::string defines;
+    if (features & SHADER_LIGHTED)
+    {
+        defines += "#define LIGHTED\n";
+    }
+    if (features & SHADER_SECOND_TEXTURE)
+    {
+        defines += "#define SECOND_TEXTURE\n";
+    }
+    if (features & SHADER_RING)
+    {
+        defines += "#define RING\n";
+    }
+    if (features & SHADER_IMPOSTOR)
+    {
+        defines += "#define IMPOSTOR\n";
+
+        // The depth written by the shader must follow the clip control of the render engine
+        if (hasClipControl())
+        {
+            defines += "#define DEPTH_ZERO_TO_ONE\n";
+        }
+    }
+    if (features & SHADER_AVERAGE_COLOR)
+    {
+        defines += "#define AVERAGE_COLOR\n";
+    }
+    if (features & SHADER_INDIRECT)
+    {
+        defines += "#define INDIRECT\n";
+    }
+    return defines;
 }
 
-/* ================================= SHADER2TEXTURE ======================================= */
+/**
+ * @brief Retrieves the vertex shader matching some features.
+ *
+ * @param features A combination of ShaderFeature flags.
+ *
+ * @return The relative path of the vertex shader (see PathStorage).
+ ********************************************************************************/
+const char *ShaderBody::getVertexShader(unsigned int features)
+{
+    if (features & SHADER_INDIRECT)
+    {
+        return PathStorage::RELATIVE_PATH_VERTEX_INDIRECT;
+    }
+    if (features & SHADER_POINT)
+    {
+        return PathStorage::RELATIVE_PATH_VERTEX_POINT;
+    }
+    if (features & SHADER_IMPOSTOR)
+    {
+        return PathStorage::RELATIVE_PATH_VERTEX_IMPOSTOR;
+    }
+    if (features & SHADER_RING)
+    {
+        return PathStorage::RELATIVE_PATH_VERTEX_RING;
+    }
+    return PathStorage::RELATIVE_PATH_VERTEX;
+}
 
 /**
- * @brief Constructor of the class.
+ * @brief Retrieves the uniform IDs, including the ones of the second texture
+ *        and of the ring shape.
+ ********************************************************************************/
+void ShaderBody::loadUniforms()
+{
+    ShaderManager::loadUniforms();
+    if (_features & SHADER_SECOND_TEXTURE)
+    {
+        uTextures.emplace_back(glGetUniformLocation(m_Program.getGLId(), "uSecondTexture"));
+        bindTextureUnits();
+    }
+    if (_features & SHADER_RING)
+    {
+        uRingRadii = glGetUniformLocation(m_Program.getGLId(), "uRingRadii");
+        uRingSegments = glGetUniformLocation(m_Program.getGLId(), "uRingSegments");
+        uFlatRing = glGetUniformLocation(m_Program.getGLId(), "uFlatRing");
+    }
+}
+
+/**
+ * @brief Retrieves the features of the permutation.
  *
- * @param applicationPath A FilePath (defined in the glimac library) describing
- *                        the location where the app is ran.
+ * @return A combination of ShaderFeature flags.
  ********************************************************************************/
-Shader2Texture::Shader2Texture(const FilePath &applicationPath) : ShaderManager(applicationPath, PathStorage::RELATIVE_PATH_VERTEX, PathStorage::RELATIVE_PATH_FRAGMENT_2T)
+unsigned int ShaderBody::getFeatures() const
 {
-    uTextures.emplace_back(glGetUniformLocation(m_Program.getGLId(), "uSecondTexture"));
+    return _features;
 }
 
+/* ================================= SHADERLIBRARY ======================================= */
+
 /**
  * @brief Constructor of the class.
  *
+ * The linked programs are cached next to the app, a warm start doesn't compile
+ * any shader.
+ *
  * @param applicationPath A FilePath (defined in the glimac library) describing
  *                        the location where the app is ran.
  ********************************************************************************/
-ShaderTorusTexture::ShaderTorusTexture(const FilePath &applicationPath)
-    : ShaderManager(applicationPath, PathStorage::RELATIVE_PATH_VERTEX, PathStorage::RELATIVE_PATH_FRAGMENT_TORUS)
+ShaderLibrary::ShaderLibrary(const FilePath &applicationPath) : _applicationPath{applicationPath}
 {
-}
\ No newline at end of file
+    _registry.setCacheDirectory(applicationPath.dirPath() + PathStorage::RELATIVE_PATH_SHADER_CACHE);
+}
+
+/**
+ * @brief Retrieves a permutation of the body shader, it is created on the first call.
+ *
+ * Throws a std::invalid_argument if the features aren't valid (see
+ * `ShaderBody::isValid()`).
+ *
+ * @param features A combination of ShaderFeature flags.
+ *
+ * @return A shared_ptr (defined in the memory library) of the shader manager.
+ ********************************************************************************/
+std::shared_ptr<ShaderBody> ShaderLibrary::getBody(unsigned int features)
+{
+    if (!ShaderBody::isValid(features))
+    {
+        throw std::invalid_argument("Invalid body shader permutation: " + std::to_string(features));
+    }
+
+    _nbRequests++;
+
+    auto &shader = _bodies[features];
+    if (!shader)
+    {
+        PROFILE_ZONE("Shader compile"); // Only submitted when the driver compiles in parallel
+        shader = std::make_shared<ShaderBody>(_registry, _applicationPath, features);
+        _pending.push_back(shader);
+    }
+    return shader;
+}
+
+/**
+ * @brief Requests every valid permutation of the body shader, they are built
+ * by the next call to `finish()` and cached on disk with the other programs.
+ ********************************************************************************/
+void ShaderLibrary::precompileBodies()
+{
+    for (unsigned int features = 0; features < ShaderBody::PERMUTATION_COUNT; features++)
+    {
+        if (ShaderBody::isValid(features))
+        {
+            getBody(features);
+        }
+    }
+}
+
+/**
+ * @brief Waits for the programs being compiled and loads the uniforms of the
+ * new shader managers.
+ *
+ * Throws a std::runtime_error if a program can't be built.
+ ********************************************************************************/
+void ShaderLibrary::finish()
+{
+    PROFILE_ZONE("Shader wait");
+    _registry.finish();
+
+    for (auto &shader : _pending)
+    {
+        shader->loadUniforms();
+    }
+    _pending.clear();
+}
+
+/**
+ * @brief Writes the compile and link time of each program.
+ *
+ * @param stream Where to write.
+ ********************************************************************************/
+void ShaderLibrary::printStats(std::ostream &stream) const
+{
+    stream << "Shaders: " << _registry.getProgramCount() << " programs built for " << _nbRequests << " requests"
+           << (_registry.isParallel() ? " (parallel compilation)" : "") << std::endl;
+
+    for (auto &stats : _registry.getStats())
+    {
+        stream << std::fixed << std::setprecision(2)
+               << "  submitted in " << stats.m_fSubmitTime << " ms, waited " << stats.m_fWaitTime << " ms"
+               << (stats.m_bCached ? " (cached): " : ": ") << stats.m_Name << std::endl;
+    }
+}
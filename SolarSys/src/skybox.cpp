@@ -18,14 +18,12 @@
  * Makes a skybox representation using the index buffer system.
  * This means that there are both a data storage and an index one.
  *
- * @param filePath A FilePath object (see the FilePath class in glimac).
+ * @param shaders The library sharing the shader managers.
  * @param textID An ID that describes a texture that has been loaded.
- * @param w The width of the window (used for the projection matrix).
- * @param h The height of the window (used for the projection matrix).
  ********************************************************************************/
-Skybox::Skybox(FilePath filePath, GLuint textID, float w, float h)
+Skybox::Skybox(ShaderLibrary &shaders, GLuint textID)
 {
-    build(filePath, textID, w, h);
+    build(shaders, textID);
 }
 
 /**
@@ -82,7 +80,7 @@ std::shared_ptr<ShaderManager> Skybox::getShaderManager()
 /**
  * @brief Retrieves the transformation matrices of the cube.
  *
- * Brings a Matrices object (see the Matrices module), that contains MV, MVP and
+ * Brings a Matrices object (see the Matrices module), that contains MV and
  * normals matrices.
  *
  * @return A reference on the matrices.
@@ -123,13 +121,11 @@ uint Skybox::nbIndexes() const
  * Creates a cube in 3D dimension thanks to 8 points defined and indexes that
  * describe how this shape can be drawn with triangles.
  *
- * @param filePath A FilePath object.
+ * @param shaders The library sharing the shader managers.
  * @param textID An integer index describing the information of the texture to
  *               send to the shader.
- * @param w The width of the window (used for the projection matrix).
- * @param h The height of the window (used for the projection matrix).
  ********************************************************************************/
-void Skybox::build(FilePath filePath, GLuint textID, float w, float h)
+void Skybox::build(ShaderLibrary &shaders, GLuint textID)
 {
     /*
           5   *---------*    4
@@ -177,8 +173,8 @@ void Skybox::build(FilePath filePath, GLuint textID, float w, float h)
     }
 
     // Initialize the attributes of the class
-    _matrices.init(w, h, 0, 0, 0.5); // 0.5 scale to have a 1x1x1 cube
-    _shader = std::make_shared<Shader1Texture>(filePath);
+    _matrices.init(0, 0, 0.5); // 0.5 scale to have a 1x1x1 cube
+    _shader = shaders.getBody(SHADER_EMISSIVE); // We don't want the cube to be lighted
     _texts.push_back(textID);
     _indexes = {
         // Front face
@@ -5,9 +5,9 @@
 =													 =
 =													 =
 =  This module defines the SolarSystem class.        =
-=  A SolarSystem object contains planets and has     =
-=  several methods to iterate over them, access      =
-=  them, add new planets, ...                        =
+=  A SolarSystem object stores the components of     =
+=  the planets and of their satellites, and moves    =
+=  them.                                             =
 =													 =
 ======================================================
 */
@@ -15,156 +15,378 @@
 #include "include/solarSystem.hpp"
 
 /**
- * @brief Adds a new planet.
+ * @brief Creates the entity of a body with all the components of a body.
  *
- * @param planet A PlanetObject (defined in the planetObject module) to add
+ * @param data Information about the body.
+ * @param material Textures and shaders of the body.
+ * @param parent The planet of a satellite, NO_ENTITY for a planet.
+ * @param parentNode The node the body orbits around.
+ *
+ * @return The handle of the body.
  ********************************************************************************/
-void SolarSystem::addPlanet(std::unique_ptr<PlanetObject> planet)
+Entity SolarSystem::createBody(const PlanetData &data, const MaterialComponent &material, Entity parent, SceneGraph::NodeId parentNode)
 {
-    _planets.emplace_back(std::move(planet));
+    Entity body = _nbEntities++;
+
+    TransformComponent transform;
+    if (parent == NO_ENTITY)
+    {
+        // The orbit node is the reference shared by the body, its ring and its satellites
+        transform.orbitNode = _sceneGraph.addNode(parentNode);
+        transform.bodyNode = _sceneGraph.addNode(transform.orbitNode);
+    }
+    else
+    {
+        transform.orbitNode = transform.bodyNode = _sceneGraph.addNode(parentNode); // A single node, the satellite has no children
+    }
+
+    HierarchyComponent hierarchy;
+    hierarchy.parent = parent;
+
+    _orbits.add(body, OrbitComponent{data});
+    _transforms.add(body, transform);
+    _materials.add(body, material);
+    _hierarchies.add(body, hierarchy);
+    return body;
 }
 
 /**
- * @brief Get a collection of all the planets stored.
+ * @brief Adds a new planet, orbiting around the sun.
+ *
+ * Its ring and its satellites must be added right after it.
  *
- * @return A vector containing all the PlanetObject (defined in the planetObject module)
- *         stored.
+ * @param data Information about the planet (defined in the planetData module).
+ * @param material Textures and shaders of the planet.
+ *
+ * @return The handle of the planet.
  ********************************************************************************/
-const std::vector<std::unique_ptr<PlanetObject>> &SolarSystem::getAllPlanets() const
+Entity SolarSystem::addPlanet(const PlanetData &data, const MaterialComponent &material)
 {
-    return _planets;
+    Entity planet = createBody(data, material, NO_ENTITY, _starNode);
+    _planets.push_back(planet);
+    updateMatrices(planet, 0, true);
+    return planet;
 }
 
 /**
- * @brief Retrieves the amount of planets stored.
+ * @brief Adds a ring to the last added planet, before its satellites.
  *
- * @return The number of planets.
+ * The radii come from the data of the planet. Throws std::logic_error if the
+ * planet isn't the last added body.
+ *
+ * @param planet The planet.
+ * @param texture ID of the texture of the ring.
+ * @param shader Shader of the ring, owned by the ShaderLibrary.
  ********************************************************************************/
-unsigned int SolarSystem::nbPlanets()
+void SolarSystem::addRing(Entity planet, GLuint texture, ShaderBody *shader)
 {
-    return _planets.size();
+    if (planet + 1 != _nbEntities || _hierarchies[planet].parent != NO_ENTITY)
+    {
+        throw std::logic_error("A ring must be added to the last added planet, before its satellites");
+    }
+
+    auto &data = _orbits[planet].data;
+    auto ringMatrix = glm::rotate(glm::mat4(1), glm::radians(90.f), glm::vec3(1, 0, 0));                  // Rotation on itself
+    ringMatrix = glm::scale(ringMatrix, glm::vec3(1 / data._diameter, 1 / data._diameter, 1 / data._diameter)); // Scale the ring back to 1
+    // Since the rings are built with already accurate proportions, we can just scale the object back to 1
+
+    RingComponent ring;
+    ring.texture = texture;
+    ring.shader = shader;
+    ring.node = _sceneGraph.addNode(_transforms[planet].bodyNode, ringMatrix);
+    ring.innerRadius = data._ringDist;
+    ring.outerRadius = data._ringDist + 2 * data._ringThickness; // The outer edge is two thicknesses further
+    _rings.add(planet, ring);
 }
 
 /**
- * @brief Retrieves the planet at the given index.
+ * @brief Adds a satellite to the last added planet.
  *
+ * Throws std::logic_error if the planet isn't the last added one.
  *
- * @param index The index which must belong to the [0, size - 1] interval.
+ * @param planet The planet.
+ * @param data Information about the satellite (defined in the planetData module).
+ * @param material Textures and shaders of the satellite.
  *
- * @return The planet at the given index.
+ * @return The handle of the satellite.
  ********************************************************************************/
-PlanetObject &SolarSystem::operator[](unsigned int index)
+Entity SolarSystem::addSatellite(Entity planet, const PlanetData &data, const MaterialComponent &material)
 {
-    // Vérifier la validité de l'index
-    if (index >= _planets.size())
+    if (_planets.empty() || _planets.back() != planet)
     {
-        throw std::out_of_range("Index out of bounds");
+        throw std::logic_error("The satellites must be added right after their planet");
     }
 
-    return *_planets[index];
+    Entity satellite = createBody(data, material, planet, _transforms[planet].orbitNode);
+
+    // The satellites follow their planet, the range stays contiguous
+    auto &hierarchy = _hierarchies[planet];
+    if (hierarchy.nbChildren == 0)
+    {
+        hierarchy.firstChild = satellite;
+    }
+    hierarchy.nbChildren++;
+
+    updateSatelliteMatrix(satellite, 0);
+    _sceneGraph.updateSubtree(_transforms[satellite].orbitNode);
+    return satellite;
 }
 
 /**
- * @brief Destructor of the class.
+ * @brief Adds a body read back from a scene snapshot (see the sceneSnapshot
+ *        module), nothing is computed.
+ *
+ * The bodies must be restored in the order of their entities, the nodes of
+ * their transforms come from the scene graph restored with them.
+ *
+ * @param data Information about the body.
+ * @param material Textures and shaders of the body.
+ * @param transform Nodes of the body in the scene graph.
+ * @param hierarchy Planet or satellites of the body.
+ *
+ * @return The handle of the body.
  ********************************************************************************/
-SolarSystem::~SolarSystem()
+Entity SolarSystem::restoreBody(const PlanetData &data, const MaterialComponent &material, const TransformComponent &transform, const HierarchyComponent &hierarchy)
 {
-    _planets.clear(); // When the solar system is deleted, we want all the planets to be deleted as well
+    Entity body = _nbEntities++;
+    _orbits.add(body, OrbitComponent{data});
+    _transforms.add(body, transform);
+    _materials.add(body, material);
+    _hierarchies.add(body, hierarchy);
+
+    if (hierarchy.parent == NO_ENTITY)
+    {
+        _planets.push_back(body);
+    }
+    return body;
 }
 
 /**
- * @brief Returns a pointer on the first planet.
+ * @brief Adds a ring read back from a scene snapshot to a restored planet.
  *
- * @return A pointer on the first planet.
+ * @param planet The planet.
+ * @param ring The ring, its node comes from the restored scene graph.
  ********************************************************************************/
-SolarSystem::Iterator SolarSystem::begin()
+void SolarSystem::restoreRing(Entity planet, const RingComponent &ring)
 {
-    return Iterator(_planets, 0);
+    _rings.add(planet, ring);
 }
 
 /**
- * @brief Returns the end value of the iterator.
+ * @brief Apply transformations on the matrices of a planet.
  *
- * @return A pointer on the end of the of planet container
+ * The local matrices are set and the world matrices of the subtree of the
+ * planet are computed again.
+ *
+ * @param planet The planet.
+ * @param rotation A float value that determines how much do we rotate.
+ * @param updateSatellites If true, then the satellites matrices are also
+ *                         updated.
  ********************************************************************************/
-SolarSystem::Iterator SolarSystem::end()
+void SolarSystem::updateMatrices(Entity planet, float rotation, bool updateSatellites)
 {
-    return Iterator(_planets, _planets.size());
+    auto &data = _orbits[planet].data;
+    auto &transform = _transforms[planet];
+
+    // Matrix describing the center of the planet, the reference of its satellites
+    float rotationDegree = data._rotationPeriod == 0 ? 0 : rotation * (1. / data._rotationPeriod);
+    float revolutionDegree = data._revolutionPeriod == 0 ? 0 : rotation * (1. / data._revolutionPeriod);
+    auto orbitMatrix = glm::rotate(glm::mat4(1), revolutionDegree, glm::vec3(0, 1, 0));                // Rotation around the central point (the sun)
+    orbitMatrix = glm::rotate(orbitMatrix, glm::radians(data._orbitInclination), glm::vec3(1, 0, 0)); // Planet's orbit inclination
+    orbitMatrix = glm::translate(orbitMatrix, glm::vec3(0, 0, data.getPosition()));                   // Distance from the central point (from the sun)
+    orbitMatrix = glm::rotate(orbitMatrix, glm::radians(data._angle), glm::vec3(-1, 0, 0));           // Planet's axial tilt
+
+    // The body turns on itself in the reference
+    auto bodyMatrix = glm::rotate(glm::mat4(1), rotationDegree - revolutionDegree, glm::vec3(0, 1, 0)); // Rotation on itself
+    bodyMatrix = glm::scale(bodyMatrix, glm::vec3(data._diameter, data._diameter, data._diameter));    // Size dimension
+
+    _sceneGraph.setLocalMatrix(transform.orbitNode, orbitMatrix);
+    _sceneGraph.setLocalMatrix(transform.bodyNode, bodyMatrix);
+
+    // Satellites update, relative to the reference of the planet
+    if (updateSatellites)
+    {
+        for (Entity satellite : getSatellites(planet))
+        {
+            updateSatelliteMatrix(satellite, rotation);
+        }
+    }
+
+    // The reference is computed once for the body, the ring and all the satellites
+    _sceneGraph.updateSubtree(transform.orbitNode);
 }
 
-/* ============================================== ITERATOR =============================================== */
+/**
+ * @brief Compute the matrix of a satellite relative to the orbit node of its planet.
+ *
+ * The world matrix is computed when the planet updates its subtree.
+ *
+ * @param satellite The satellite.
+ * @param rotation A float number that give information about the time spent.
+ ********************************************************************************/
+void SolarSystem::updateSatelliteMatrix(Entity satellite, float rotation)
+{
+    auto &data = _orbits[satellite].data;
+
+    float rotationDegree = data._rotationPeriod == 0 ? 0 : rotation * (1. / data._rotationPeriod);
+    float revolutionDegree = data._revolutionPeriod == 0 ? 0 : rotation * (1. / data._revolutionPeriod);
+    auto MVMatrix = glm::rotate(glm::mat4(1), glm::radians(data._orbitInclination), glm::vec3(1, 0, 0)); // The orbital tilt
+    MVMatrix = glm::rotate(MVMatrix, revolutionDegree, glm::vec3(0, 1, 0));                              // Rotation around the central point (the planet reference)
+
+    MVMatrix = glm::translate(MVMatrix, glm::vec3(0, 0, data.getPosition()));                    // Distance from the central point (from the planet)
+    MVMatrix = glm::rotate(MVMatrix, glm::radians(data._angle), glm::vec3(-1, 0, 0));            // Axial tilt
+    MVMatrix = glm::rotate(MVMatrix, rotationDegree - revolutionDegree, glm::vec3(0, 1, 0));     // Rotation on itself
+    MVMatrix = glm::scale(MVMatrix, glm::vec3(data._diameter, data._diameter, data._diameter)); // Size dimension
+
+    _sceneGraph.setLocalMatrix(_transforms[satellite].bodyNode, MVMatrix);
+}
 
 /**
- * @brief Constructor of the class.
+ * @brief Retrieves the model matrix of a body (its world matrix in the
+ *        scene graph).
  ********************************************************************************/
-SolarSystem::Iterator::Iterator(std::vector<std::unique_ptr<PlanetObject>> &vec, size_t index)
-    : planetsVec(&vec), currentIndex(index)
+const glm::mat4 &SolarSystem::getModelMatrix(Entity body) const
 {
+    return _sceneGraph.getWorldMatrix(_transforms[body].bodyNode);
 }
 
 /**
- * @brief Moves the pointer of the iterator on the next element
- * (after expression).
+ * @brief Retrieves the model matrix of the ring of a planet (its world matrix
+ *        in the scene graph).
  ********************************************************************************/
-SolarSystem::Iterator &SolarSystem::Iterator::operator++()
+const glm::mat4 &SolarSystem::getRingMatrix(Entity planet) const
 {
-    ++currentIndex;
-    return *this;
+    return _sceneGraph.getWorldMatrix(_rings[planet].node);
 }
 
 /**
- * @brief Moves the pointer of the iterator on the next element
- * (before expression).
+ * @brief Get the size of a body from its data.
  ********************************************************************************/
-SolarSystem::Iterator SolarSystem::Iterator::operator++(int)
+float SolarSystem::getSize(Entity body) const
 {
-    Iterator temp = *this;
-    ++(*this);
-    return temp;
+    return _orbits[body].data._diameter;
 }
 
 /**
- * @brief Comparison operator.
- *
- * Two iterators are equals if they points to the same index.
- *
- * @param other An iterator.
- *
- * @return True if the iterators are equals and False otherwise.
+ * @brief Returns wether or not a planet has a ring.
  ********************************************************************************/
-bool SolarSystem::Iterator::operator==(const Iterator &other) const
+bool SolarSystem::hasRing(Entity planet) const
 {
-    return currentIndex == other.currentIndex;
+    return _rings.has(planet);
 }
 
 /**
- * @brief Comparison operator (unequality).
- *
- * @param other An iterator.
- *
- * @return True if the iterators aren't equals and False otherwise.
+ * @brief Retrieves the satellites of a planet.
+ ********************************************************************************/
+EntityRange SolarSystem::getSatellites(Entity planet) const
+{
+    auto &hierarchy = _hierarchies[planet];
+    return EntityRange(hierarchy.firstChild, hierarchy.nbChildren);
+}
+
+/**
+ * @brief Retrieves the components of the bodies.
  ********************************************************************************/
-bool SolarSystem::Iterator::operator!=(const Iterator &other) const
+ComponentArray<OrbitComponent> &SolarSystem::getOrbits()
+{
+    return _orbits;
+}
+ComponentArray<TransformComponent> &SolarSystem::getTransforms()
+{
+    return _transforms;
+}
+ComponentArray<MaterialComponent> &SolarSystem::getMaterials()
+{
+    return _materials;
+}
+ComponentArray<HierarchyComponent> &SolarSystem::getHierarchies()
+{
+    return _hierarchies;
+}
+ComponentArray<RingComponent> &SolarSystem::getRings()
+{
+    return _rings;
+}
+const ComponentArray<OrbitComponent> &SolarSystem::getOrbits() const
 {
-    return !(*this == other);
+    return _orbits;
+}
+const ComponentArray<TransformComponent> &SolarSystem::getTransforms() const
+{
+    return _transforms;
+}
+const ComponentArray<MaterialComponent> &SolarSystem::getMaterials() const
+{
+    return _materials;
+}
+const ComponentArray<HierarchyComponent> &SolarSystem::getHierarchies() const
+{
+    return _hierarchies;
+}
+const ComponentArray<RingComponent> &SolarSystem::getRings() const
+{
+    return _rings;
 }
 
 /**
- * @brief Dereferencing operator.
+ * @brief Retrieves the transform hierarchy of the solar system.
+ ********************************************************************************/
+SceneGraph &SolarSystem::getSceneGraph()
+{
+    return _sceneGraph;
+}
+const SceneGraph &SolarSystem::getSceneGraph() const
+{
+    return _sceneGraph;
+}
+
+/**
+ * @brief Returns an iterator on the first planet.
+ ********************************************************************************/
+std::vector<Entity>::const_iterator SolarSystem::begin() const
+{
+    return _planets.begin();
+}
+
+/**
+ * @brief Returns an iterator after the last planet.
+ ********************************************************************************/
+std::vector<Entity>::const_iterator SolarSystem::end() const
+{
+    return _planets.end();
+}
+
+/**
+ * @brief Retrieves the amount of planets stored.
  *
- * @return The object stored in the pointer.
+ * @return The number of planets.
  ********************************************************************************/
-SolarSystem::Iterator::reference SolarSystem::Iterator::operator*() const
+unsigned int SolarSystem::nbPlanets() const
 {
-    return *planetsVec->at(currentIndex);
+    return _planets.size();
 }
 
 /**
- * @brief Arrow operator.
+ * @brief Retrieves the amount of bodies (planets and satellites) stored.
+ ********************************************************************************/
+unsigned int SolarSystem::nbBodies() const
+{
+    return _nbEntities;
+}
+
+/**
+ * @brief Retrieves the planet at the given index.
  *
- * @return The pointer that stores the object.
+ * @param index The index which must belong to the [0, size - 1] interval.
+ *
+ * @return The handle of the planet at the given index.
  ********************************************************************************/
-SolarSystem::Iterator::pointer SolarSystem::Iterator::operator->() const
+Entity SolarSystem::getPlanet(unsigned int index) const
 {
-    return planetsVec->at(currentIndex).get();
+    if (index >= _planets.size())
+    {
+        throw std::out_of_range("Index out of bounds");
+    }
+
+    return _planets[index];
 }
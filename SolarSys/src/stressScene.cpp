@@ -0,0 +1,230 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module makes up scenes of any size, without  =
+=  asset files, to find where the engine stops       =
+=  scaling.                                          =
+=													 =
+======================================================
+*/
+
+#include "include/stressScene.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    const uint64_t TEXTURE_SEED = ~0ull; // Seeds of the textures, counted down from it (the bodies count up from 0)
+    const unsigned int NOISE_CELLS = 16; // Cells of the noise across the width of a texture
+
+    const float EARTH_DISTANCE = 149597871; // Distance of the Earth from the sun (in km)
+    const float EARTH_YEAR = 365.256;       // Revolution period of the Earth (in Earth days)
+}
+
+/**
+ * @brief Constructor of the class.
+ *
+ * Throws a std::invalid_argument if a setting is out of its range.
+ *
+ * @param nbPlanets Amount of planets orbiting around the sun, at least 1.
+ * @param nbMoons Amount of satellites of each planet.
+ * @param nbRings Amount of planets with a ring, at most nbPlanets.
+ * @param textureSize Width of the textures (in texels), at most MAX_TEXTURE_SIZE.
+ * @param nbTextures Amount of textures shared by the bodies, at least 1.
+ ********************************************************************************/
+StressScene::StressScene(unsigned int nbPlanets, unsigned int nbMoons, unsigned int nbRings, unsigned int textureSize, unsigned int nbTextures)
+    : _nbPlanets{nbPlanets}, _nbMoons{nbMoons}, _nbRings{nbRings}, _textureSize{textureSize}, _nbTextures{nbTextures}
+{
+    if (nbPlanets == 0)
+    {
+        throw std::invalid_argument("A stress scene needs at least a planet");
+    }
+    if (getNbBodies() > std::numeric_limits<unsigned int>::max())
+    {
+        throw std::invalid_argument("Too many bodies in the stress scene");
+    }
+    if (nbRings > nbPlanets)
+    {
+        throw std::invalid_argument("More rings than planets in the stress scene");
+    }
+    if (textureSize < 2 || textureSize > MAX_TEXTURE_SIZE)
+    {
+        throw std::invalid_argument("The textures of a stress scene must be 2 to " + std::to_string(MAX_TEXTURE_SIZE) + " texels wide");
+    }
+    if (nbTextures == 0)
+    {
+        throw std::invalid_argument("A stress scene needs at least a texture");
+    }
+}
+
+/**
+ * @brief Retrieves the settings of the scene.
+ ********************************************************************************/
+unsigned int StressScene::getNbPlanets() const
+{
+    return _nbPlanets;
+}
+
+unsigned int StressScene::getNbMoons() const
+{
+    return _nbMoons;
+}
+
+unsigned int StressScene::getNbRings() const
+{
+    return _nbRings;
+}
+
+unsigned int StressScene::getTextureSize() const
+{
+    return _textureSize;
+}
+
+unsigned int StressScene::getNbTextures() const
+{
+    return _nbTextures;
+}
+
+/**
+ * @brief Retrieves the amount of bodies of the scene, the sun included.
+ ********************************************************************************/
+unsigned long long StressScene::getNbBodies() const
+{
+    return 1 + _nbPlanets * (1ull + _nbMoons);
+}
+
+/**
+ * @brief Tells if a planet has a ring.
+ *
+ * @param planet Index of the planet, in the [0, nbPlanets - 1] interval.
+ ********************************************************************************/
+bool StressScene::hasRing(unsigned int planet) const
+{
+    // One ring every nbPlanets / nbRings planets
+    return (planet + 1ull) * _nbRings / _nbPlanets != uint64_t(planet) * _nbRings / _nbPlanets;
+}
+
+/**
+ * @brief Makes up the data of a planet.
+ *
+ * @param planet Index of the planet, in the [0, nbPlanets - 1] interval.
+ ********************************************************************************/
+GeneratedData StressScene::createPlanetData(unsigned int planet) const
+{
+    uint64_t seed = uint64_t(planet) << 32;
+
+    float position = PlanetData::x0 + random(seed, 0) * (PlanetData::x1 - PlanetData::x0);
+    float diameter = 2000 * std::pow(70.f, random(seed, 1));  // From Pluto to Jupiter
+    float rotation = 10 * std::pow(100.f, random(seed, 2));   // From 10 hours to 40 days
+    float revolution = EARTH_YEAR * std::pow(position / EARTH_DISTANCE, 1.5f); // Third law of Kepler
+    float inclination = 7 * random(seed, 3);
+    float tilt = 30 * random(seed, 4);
+
+    // The ring starts out of the planet, like the ones of Saturn and Uranus
+    float ringDist = diameter * (0.55f + 0.15f * random(seed, 5));
+    float ringThickness = diameter * (0.1f + 0.5f * random(seed, 6));
+
+    return GeneratedData(rotation, diameter, position, inclination, tilt, revolution, hasRing(planet), ringDist, ringThickness);
+}
+
+/**
+ * @brief Makes up the data of a satellite.
+ *
+ * @param planet Index of its planet, in the [0, nbPlanets - 1] interval.
+ * @param moon Index of the satellite, in the [0, nbMoons - 1] interval.
+ ********************************************************************************/
+GeneratedData StressScene::createMoonData(unsigned int planet, unsigned int moon) const
+{
+    uint64_t seed = (uint64_t(planet) << 32) + moon + 1;
+    float planetDiameter = 2000 * std::pow(70.f, random(uint64_t(planet) << 32, 1)); // See createPlanetData()
+
+    // Out of the ring of the planet, at most a few planet diameters smaller than it
+    float position = planetDiameter * (2 + 28 * random(seed, 0)) + PlanetData::satelliteOffset;
+    float diameter = std::min(20 * std::pow(250.f, random(seed, 1)), planetDiameter / 3);
+    float revolution = 0.3f * std::pow(1000.f, random(seed, 2)); // From 7 hours to 300 days
+    float inclination = 30 * random(seed, 3);
+
+    // The satellite always shows the same side to its planet, like the Moon
+    return GeneratedData(revolution * 24, diameter, position, inclination, 0, revolution, false, 0, 0);
+}
+
+/**
+ * @brief Draws the textures and sends them to the GPU.
+ *
+ * Each texture has bands of a color of its own, broken by noise, like a
+ * gas giant. The bodies can use them as they are or as their ring.
+ *
+ * @return The IDs of the nbTextures textures.
+ ********************************************************************************/
+std::vector<GLuint> StressScene::createTextures() const
+{
+    const float PI = 3.14159265359f;
+    unsigned int width = _textureSize;
+    unsigned int height = std::max(_textureSize / 2, 1u);
+    unsigned int cellSize = std::max(width / NOISE_CELLS, 1u);
+    unsigned int nbCells = width / cellSize;
+
+    std::vector<GLuint> textures;
+    for (unsigned int i = 0; i < _nbTextures; i++)
+    {
+        uint64_t seed = TEXTURE_SEED - i;
+        glm::vec3 color(0.3f + 0.7f * random(seed, 0), 0.3f + 0.7f * random(seed, 1), 0.3f + 0.7f * random(seed, 2));
+        float frequency = 3 + 12 * random(seed, 3); // Bands from the pole to the other
+
+        // Noise at the corners of the cells, it wraps around the body
+        auto noise = [&](unsigned int cellX, unsigned int cellY)
+        {
+            return random(seed, 4 + (cellY * nbCells + cellX % nbCells));
+        };
+
+        auto image = std::make_unique<Image>(width, height);
+        glm::vec4 *pixel = image->getPixels();
+        for (unsigned int y = 0; y < height; y++)
+        {
+            unsigned int cellY = y / cellSize;
+            float v = float(y % cellSize) / cellSize;
+            for (unsigned int x = 0; x < width; x++, pixel++)
+            {
+                unsigned int cellX = x / cellSize;
+                float u = float(x % cellSize) / cellSize;
+                float value = glm::mix(glm::mix(noise(cellX, cellY), noise(cellX + 1, cellY), u),
+                                       glm::mix(noise(cellX, cellY + 1), noise(cellX + 1, cellY + 1), u), v);
+
+                float band = 0.5f + 0.5f * std::sin(2 * PI * frequency * y / height + 2 * value);
+                *pixel = glm::vec4(color * (0.55f + 0.45f * band), 1);
+            }
+        }
+        textures.push_back(loadTexture(std::move(image)));
+    }
+    return textures;
+}
+
+/**
+ * @brief Writes the settings as a JSON object.
+ ********************************************************************************/
+void StressScene::writeSettings(std::ostream &out) const
+{
+    out << "{\"planets\": " << _nbPlanets << ", \"moons\": " << _nbMoons << ", \"rings\": " << _nbRings
+        << ", \"textureSize\": " << _textureSize << ", \"textures\": " << _nbTextures << "}";
+}
+
+/**
+ * @brief Retrieves a pseudo random number in [0, 1), the same for the same
+ *        seed and index.
+ ********************************************************************************/
+float StressScene::random(uint64_t seed, uint64_t index)
+{
+    // SplitMix64 finalizer, every bit of the seed and of the index moves the result
+    uint64_t z = seed * 0x9E3779B97F4A7C15ull + index + 1;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (z >> 40) / float(1 << 24);
+}
@@ -29,8 +29,11 @@ GLuint loadTexture(std::unique_ptr<Image> ptrText)
     // Send the image texture to the GPU
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ptrText->getWidth(), ptrText->getHeight(), 0, GL_RGBA, GL_FLOAT, ptrText->getPixels());
 
+    // Reduced copies of the image, down to a single texel holding its average color (see the low detail shaders)
+    glGenerateMipmap(GL_TEXTURE_2D);
+
     // FIlters OPenGL will apply when using the texture
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     glBindTexture(GL_TEXTURE_2D, 0);
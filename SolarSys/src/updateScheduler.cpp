@@ -0,0 +1,177 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module decides which planets have their      =
+=  matrices updated each frame, from their motion    =
+=  on screen.                                        =
+=													 =
+======================================================
+*/
+
+#include "include/updateScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Starts a new frame.
+ *
+ * The motions measured before a switch of the distances (PlanetData::_largeView)
+ * or of the satellites update are dropped.
+ *
+ * @param viewMatrix View matrix of the previous frame.
+ * @param pixelScale Length on screen of one unit at a distance of one unit
+ *                   (see `RenderEngine::getPixelScale()`).
+ * @param updateSatellites If true, the satellites are updated with their planet.
+ ********************************************************************************/
+void UpdateScheduler::beginFrame(const glm::mat4 &viewMatrix, float pixelScale, bool updateSatellites)
+{
+    if (updateSatellites != _updateSatellites || PlanetData::_largeView != _largeView)
+    {
+        invalidate();
+    }
+
+    _viewMatrix = viewMatrix;
+    _pixelScale = pixelScale;
+    _updateSatellites = updateSatellites;
+    _largeView = PlanetData::_largeView;
+    _frame++;
+    _updateCount = 0;
+}
+
+/**
+ * @brief Updates the matrices of a planet if it is due.
+ *
+ * @param index Index of the planet in the solar system.
+ * @param solarSys The solar system storing the planet.
+ * @param planet The planet.
+ * @param time Simulated time the planet must reach (see `SolarSystem::updateMatrices()`).
+ *
+ * @return True if the planet was updated.
+ ********************************************************************************/
+bool UpdateScheduler::update(unsigned int index, SolarSystem &solarSys, Entity planet, float time)
+{
+    if (index >= _planets.size())
+    {
+        _planets.resize(index + 1);
+    }
+
+    if (_enabled && !isDue(index, time))
+    {
+        return false;
+    }
+
+    solarSys.updateMatrices(planet, time, _updateSatellites);
+    record(index, solarSys, planet, time);
+    _updateCount++;
+    return true;
+}
+
+/**
+ * @brief Forces the update of every planet on the next frame.
+ ********************************************************************************/
+void UpdateScheduler::invalidate()
+{
+    for (auto &state : _planets)
+    {
+        state.matrices.clear(); // Not comparable with the next ones
+        state.measured = false;
+    }
+}
+
+/**
+ * @brief Enables or disables the scheduling.
+ *
+ * @param enabled If false, every planet is updated every frame.
+ ********************************************************************************/
+void UpdateScheduler::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+/**
+ * @brief Retrieves the amount of planets updated during the current frame.
+ ********************************************************************************/
+unsigned int UpdateScheduler::getUpdateCount() const
+{
+    return _updateCount;
+}
+
+/**
+ * @brief Tells if a planet must be updated.
+ *
+ * @param index Index of the planet in the solar system.
+ * @param time Simulated time the planet must reach.
+ ********************************************************************************/
+bool UpdateScheduler::isDue(unsigned int index, float time) const
+{
+    auto &state = _planets[index];
+
+    // The forced updates come every MAX_STALENESS frames, on a frame depending on the index
+    if (!state.measured || (_frame + index) % MAX_STALENESS == 0)
+    {
+        return true;
+    }
+
+    float elapsed = std::abs(time - state.time);
+    for (size_t i = 0; i < state.matrices.size(); i++)
+    {
+        // The nearest point of the object moves the most on screen
+        glm::vec3 centerVC = _viewMatrix * state.matrices[i][3];
+        float radius = glm::length(glm::vec3(state.matrices[i][0])); // The sphere has a radius of 1 before being scaled
+        float distance = std::max(glm::length(centerVC) - radius, MIN_DISTANCE);
+
+        if (state.rates[i] * elapsed * _pixelScale / distance >= PIXEL_THRESHOLD)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Stores the matrices of a planet which has just been updated and
+ * measures the rates of its motion.
+ *
+ * @param index Index of the planet in the solar system.
+ * @param solarSys The solar system storing the planet.
+ * @param planet The planet.
+ * @param time Simulated time of the planet.
+ ********************************************************************************/
+void UpdateScheduler::record(unsigned int index, const SolarSystem &solarSys, Entity planet, float time)
+{
+    auto &state = _planets[index];
+
+    // The satellites are only updated with their planet in some modes
+    auto satellites = solarSys.getSatellites(planet);
+    size_t count = 1 + (_updateSatellites ? satellites.size() : 0);
+    bool comparable = state.matrices.size() == count;
+    float elapsed = std::abs(time - state.time);
+
+    state.matrices.resize(count);
+    state.rates.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        const glm::mat4 &matrix = solarSys.getModelMatrix(i == 0 ? planet : *satellites.begin() + i - 1); // The satellites follow their planet
+
+        // A point of the unit sphere moves less than the sum of the motions of the columns
+        if (comparable && elapsed > 0)
+        {
+            glm::mat4 delta = matrix - state.matrices[i];
+            float motion = 0;
+            for (int column = 0; column < 4; column++)
+            {
+                motion += glm::length(glm::vec3(delta[column]));
+            }
+            state.rates[i] = motion / elapsed;
+        }
+        state.matrices[i] = matrix;
+    }
+
+    // Nothing is learnt from a paused simulation, the previous rates are kept
+    state.measured = state.measured || (comparable && elapsed > 0);
+    state.time = time;
+}
@@ -10,6 +10,7 @@
 */
 
 #include "include/window.hpp"
+#include "include/profiler.hpp"
 
 /**
  * @brief Displays the error that occured on the window.
@@ -28,10 +29,14 @@ void Window::onError(int code, const char *desc)
  *
  * @warning This must be called before the creation of the window
  *
+ * @param headless If true, the window is hidden. It needs no display at all
+ *                 when GLFW is built with GLFW_USE_OSMESA (software rendering).
+ *
  * @return A code error telling if the initialization is successfull or not.
  ********************************************************************************/
-int Window::initWindowLib()
+int Window::initWindowLib(bool headless)
 {
+    _headless = headless;
 
     if (!glfwInit())
     {
@@ -77,23 +82,32 @@ bool Window::isWindowOpen()
 void Window::manageWindow()
 {
     /* Swap front and back buffers */
-    glfwSwapBuffers(_window);
+    {
+        PROFILE_ZONE("Swap");
+        glfwSwapBuffers(_window);
+    }
 
     // Check the possible events that occured
+    PROFILE_ZONE("Events");
     glfwPollEvents();
 }
 
 /**
- * @brief Creates a window.
+ * @brief Enables or disables the synchronization of the swaps with the
+ *        refresh of the screen.
  *
- * @param width Width dimension of the window.
- * @param height Height dimension of the window.
- * @param title A char array that represents the title of the window.
+ * @param enabled If false, the frames are shown as soon as they are rendered.
  ********************************************************************************/
-Window::Window(unsigned int width, unsigned int height, const char *title)
+void Window::setVSync(bool enabled)
 {
+    glfwSwapInterval(enabled ? 1 : 0);
+}
 
-    /* Create a window and its OpenGL context */
+/**
+ * @brief Sets the hints of the window and of its context.
+ ********************************************************************************/
+void Window::setWindowHints()
+{
 #ifdef __APPLE__
     /* We need to explicitly ask for a 3.3 context on Mac */
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -102,6 +116,22 @@ Window::Window(unsigned int width, unsigned int height, const char *title)
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif
 
+    glfwWindowHint(GLFW_VISIBLE, _headless ? GLFW_FALSE : GLFW_TRUE);
+}
+
+/**
+ * @brief Creates a window.
+ *
+ * @param width Width dimension of the window.
+ * @param height Height dimension of the window.
+ * @param title A char array that represents the title of the window.
+ ********************************************************************************/
+Window::Window(unsigned int width, unsigned int height, const char *title)
+{
+
+    /* Create a window and its OpenGL context */
+    setWindowHints();
+
     // Useful to get errors in the window management
     // glfwSetErrorCallback(onError);
 
@@ -123,6 +153,7 @@ Window::Window(unsigned int width, unsigned int height, const char *title)
     {
         return;
     }
+    glimac::loadExtensions((GLADloadproc)glfwGetProcAddress); // Functions newer than the ones loaded by glad
 
     _state = true;
 }
@@ -0,0 +1,31 @@
+#version 330 core
+
+layout(location = 0) in vec3 aVertexPosition;
+layout(location = 1) in vec3 aVertexNormal;
+layout(location = 2) in vec2 aVertexTexCoords;
+
+// Data shared by every object of the frame
+layout(std140) uniform FrameBlock {
+  mat4 uViewMatrix;
+  mat4 uProjMatrix;
+  vec4 uLightPos;       // View coordinates
+  vec4 uLightIntensity;
+  vec4 uAmbientLight;
+};
+
+uniform mat4 uMVMatrix;
+uniform mat4 uNormalMatrix;
+
+out vec4 vVertexPositionVC;
+out vec4 vVertexNormalVC;
+out vec2 vFragText;
+
+
+void main() {
+  // View Coordinates position and normals
+  vVertexPositionVC = uMVMatrix * vec4(aVertexPosition, 1);
+  vVertexNormalVC = uNormalMatrix * vec4(aVertexNormal, 0);
+  
+  vFragText = aVertexTexCoords;
+  gl_Position = uProjMatrix * vVertexPositionVC;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#version 430 core
+
+// One invocation per body
+layout(local_size_x = 64) in;
+
+// Data shared by every object of the frame
+layout(std140) uniform FrameBlock {
+  mat4 uViewMatrix;
+  mat4 uProjMatrix;
+  vec4 uLightPos;       // View coordinates
+  vec4 uLightIntensity;
+  vec4 uAmbientLight;
+};
+
+struct Body {
+  mat4 modelMatrix;
+  vec4 boundingSphere;  // Model coordinates, w: radius
+  vec4 material;        // x: first texture layer, y: second texture layer
+};
+
+// Same layout as DrawElementsIndirectCommand
+struct DrawCommand {
+  uint count;
+  uint instanceCount;
+  uint firstIndex;
+  int baseVertex;
+  uint baseInstance;
+};
+
+struct LevelOfDetail {
+  uint indexCount;
+  uint firstIndex;
+  int baseVertex;
+  float minPixelRadius; // Smallest radius on screen (in pixels) using this level
+};
+
+layout(std430, binding = 0) readonly buffer BodyBuffer {
+  Body bodies[];
+};
+
+layout(std430, binding = 1) writeonly buffer CommandBuffer {
+  DrawCommand commands[];
+};
+
+layout(std430, binding = 2) readonly buffer LodBuffer {
+  LevelOfDetail lods[];  // From the most to the least detailed
+};
+
+uniform uint uBodyCount;
+uniform uint uLodCount;
+uniform vec4 uFrustumPlanes[6]; // World coordinates, normals toward the inside
+uniform float uViewportHeight;
+
+void main() {
+  uint index = gl_GlobalInvocationID.x;
+  if(index >= uBodyCount){
+    return;
+  }
+
+  Body body = bodies[index];
+
+  // Bounding sphere in world coordinates
+  vec3 center = (body.modelMatrix * vec4(body.boundingSphere.xyz, 1)).xyz;
+  float scale = max(length(body.modelMatrix[0].xyz), max(length(body.modelMatrix[1].xyz), length(body.modelMatrix[2].xyz)));
+  float radius = body.boundingSphere.w * scale;
+
+  bool visible = true;
+  for(int i = 0; i < 6; i++){
+    visible = visible && (dot(uFrustumPlanes[i].xyz, center) + uFrustumPlanes[i].w >= -radius);
+  }
+
+  // Radius of the body on the screen, the camera inside the sphere gets the best level
+  float distanceVC = length((uViewMatrix * vec4(center, 1)).xyz);
+  float pixelRadius = (distanceVC <= radius) ? 1e30 : radius * uProjMatrix[1][1] * 0.5 * uViewportHeight / distanceVC;
+
+  uint lod = uLodCount - 1;
+  for(uint i = 0; i < uLodCount; i++){
+    if(pixelRadius >= lods[i].minPixelRadius){
+      lod = i;
+      break;
+    }
+  }
+
+  DrawCommand command;
+  command.count = lods[lod].indexCount;
+  command.instanceCount = visible ? 1 : 0;
+  command.firstIndex = lods[lod].firstIndex;
+  command.baseVertex = lods[lod].baseVertex;
+  command.baseInstance = index; // Used by the vertex shader to find the body
+  commands[index] = command;
+}
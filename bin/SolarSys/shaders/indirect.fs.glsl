@@ -0,0 +1,61 @@
+#version 430 core
+
+// Every texture of the bodies, one per layer
+uniform sampler2DArray uTexture;
+
+layout(std140) uniform FrameBlock {
+  mat4 uViewMatrix;
+  mat4 uProjMatrix;
+  vec4 uLightPos;       // View coordinates
+  vec4 uLightIntensity;
+  vec4 uAmbientLight;
+};
+
+// Material
+layout(std140) uniform MaterialBlock {
+  vec4 uKd;
+  vec4 uKs;             // w: shininess
+};
+
+in vec4 vVertexPositionVC;
+in vec4 vVertexNormalVC;
+
+in vec2 vFragText;
+flat in vec4 vMaterial; // x: first texture layer, y: second texture layer, z: lighted
+
+out vec4 fFragColor;
+
+// Computes the fragment color
+vec3 blinnPhong(){
+  vec3 wi = normalize(uLightPos.xyz - vVertexPositionVC.xyz);
+  float d = distance(uLightPos.xyz, vVertexPositionVC.xyz);
+  vec3 li = uLightIntensity.rgb / (d * 1);
+  vec3 wo = normalize(-vVertexPositionVC.xyz);
+  vec3 halfV = (wo + wi) / 2;
+  vec3 n = normalize(vVertexNormalVC.xyz);
+
+  vec3 a = uKd.rgb * dot(wi, n);
+  vec3 b = uKs.rgb * pow(dot(halfV, n), uKs.w);
+  vec3 formula = li * (a + b);
+
+  // Not really an ambient light but closer to a minimum light factor
+  formula.x = (formula.x < uAmbientLight.x) ? uAmbientLight.x : formula.x;
+  formula.y = (formula.y < uAmbientLight.y) ? uAmbientLight.y : formula.y;
+  formula.z = (formula.z < uAmbientLight.z) ? uAmbientLight.z : formula.z;
+
+  return formula;
+}
+
+void main() {
+    // A negative layer means the texture couldn't be loaded
+    vec4 text = (vMaterial.x < 0) ? vec4(0, 0, 0, 1) : texture(uTexture, vec3(vFragText, vMaterial.x));
+    if(vMaterial.y >= 0){
+      text += texture(uTexture, vec3(vFragText, vMaterial.y));
+    }
+
+    if(vMaterial.z != 0){
+      fFragColor = text * vec4(blinnPhong() , 1);
+    }else{
+      fFragColor =  text;
+    }
+}
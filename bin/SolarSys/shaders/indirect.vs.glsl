@@ -0,0 +1,45 @@
+#version 430 core
+
+layout(location = 0) in vec3 aVertexPosition;
+layout(location = 1) in vec3 aVertexNormal;
+layout(location = 2) in vec2 aVertexTexCoords;
+layout(location = 3) in uint aBodyIndex; // Per instance, starts at the baseInstance of the draw
+
+// Data shared by every object of the frame
+layout(std140) uniform FrameBlock {
+  mat4 uViewMatrix;
+  mat4 uProjMatrix;
+  vec4 uLightPos;       // View coordinates
+  vec4 uLightIntensity;
+  vec4 uAmbientLight;
+};
+
+struct Body {
+  mat4 modelMatrix;
+  vec4 boundingSphere;  // Model coordinates, w: radius
+  vec4 material;        // x: first texture layer, y: second texture layer
+};
+
+layout(std430, binding = 0) readonly buffer BodyBuffer {
+  Body bodies[];
+};
+
+out vec4 vVertexPositionVC;
+out vec4 vVertexNormalVC;
+out vec2 vFragText;
+flat out vec2 vLayers; // Read by body.fs.glsl (INDIRECT)
+
+
+void main() {
+  Body body = bodies[aBodyIndex];
+  mat4 MVMatrix = uViewMatrix * body.modelMatrix;
+
+  // View Coordinates position and normals
+  // The bodies are only rotated and uniformly scaled, the normals follow the model-view matrix
+  vVertexPositionVC = MVMatrix * vec4(aVertexPosition, 1);
+  vVertexNormalVC = vec4(normalize(mat3(MVMatrix) * aVertexNormal), 0);
+
+  vFragText = aVertexTexCoords;
+  vLayers = body.material.xy;
+  gl_Position = uProjMatrix * vVertexPositionVC;
+}
@@ -0,0 +1,32 @@
+#version 330 core
+
+// Body smaller than a pixel drawn as a single point, shaded by body.fs.glsl (AVERAGE_COLOR)
+// No vertex attribute is read: drawn with glDrawArrays(GL_POINTS, 0, 1)
+
+// Data shared by every object of the frame
+layout(std140) uniform FrameBlock {
+  mat4 uViewMatrix;
+  mat4 uProjMatrix;
+  vec4 uLightPos;       // View coordinates
+  vec4 uLightIntensity;
+  vec4 uAmbientLight;
+};
+
+uniform mat4 uMVMatrix; // Sphere of radius 1 centered on the origin in model coordinates
+
+out vec4 vVertexPositionVC;
+out vec4 vVertexNormalVC;
+out vec2 vFragText;
+
+void main() {
+  vec3 center = uMVMatrix[3].xyz;
+  float radius = length(uMVMatrix[0].xyz); // The scale is uniform
+
+  // The point stands for the side of the sphere facing the eye, which is at the origin
+  vec3 toEye = -normalize(center);
+
+  vVertexPositionVC = vec4(center + toEye * radius, 1);
+  vVertexNormalVC = vec4(toEye, 0);
+  vFragText = vec2(0.5); // Unused, the average color doesn't depend on it
+  gl_Position = uProjMatrix * vVertexPositionVC;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Constants of the entry points that are newer than the OpenGL version loaded by glad
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_DYNAMIC_STORAGE_BIT
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+#ifndef GL_LOWER_LEFT
+#define GL_LOWER_LEFT 0x8CA1
+#endif
+#ifndef GL_ZERO_TO_ONE
+#define GL_ZERO_TO_ONE 0x935F
+#endif
+
+namespace glimac {
+
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+typedef void (APIENTRYP PFNGLCLIPCONTROLPROC)(GLenum origin, GLenum depth);
+
+// The loaded entry points, null when unavailable (like the glad_gl* ones, the GLInterceptor can wrap them)
+extern PFNGLBUFFERSTORAGEPROC ext_glBufferStorage;
+extern PFNGLMAXSHADERCOMPILERTHREADSPROC ext_glMaxShaderCompilerThreads;
+extern PFNGLCLIPCONTROLPROC ext_glClipControl;
+
+// Load the entry points glad doesn't know about (the context must be current)
+void loadExtensions(GLADloadproc load);
+
+// Tell if the context is at least the given OpenGL version
+bool hasVersion(int major, int minor);
+
+// Tell if the context exposes the given extension (ex: "GL_ARB_buffer_storage")
+bool hasExtension(const char* name);
+
+// glBufferStorage (OpenGL 4.4 or GL_ARB_buffer_storage)
+bool hasBufferStorage();
+void bufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+// glMaxShaderCompilerThreadsKHR (GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile),
+// GL_COMPLETION_STATUS_KHR can be queried on shaders and programs when it is available
+bool hasParallelShaderCompile();
+void maxShaderCompilerThreads(GLuint count);
+
+// glClipControl (OpenGL 4.5 or GL_ARB_clip_control), with GL_ZERO_TO_ONE the clip depth
+// goes to the depth buffer without the [-1, 1] to [0, 1] remapping losing the float precision
+bool hasClipControl();
+void clipControl(GLenum origin, GLenum depth);
+
+}
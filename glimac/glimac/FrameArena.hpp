@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace glimac {
+
+// Linear allocator for the data living during a single frame.
+// An allocation moves a pointer forward in the region of the current frame and nothing is
+// released one by one: nextFrame() moves to the region of the next frame and empties it.
+// A region is only reused bufferCount frames later, so the data of the previous frames can
+// still be read while the current one is built.
+// Each thread has its own arena (local()), an allocation takes no lock. nextFrameAll() moves
+// all of them at once and must be called when no other thread allocates (end of the frame).
+// An allocation which doesn't fit in the region goes to the heap and is counted as an
+// overflow: a capacity too small shows up in the stats instead of crashing. The next frame
+// moves to larger regions, which hold everything the frame allocated: the capacity follows
+// the scene (ex: a draw packet per body) after a single frame. The previous regions are
+// released once their frames can't be read anymore.
+class FrameArena {
+public:
+	static const std::size_t DEFAULT_CAPACITY = 1 << 20; // Bytes of a region, before it grows
+	static const unsigned int DEFAULT_BUFFER_COUNT = 2;
+
+	FrameArena(std::size_t capacity = DEFAULT_CAPACITY, unsigned int bufferCount = DEFAULT_BUFFER_COUNT);
+
+	// Memory in the region of the current frame, valid until the region is reused
+	void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+	template<typename T>
+	T* allocate(std::size_t count) {
+		return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+	}
+
+	// Only the overflows are released, the memory of the regions is reclaimed by nextFrame()
+	void deallocate(void* pointer, std::size_t alignment = alignof(std::max_align_t));
+
+	// Move to the region of the next frame and empty it, larger regions are made if the frame overflowed
+	void nextFrame();
+
+	// True for the memory of the regions, including the ones replaced by larger regions but still readable
+	bool owns(const void* pointer) const;
+
+	// Bytes allocated in the region of the current frame
+	std::size_t getUsed() const {
+		return m_pTop - m_pBegin;
+	}
+
+	// Most bytes a frame has allocated in its region
+	std::size_t getHighWaterMark() const {
+		return m_nHighWaterMark;
+	}
+
+	std::size_t getCapacity() const {
+		return m_nCapacity;
+	}
+
+	unsigned int getBufferCount() const {
+		return m_nBufferCount;
+	}
+
+	// Amount of allocations which didn't fit and went to the heap
+	unsigned int getOverflowCount() const {
+		return m_nOverflowCount;
+	}
+
+	// Arena of the calling thread, created on its first use
+	static FrameArena& local();
+
+	// Move the arenas of all the threads to the next frame
+	static void nextFrameAll();
+
+	// Highest high-water mark, largest capacity and total overflows of the arenas of all the threads
+	static std::size_t getGlobalHighWaterMark();
+	static std::size_t getGlobalCapacity();
+	static unsigned int getGlobalOverflowCount();
+
+private:
+	FrameArena(const FrameArena&);
+	FrameArena& operator =(const FrameArena&);
+
+	// Regions replaced by larger ones, kept while the data of their frames can be read
+	struct RetiredMemory {
+		std::unique_ptr<char[]> m_pMemory;
+		std::size_t m_nSize;
+		unsigned int m_nFrameCount; // Frames left before the release
+	};
+
+	static bool contains(const char* memory, std::size_t size, const void* pointer) {
+		return pointer >= memory && pointer < memory + size;
+	}
+
+	std::unique_ptr<char[]> m_pMemory; // Every region, one after the other
+	std::size_t m_nCapacity;
+	unsigned int m_nBufferCount;
+	unsigned int m_nCurrentBuffer = 0;
+	char* m_pBegin; // Start of the region of the current frame
+	char* m_pTop;   // Next free byte
+	char* m_pEnd;   // End of the region of the current frame
+	std::size_t m_nHighWaterMark = 0;
+	unsigned int m_nOverflowCount = 0;
+	std::size_t m_nOverflowSize = 0; // Bytes which went to the heap during the current frame
+	std::vector<RetiredMemory> m_RetiredMemory;
+};
+
+// Allocator of the standard containers, the memory is taken from a frame arena.
+// The container must not outlive the frame (or the bufferCount - 1 next ones).
+template<typename T>
+class FrameAllocator {
+public:
+	typedef T value_type;
+
+	// Arena of the calling thread
+	FrameAllocator():
+		m_pArena(&FrameArena::local()) {
+	}
+
+	explicit FrameAllocator(FrameArena& arena):
+		m_pArena(&arena) {
+	}
+
+	template<typename U>
+	FrameAllocator(const FrameAllocator<U>& other):
+		m_pArena(other.getArena()) {
+	}
+
+	T* allocate(std::size_t count) {
+		return m_pArena->allocate<T>(count);
+	}
+
+	void deallocate(T* pointer, std::size_t) {
+		m_pArena->deallocate(pointer, alignof(T));
+	}
+
+	FrameArena* getArena() const {
+		return m_pArena;
+	}
+
+private:
+	FrameArena* m_pArena;
+};
+
+template<typename T, typename U>
+bool operator ==(const FrameAllocator<T>& lhs, const FrameAllocator<U>& rhs) {
+	return lhs.getArena() == rhs.getArena();
+}
+
+template<typename T, typename U>
+bool operator !=(const FrameAllocator<T>& lhs, const FrameAllocator<U>& rhs) {
+	return !(lhs == rhs);
+}
+
+// Temporary vector of a frame
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <ostream>
+
+#include "FilePath.hpp"
+#include "GLTrace.hpp"
+
+namespace glimac {
+
+// Wraps the OpenGL entry points listed in GLTrace.hpp to see the calls of each frame.
+//
+// install() replaces the glad_gl* and ext_gl* pointers with wrappers, the code calling
+// OpenGL doesn't change. Each call is counted by entry point, and the binds of what is
+// already bound (buffer, texture, vertex array, program, framebuffer...) are counted as
+// redundant. The counts of a frame are added up by endFrame().
+//
+// Between startCapture() and stopCapture() every call is also written to a binary trace
+// (see GLTrace.hpp) with the data it reads: buffer and texture contents, uniforms, shader
+// sources... The GLReplayer plays it again without the engine. The capture must start
+// right after install(), the trace creates every object it uses. The writes through a
+// mapped buffer are found by comparing it with a copy of its last contents before each
+// draw, a capture is much slower than a normal run.
+//
+// Not thread safe, the thread owning the context makes every call.
+//
+// Usage:
+//     gladLoadGLLoader(...); loadExtensions(...);
+//     GLInterceptor::install();
+//     GLInterceptor::startCapture("trace.bin", width, height); // Optional
+//     each frame: ... draw ...; swap(); GLInterceptor::endFrame();
+//     GLInterceptor::stopCapture();
+//     GLInterceptor::printStats(std::cout);
+//     GLInterceptor::uninstall();
+class GLInterceptor {
+public:
+	// Wrap the loaded entry points (after glad and loadExtensions())
+	static void install();
+
+	// Give the original entry points back, before the context is destroyed
+	static void uninstall();
+
+	static bool isInstalled();
+
+	// Start writing every call to a trace, false if the file can't be created
+	// width and height are the size of the window, the replay opens one of the same size
+	static bool startCapture(const FilePath& path, unsigned int width, unsigned int height);
+
+	// Finish the trace, false if it couldn't be written entirely
+	static bool stopCapture();
+
+	static bool isCapturing();
+
+	// Add up the counts of the frame, and mark its end in the trace
+	static void endFrame();
+
+	// Forget the counts of the previous frames (ex: the calls of the loading)
+	static void resetStats();
+
+	// Frames added up since the install or the last resetStats()
+	static unsigned long long getFrameCount();
+
+	// Calls of an entry point during the last frame ended, and how many were redundant binds
+	static unsigned int getFrameCalls(GLEntryPoint entry);
+	static unsigned int getFrameRedundantBinds(GLEntryPoint entry);
+
+	// Average counts per frame, by category then by entry point
+	static void printStats(std::ostream& out);
+
+	// Same as printStats() as a JSON object
+	static void writeStats(std::ostream& out);
+};
+
+}
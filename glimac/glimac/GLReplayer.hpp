@@ -0,0 +1,102 @@
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "FilePath.hpp"
+#include "GLTrace.hpp"
+
+namespace glimac {
+
+// Plays a trace written by the GLInterceptor (see GLTrace.hpp) again, on the current context.
+//
+// The objects are created again from the calls, the names of the recording context are
+// translated to the ones of this context, and the writes through the mapped buffers are
+// copied to the new mappings. The calls reading values back are made with scratch memory.
+// The program binaries in the trace only load on the driver which wrote them, a program
+// compiled from its sources is replayed on any driver.
+//
+// Usage:
+//     GLReplayer replayer("trace.bin"); // Throws if it can't be read
+//     ... create a context of replayer.getWidth() x getHeight(), load glad and the extensions ...
+//     while(replayer.replayFrame()) swap();
+class GLReplayer {
+public:
+	// Open a trace, throw a std::runtime_error if it isn't one or if its entry points
+	// aren't the ones of GLTrace.hpp
+	explicit GLReplayer(const FilePath& path);
+
+	unsigned int getWidth() const {
+		return m_nWidth;
+	}
+
+	unsigned int getHeight() const {
+		return m_nHeight;
+	}
+
+	// Make the calls up to the end of the next frame, false once the trace is over
+	// Throws a std::runtime_error if the trace is cut or damaged
+	bool replayFrame();
+
+	// Calls made since the opening, and the calls skipped because the entry point isn't loaded
+	unsigned long long getCallCount() const {
+		return m_nCallCount;
+	}
+
+	unsigned long long getSkippedCount() const {
+		return m_nSkippedCount;
+	}
+
+private:
+	GLReplayer(const GLReplayer&);
+	GLReplayer& operator =(const GLReplayer&);
+
+	void read(void* data, std::size_t size);
+
+	template <typename T>
+	T read() {
+		T value;
+		read(&value, sizeof(T));
+		return value;
+	}
+
+	void replayCall(GLEntryPoint entry);
+
+	void replayBufferWrite();
+
+	// Slot of m_BoundBuffers of a target
+	std::pair<uint64_t, uint64_t> getBufferSlot(uint64_t target) const;
+
+	// Name of this context for a name of the recording context, of the kind given by its role
+	uint64_t translate(char role, uint64_t name) const;
+
+	// Key of a uniform location ('u') or block index ('k'): role, program and value of the recording context
+	typedef std::tuple<char, uint64_t, uint64_t> UniformKey;
+
+	std::ifstream m_File;
+	unsigned int m_nWidth = 0;
+	unsigned int m_nHeight = 0;
+
+	std::unordered_map<uint64_t, uint64_t> m_Names[9]; // Recorded to replayed, for each kind of "btvfrqspy"
+	std::map<UniformKey, uint64_t> m_Uniforms;
+	uint64_t m_nCurrentProgram = 0; // Recorded names
+	uint64_t m_nCurrentVertexArray = 0;
+	std::map<std::pair<uint64_t, uint64_t>, uint64_t> m_BoundBuffers; // Recorded names, by target and vertex array
+	std::unordered_map<uint64_t, char*> m_Mappings; // Pointers of this context, by recorded buffer
+
+	// Storage of the arguments of a call, reused from call to call
+	std::vector<char> m_Payloads[GLEntryPointInfo::MAX_ARGS];
+	std::vector<GLuint> m_NameArrays[GLEntryPointInfo::MAX_ARGS];
+	std::vector<std::string> m_Strings;
+	std::vector<const GLchar*> m_StringPointers;
+	std::vector<GLint> m_StringLengths;
+
+	unsigned long long m_nCallCount = 0;
+	unsigned long long m_nSkippedCount = 0;
+};
+
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <glad/glad.h>
+
+#include "Extensions.hpp"
+
+namespace glimac {
+
+// Entry points of OpenGL wrapped by the GLInterceptor and replayed by the GLReplayer:
+// the ones the engine calls, through glad (glad_gl*) or through the extensions (ext_gl*).
+//
+// X(name, pointer, category, roles), the roles tell how each value goes to the trace,
+// one character for the returned value then one for each argument:
+//     .            Copied as is (a pointer is an offset in the bound buffer)
+//     b t v f r q  Name of a buffer, texture, vertex array, framebuffer, renderbuffer
+//     s p y        or query, of a shader, program or sync, translated by the replay
+//     B T V F R Q  Array of as many names as the first argument (generated or deleted)
+//     u            Uniform location of the first argument if it's a program, else of the current program
+//     k            Uniform block index of the program given as first argument
+//     d            Data read by the call, its size is given by getPayloadSize() (can be null)
+//     z            Null-terminated string read by the call
+//     S L          Strings of glShaderSource and their lengths
+//     o            Data written by the call, the replay gives it scratch memory
+//     m            Pointer to a mapping of the buffer bound to the target given as first argument
+#define GLIMAC_GL_ENTRY_POINTS(X) \
+	/* Draws */ \
+	X(glDrawArrays, glad_glDrawArrays, Draw, "....") \
+	X(glDrawElementsBaseVertex, glad_glDrawElementsBaseVertex, Draw, "......") \
+	X(glMultiDrawElementsIndirect, glad_glMultiDrawElementsIndirect, Draw, "......") \
+	X(glDispatchCompute, glad_glDispatchCompute, Draw, "....") \
+	X(glClear, glad_glClear, Draw, "..") \
+	X(glBlitFramebuffer, glad_glBlitFramebuffer, Draw, "...........") \
+	/* State changes */ \
+	X(glBindBuffer, glad_glBindBuffer, StateChange, "..b") \
+	X(glBindBufferBase, glad_glBindBufferBase, StateChange, "...b") \
+	X(glBindBufferRange, glad_glBindBufferRange, StateChange, "...b..") \
+	X(glActiveTexture, glad_glActiveTexture, StateChange, "..") \
+	X(glBindTexture, glad_glBindTexture, StateChange, "..t") \
+	X(glBindVertexArray, glad_glBindVertexArray, StateChange, ".v") \
+	X(glBindFramebuffer, glad_glBindFramebuffer, StateChange, "..f") \
+	X(glBindRenderbuffer, glad_glBindRenderbuffer, StateChange, "..r") \
+	X(glUseProgram, glad_glUseProgram, StateChange, ".p") \
+	X(glEnable, glad_glEnable, StateChange, "..") \
+	X(glDisable, glad_glDisable, StateChange, "..") \
+	X(glDepthFunc, glad_glDepthFunc, StateChange, "..") \
+	X(glClearDepth, glad_glClearDepth, StateChange, "..") \
+	X(glViewport, glad_glViewport, StateChange, ".....") \
+	X(glClipControl, ext_glClipControl, StateChange, "...") \
+	X(glEnableVertexAttribArray, glad_glEnableVertexAttribArray, StateChange, "..") \
+	X(glVertexAttribPointer, glad_glVertexAttribPointer, StateChange, ".......") \
+	X(glVertexAttribIPointer, glad_glVertexAttribIPointer, StateChange, "......") \
+	X(glVertexAttribDivisor, glad_glVertexAttribDivisor, StateChange, "...") \
+	X(glTexParameteri, glad_glTexParameteri, StateChange, "....") \
+	X(glUniformBlockBinding, glad_glUniformBlockBinding, StateChange, ".pk.") \
+	X(glFramebufferRenderbuffer, glad_glFramebufferRenderbuffer, StateChange, "....r") \
+	X(glFramebufferTexture2D, glad_glFramebufferTexture2D, StateChange, "....t.") \
+	X(glFramebufferTextureLayer, glad_glFramebufferTextureLayer, StateChange, "...t..") \
+	X(glMemoryBarrier, glad_glMemoryBarrier, StateChange, "..") \
+	X(glProgramParameteri, glad_glProgramParameteri, StateChange, ".p..") \
+	X(glMaxShaderCompilerThreadsKHR, ext_glMaxShaderCompilerThreads, StateChange, "..") \
+	/* Uniform uploads */ \
+	X(glUniform1i, glad_glUniform1i, Uniform, ".u.") \
+	X(glUniform1ui, glad_glUniform1ui, Uniform, ".u.") \
+	X(glUniform1f, glad_glUniform1f, Uniform, ".u.") \
+	X(glUniform2i, glad_glUniform2i, Uniform, ".u..") \
+	X(glUniform2fv, glad_glUniform2fv, Uniform, ".u.d") \
+	X(glUniform4fv, glad_glUniform4fv, Uniform, ".u.d") \
+	X(glUniformMatrix4fv, glad_glUniformMatrix4fv, Uniform, ".u..d") \
+	/* Transfers of data */ \
+	X(glBufferData, glad_glBufferData, Transfer, "...d.") \
+	X(glBufferSubData, glad_glBufferSubData, Transfer, "....d") \
+	X(glBufferStorage, ext_glBufferStorage, Transfer, "...d.") \
+	X(glGetBufferSubData, glad_glGetBufferSubData, Transfer, "....o") \
+	X(glCopyBufferSubData, glad_glCopyBufferSubData, Transfer, "......") \
+	X(glMapBufferRange, glad_glMapBufferRange, Transfer, "m....") \
+	X(glUnmapBuffer, glad_glUnmapBuffer, Transfer, "..") \
+	X(glTexImage2D, glad_glTexImage2D, Transfer, ".........d") \
+	X(glTexStorage3D, glad_glTexStorage3D, Transfer, ".......") \
+	X(glGenerateMipmap, glad_glGenerateMipmap, Transfer, "..") \
+	X(glRenderbufferStorage, glad_glRenderbufferStorage, Transfer, ".....") \
+	/* Objects */ \
+	X(glGenBuffers, glad_glGenBuffers, Object, "..B") \
+	X(glGenTextures, glad_glGenTextures, Object, "..T") \
+	X(glGenVertexArrays, glad_glGenVertexArrays, Object, "..V") \
+	X(glGenFramebuffers, glad_glGenFramebuffers, Object, "..F") \
+	X(glGenRenderbuffers, glad_glGenRenderbuffers, Object, "..R") \
+	X(glGenQueries, glad_glGenQueries, Object, "..Q") \
+	X(glDeleteBuffers, glad_glDeleteBuffers, Object, "..B") \
+	X(glDeleteTextures, glad_glDeleteTextures, Object, "..T") \
+	X(glDeleteVertexArrays, glad_glDeleteVertexArrays, Object, "..V") \
+	X(glDeleteFramebuffers, glad_glDeleteFramebuffers, Object, "..F") \
+	X(glDeleteRenderbuffers, glad_glDeleteRenderbuffers, Object, "..R") \
+	X(glDeleteQueries, glad_glDeleteQueries, Object, "..Q") \
+	X(glCreateShader, glad_glCreateShader, Object, "s.") \
+	X(glShaderSource, glad_glShaderSource, Object, ".s.SL") \
+	X(glCompileShader, glad_glCompileShader, Object, ".s") \
+	X(glDeleteShader, glad_glDeleteShader, Object, ".s") \
+	X(glCreateProgram, glad_glCreateProgram, Object, "p") \
+	X(glAttachShader, glad_glAttachShader, Object, ".ps") \
+	X(glLinkProgram, glad_glLinkProgram, Object, ".p") \
+	X(glProgramBinary, glad_glProgramBinary, Object, ".p.d.") \
+	X(glDeleteProgram, glad_glDeleteProgram, Object, ".p") \
+	/* Queries and synchronization */ \
+	X(glGetIntegerv, glad_glGetIntegerv, Query, "..o") \
+	X(glGetInteger64v, glad_glGetInteger64v, Query, "..o") \
+	X(glGetString, glad_glGetString, Query, "..") \
+	X(glGetStringi, glad_glGetStringi, Query, "...") \
+	X(glGetShaderiv, glad_glGetShaderiv, Query, ".s.o") \
+	X(glGetShaderInfoLog, glad_glGetShaderInfoLog, Query, ".s.oo") \
+	X(glGetProgramiv, glad_glGetProgramiv, Query, ".p.o") \
+	X(glGetProgramInfoLog, glad_glGetProgramInfoLog, Query, ".p.oo") \
+	X(glGetProgramBinary, glad_glGetProgramBinary, Query, ".p.ooo") \
+	X(glGetUniformLocation, glad_glGetUniformLocation, Query, "upz") \
+	X(glGetUniformBlockIndex, glad_glGetUniformBlockIndex, Query, "kpz") \
+	X(glGetTexLevelParameteriv, glad_glGetTexLevelParameteriv, Query, "....o") \
+	X(glCheckFramebufferStatus, glad_glCheckFramebufferStatus, Query, "..") \
+	X(glFenceSync, glad_glFenceSync, Query, "y..") \
+	X(glClientWaitSync, glad_glClientWaitSync, Query, ".y..") \
+	X(glDeleteSync, glad_glDeleteSync, Query, ".y") \
+	X(glQueryCounter, glad_glQueryCounter, Query, ".q.") \
+	X(glBeginQuery, glad_glBeginQuery, Query, "..q") \
+	X(glEndQuery, glad_glEndQuery, Query, "..") \
+	X(glGetQueryObjectiv, glad_glGetQueryObjectiv, Query, ".q.o") \
+	X(glGetQueryObjectui64v, glad_glGetQueryObjectui64v, Query, ".q.o")
+
+enum GLEntryPoint : uint16_t {
+#define GLIMAC_GL_ENTRY_POINT_ID(name, pointer, category, roles) GL_ENTRY_##name,
+	GLIMAC_GL_ENTRY_POINTS(GLIMAC_GL_ENTRY_POINT_ID)
+#undef GLIMAC_GL_ENTRY_POINT_ID
+	GL_ENTRY_POINT_COUNT
+};
+
+enum class GLCategory {
+	Draw, // Draws, dispatches, clears and blits
+	StateChange, // Binds and fixed-function state
+	Uniform, // Uniform uploads
+	Transfer, // Data sent to or read from buffers and textures
+	Object, // Creation and deletion of objects, shader compilation
+	Query, // Values read back, timer queries and fences
+	Count
+};
+
+const char* getCategoryName(GLCategory category);
+
+struct GLEntryPointInfo {
+	static constexpr unsigned int MAX_ARGS = 11;
+
+	const char* m_pName;
+	GLCategory m_Category;
+	const char* m_pRoles; // Role of the returned value, then of each argument (see GLIMAC_GL_ENTRY_POINTS)
+	unsigned int m_nArgCount;
+	unsigned char m_ReturnSize; // 0 for void
+	unsigned char m_ArgSizes[MAX_ARGS];
+	unsigned int m_nOutputArgs; // Bit i set when the argument i points to memory written by the call
+
+	// Call the loaded entry point with the values of the arguments (see toGLValue()),
+	// return false if it isn't loaded
+	bool (*m_pCall)(const uint64_t* args, uint64_t* result);
+
+	char getRole(unsigned int arg) const {
+		return m_pRoles[arg + 1];
+	}
+
+	char getReturnRole() const {
+		return m_pRoles[0];
+	}
+};
+
+const GLEntryPointInfo& getEntryPointInfo(GLEntryPoint entry);
+
+// Values of the arguments are kept in 64 bits, with the bytes of their type
+template <typename T>
+uint64_t toGLValue(T value) {
+	static_assert(sizeof(T) <= sizeof(uint64_t), "Arguments are at most 64 bits");
+	uint64_t result = 0;
+	std::memcpy(&result, &value, sizeof(T));
+	return result;
+}
+
+template <typename T>
+T fromGLValue(uint64_t value) {
+	T result;
+	std::memcpy(&result, &value, sizeof(T));
+	return result;
+}
+
+// Size in bytes of the data an argument with the 'd' or 'o' role points to, 0 if unknown
+std::size_t getPayloadSize(GLEntryPoint entry, unsigned int arg, const uint64_t* args);
+
+// Binary trace of the calls, written by the GLInterceptor and read by the GLReplayer.
+// Little-endian, it starts with a header:
+//     magic "SSGLTRC", version, width and height of the window (uint32)
+//     amount of entry points (uint32), then the name of each one (uint32 length, chars)
+// Then a record for each call: its entry point (uint16), its arguments in the order
+// of their roles, then its returned value when it's a name. The names are the ones of
+// the recording context. Two records come between the calls:
+//     GL_TRACE_BUFFER_WRITE: buffer (uint32), offset in its mapping (uint64), size (uint64)
+//                            and the bytes written by the CPU through the mapping
+//     GL_TRACE_FRAME_END: the frame is presented
+static constexpr char GL_TRACE_MAGIC[8] = "SSGLTRC";
+static constexpr uint32_t GL_TRACE_VERSION = 1;
+static constexpr uint16_t GL_TRACE_BUFFER_WRITE = 0xFFFE;
+static constexpr uint16_t GL_TRACE_FRAME_END = 0xFFFF;
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include "common.hpp"
+
+namespace glimac {
+
+// ShapeVertex compressed to 16 bytes, the format stored by a GeometryArena
+struct PackedVertex {
+	uint16_t position[4]; // Half floats, the last one is padding
+	uint32_t normal; // Signed normalized 10/10/10/2 bits (GL_INT_2_10_10_10_REV)
+	uint16_t texCoords[2]; // Unsigned normalized 16 bits, must be in [0, 1]
+
+	PackedVertex() = default;
+
+	explicit PackedVertex(const ShapeVertex& vertex);
+};
+
+// Range of a GeometryArena holding one mesh
+struct ArenaMesh {
+	GLenum m_Mode = GL_TRIANGLES; // Primitive drawn with the indices
+	GLsizei m_nIndexCount = 0; // Number of indices
+	GLuint m_nFirstIndex = 0; // Offset in the index buffer (in indices)
+	GLint m_nBaseVertex = 0; // Offset added to the indices (in vertices)
+
+	const GLvoid* getIndexOffset() const {
+		return (const GLvoid*)(m_nFirstIndex * sizeof(uint32_t));
+	}
+};
+
+// One vertex buffer and one index buffer shared by many meshes.
+//
+// The meshes are sub-allocated as (baseVertex, firstIndex, count) ranges and all of
+// them are read through the same VAO, so drawing another mesh doesn't need a VAO switch
+// and the ranges can be used as they are in indirect draw commands.
+// The buffers grow (on the GPU side) when a mesh doesn't fit.
+// The vertices are stored as PackedVertex (half the size of a ShapeVertex), the
+// shaders still read a vec3 position, a vec3 normal and a vec2 texture coordinate.
+class GeometryArena {
+public:
+	GeometryArena(GLsizei vertexCapacity = 1 << 16, GLsizei indexCapacity = 1 << 18);
+
+	~GeometryArena();
+
+	// Copy an indexed mesh, the indices are relative to its first vertex
+	ArenaMesh add(const ShapeVertex* vertices, GLsizei vertexCount, const uint32_t* indices, GLsizei indexCount, GLenum mode = GL_TRIANGLES);
+
+	// Copy a mesh without indices, the vertices are drawn in their order
+	ArenaMesh add(const ShapeVertex* vertices, GLsizei vertexCount, GLenum mode = GL_TRIANGLES);
+
+	// Copy an indexed mesh already in the format of the arena (read back by getContent())
+	ArenaMesh add(const PackedVertex* vertices, GLsizei vertexCount, const uint32_t* indices, GLsizei indexCount, GLenum mode = GL_TRIANGLES);
+
+	// Read back every vertex and index stored, the ranges of the meshes stay valid in them
+	void getContent(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices) const;
+
+	// Bind the VAO shared by all the meshes
+	void bind() const {
+		glBindVertexArray(m_nVAO);
+	}
+
+	// Draw a mesh, the arena must be bound
+	void draw(const ArenaMesh& mesh) const {
+		glDrawElementsBaseVertex(mesh.m_Mode, mesh.m_nIndexCount, GL_UNSIGNED_INT, mesh.getIndexOffset(), mesh.m_nBaseVertex);
+	}
+
+	// Add a per instance integer attribute (divisor 1) read from another buffer
+	void setInstanceAttribute(GLuint attribute, GLuint buffer);
+
+	GLuint getVertexArray() const {
+		return m_nVAO;
+	}
+
+	GLsizei getVertexCount() const {
+		return m_nVertexCount;
+	}
+
+	GLsizei getIndexCount() const {
+		return m_nIndexCount;
+	}
+
+private:
+	GeometryArena(const GeometryArena&);
+	GeometryArena& operator =(const GeometryArena&);
+
+	// Grow the buffers so they can store the given amounts
+	void reserve(GLsizei vertexCount, GLsizei indexCount);
+
+	void setVertexAttributes();
+
+	GLuint m_nVBO = 0;
+	GLuint m_nIBO = 0;
+	GLuint m_nVAO = 0;
+	GLsizei m_nVertexCapacity;
+	GLsizei m_nIndexCapacity;
+	GLsizei m_nVertexCount = 0;
+	GLsizei m_nIndexCount = 0;
+};
+
+}
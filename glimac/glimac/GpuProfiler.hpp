@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+#include <glad/glad.h>
+
+namespace glimac {
+
+// Measures the GPU time of named passes of each frame with GL_TIMESTAMP queries.
+//
+// Unlike GpuTimer the passes can nest, and they can be measured while a GpuTimer runs.
+// The results are read a few frames later so the CPU never waits for the GPU: each
+// frame uses the queries of the next slot of a ring, a frame isn't measured when every
+// slot is still pending. The times are given in the clock of the caller, from the time
+// it passes to beginFrame().
+//
+// Usage per frame:
+//     while(profiler.poll()) use(profiler.getZones());
+//     profiler.beginFrame(now());
+//     int zone = profiler.beginZone("Pass");
+//     ... GPU commands ...
+//     profiler.endZone(zone);
+//     profiler.endFrame();
+class GpuProfiler {
+public:
+	static constexpr unsigned int DEFAULT_FRAME_COUNT = 4; // Results up to three frames late
+	static constexpr unsigned int MAX_ZONES = 32; // Zones measured per frame, the frame itself included
+
+	struct Zone {
+		const char* m_pName; // Kept as is, a string literal
+		GLuint64 m_nBegin; // In the clock of the caller (in ns)
+		GLuint64 m_nEnd;
+	};
+
+	explicit GpuProfiler(unsigned int frameCount = DEFAULT_FRAME_COUNT);
+
+	~GpuProfiler();
+
+	// Start measuring a frame, its whole time is the first zone
+	// hostTime is the current time in the clock the zones are given in (in ns)
+	void beginFrame(GLuint64 hostTime, const char* name = "Frame");
+
+	void endFrame();
+
+	// Start measuring a pass of the frame, return -1 if it isn't measured
+	int beginZone(const char* name);
+
+	void endZone(int zone);
+
+	// Read the oldest frame if all its queries finished, return true if it was read
+	bool poll();
+
+	// Zones of the frame read by the last poll(), in the order they began
+	const std::vector<Zone>& getZones() const {
+		return m_Zones;
+	}
+
+private:
+	GpuProfiler(const GpuProfiler&);
+	GpuProfiler& operator =(const GpuProfiler&);
+
+	struct Frame {
+		std::vector<const char*> m_Names; // Name of each zone, its queries are 2 * i and 2 * i + 1
+		GLuint64 m_nHostTime = 0; // Given to beginFrame()
+		GLint64 m_nGpuTime = 0; // Time of the GPU at that moment
+	};
+
+	// Query of a slot
+	GLuint getQuery(unsigned int frame, unsigned int index) const {
+		return m_Queries[frame * MAX_ZONES * 2 + index];
+	}
+
+	std::vector<GLuint> m_Queries; // Created on the first frame
+	std::vector<Frame> m_Frames;
+	std::vector<Zone> m_Zones;
+	unsigned int m_nNext = 0; // Slot used by the next beginFrame()
+	unsigned int m_nPending = 0; // Frames ended but not read yet, the oldest one comes first
+	bool m_bRunning = false;
+};
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include <glad/glad.h>
+
+namespace glimac {
+
+// Measures the GPU time of some commands of each frame with GL_TIME_ELAPSED queries.
+//
+// The results are read a few frames later so the CPU never waits for the GPU: each
+// frame uses the next query of a ring, a query is only reused once its result was read.
+// Only one timer can measure at a time (OpenGL allows a single GL_TIME_ELAPSED query).
+//
+// Usage per frame:
+//     while(timer.poll()) use(timer.getLastTime());
+//     timer.begin();
+//     ... GPU commands ...
+//     timer.end();
+class GpuTimer {
+public:
+	static constexpr unsigned int DEFAULT_QUERY_COUNT = 4; // Results up to three frames late
+
+	explicit GpuTimer(unsigned int queryCount = DEFAULT_QUERY_COUNT);
+
+	~GpuTimer();
+
+	// Start measuring, false if nothing is measured this time because every query is still pending
+	bool begin();
+
+	void end();
+
+	// Read the oldest finished query, return true if a new time is available
+	// The results come in the order of the measures, call it until false to read them all
+	bool poll();
+
+	// Latest time read by poll() (in ms)
+	double getLastTime() const {
+		return m_fLastTime;
+	}
+
+private:
+	GpuTimer(const GpuTimer&);
+	GpuTimer& operator =(const GpuTimer&);
+
+	std::vector<GLuint> m_Queries;
+	unsigned int m_nNext = 0; // Query used by the next begin()
+	unsigned int m_nPending = 0; // Queries ended but not read yet, the oldest one comes first
+	bool m_bRunning = false;
+	double m_fLastTime = 0;
+};
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+namespace glimac {
+
+// Helpers shared by the tools writing their results as JSON (benchmarks, replay, profiler traces)
+
+// Write a JSON string, quotes, backslashes and control characters are escaped (null is written as an empty one)
+void writeJsonString(std::ostream& out, const char* text);
+
+// Write the mean, the 50th, 95th and 99th percentiles (nearest rank) and the maximum of
+// some samples as a JSON object, null without any sample
+void writeJsonStatistics(std::ostream& out, std::vector<float> samples);
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "FilePath.hpp"
+
+namespace glimac {
+
+// Read-only view of a whole file.
+// The file is memory-mapped where the system allows it, its pages are only read from
+// the disk (or from the page cache) when they are touched. Elsewhere it is read at once.
+class MappedFile {
+public:
+	MappedFile() = default;
+
+	~MappedFile();
+
+	MappedFile(MappedFile&& rvalue);
+
+	MappedFile& operator =(MappedFile&& rvalue);
+
+	// Map a file, false if it can't be opened (the previous mapping is released anyway)
+	bool open(const FilePath& path);
+
+	void close();
+
+	bool isOpen() const {
+		return m_pData != nullptr;
+	}
+
+	const char* data() const {
+		return m_pData;
+	}
+
+	std::size_t size() const {
+		return m_nSize;
+	}
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator =(const MappedFile&);
+
+	const char* m_pData = nullptr;
+	std::size_t m_nSize = 0;
+	bool m_bMapped = false; // m_pData comes from mmap, otherwise from m_Buffer
+	std::vector<char> m_Buffer;
+};
+
+}
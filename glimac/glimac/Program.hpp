@@ -58,5 +58,8 @@ Program buildProgram(const GLchar* vsSrc, const GLchar* fsSrc);
 // Load source code from files and build a GLSL program
 Program loadProgram(const FilePath& vsFile, const FilePath& fsFile);
 
+// Load source code from a file and build a GLSL compute program (OpenGL 4.3)
+Program loadComputeProgram(const FilePath& csFile);
+
 
 }
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Program.hpp"
+
+namespace glimac {
+
+// Time spent building a program of a ProgramRegistry
+struct ProgramStats {
+	std::string m_Name; // Files and defines of the program
+	double m_fSubmitTime = 0; // Time spent in the compile and link calls (in ms)
+	double m_fWaitTime = 0; // Time finish() waited for the link result (in ms)
+	bool m_bCached = false; // True if the program was loaded from the binary cache
+};
+
+// Builds each distinct GLSL program once and shares it.
+//
+// The programs are keyed by their vertex file, fragment file and defines, the shaders
+// are also shared between the programs using the same file with the same defines.
+// get() only submits the compile and link commands and no status is read before
+// finish(), so a driver compiling in the background (GL_KHR_parallel_shader_compile)
+// builds all the programs at the same time. The programs can't be used before finish().
+//
+// With a cache directory, the linked programs are saved with glGetProgramBinary and loaded
+// back on the next launch without any compilation. The files are named after a hash of the
+// sources (defines included) and of the driver, a binary rejected by the driver is rebuilt.
+class ProgramRegistry {
+public:
+	ProgramRegistry();
+
+	// The defines are lines inserted after the #version directive (ex: "#define LIGHTED\n")
+	std::shared_ptr<Program> get(const FilePath& vsFile, const FilePath& fsFile, const std::string& defines = "");
+
+	// Wait for the submitted programs and check them, throw a std::runtime_error on failure
+	void finish();
+
+	// Enable the binary cache (created if needed), nothing is cached if the driver has no binary format
+	void setCacheDirectory(const FilePath& directory);
+
+	// True if the driver compiles in the background
+	bool isParallel() const {
+		return m_bParallel;
+	}
+
+	// Number of calls to get()
+	unsigned int getRequestCount() const {
+		return m_nRequestCount;
+	}
+
+	// Number of distinct programs built
+	size_t getProgramCount() const {
+		return m_Programs.size();
+	}
+
+	// Build times of the finished programs, in the order of their first request
+	const std::vector<ProgramStats>& getStats() const {
+		return m_Stats;
+	}
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	struct PendingProgram {
+		std::shared_ptr<Program> m_Program;
+		std::shared_ptr<Shader> m_VertexShader;
+		std::shared_ptr<Shader> m_FragmentShader;
+		FilePath m_VertexFile;
+		FilePath m_FragmentFile;
+		std::string m_Defines;
+		FilePath m_CacheFile; // Empty if the cache is disabled
+		ProgramStats m_Stats;
+	};
+
+	ProgramRegistry(const ProgramRegistry&);
+	ProgramRegistry& operator =(const ProgramRegistry&);
+
+	// Shared shader compiled from a file with some defines (the compilation is only submitted)
+	std::shared_ptr<Shader> getShader(GLenum type, const FilePath& file, const std::string& defines);
+
+	// Compile the shaders and link the program (only submitted)
+	void build(PendingProgram& pending);
+
+	// Load the program from the cache file, the driver may still reject it when linking
+	bool loadBinary(PendingProgram& pending);
+
+	// Write the linked program to its cache file
+	void saveBinary(const PendingProgram& pending);
+
+	bool m_bParallel = false;
+	FilePath m_CacheDirectory; // Empty if the cache is disabled
+	std::string m_DriverName; // Vendor, renderer and version strings, part of the cache keys
+	unsigned int m_nRequestCount = 0;
+	std::map<std::string, std::shared_ptr<Program>> m_Programs;
+	std::map<std::string, std::shared_ptr<Shader>> m_Shaders;
+	std::vector<PendingProgram> m_Pending;
+	std::vector<ProgramStats> m_Stats;
+};
+
+}
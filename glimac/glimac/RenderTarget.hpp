@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace glimac {
+
+// Offscreen framebuffer the scene is rendered into before being copied to the window.
+//
+// The color is stored in RGBA8 and the depth in GL_DEPTH_COMPONENT32F: the window
+// framebuffer usually only has a 24 bits fixed point depth, a floating point depth
+// is needed to keep the precision of a reversed depth (1 on the near plane, 0 far away).
+//
+// Only an active area, in the bottom left corner, is drawn and copied: the rendering
+// resolution changes every frame without reallocating anything.
+class RenderTarget {
+public:
+	RenderTarget() = default;
+
+	~RenderTarget();
+
+	// (Re)allocate the attachments, nothing is done if the size didn't change, the whole target is active
+	void resize(GLsizei width, GLsizei height);
+
+	// Part of the target drawn and copied (clamped to the size of the target)
+	void setActiveArea(GLsizei width, GLsizei height);
+
+	// Draw into the target, the viewport covers the active area
+	void bind() const;
+
+	// Copy the active area to the window framebuffer (which stays bound), stretched to the given size
+	void blitToScreen(GLsizei screenWidth, GLsizei screenHeight) const;
+
+	GLuint getGLId() const {
+		return m_nFBO;
+	}
+
+	GLsizei getWidth() const {
+		return m_nWidth;
+	}
+
+	GLsizei getHeight() const {
+		return m_nHeight;
+	}
+
+	GLsizei getActiveWidth() const {
+		return m_nActiveWidth;
+	}
+
+	GLsizei getActiveHeight() const {
+		return m_nActiveHeight;
+	}
+
+private:
+	RenderTarget(const RenderTarget&);
+	RenderTarget& operator =(const RenderTarget&);
+
+	void release();
+
+	GLuint m_nFBO = 0;
+	GLuint m_nColorBuffer = 0;
+	GLuint m_nDepthBuffer = 0;
+	GLsizei m_nWidth = 0;
+	GLsizei m_nHeight = 0;
+	GLsizei m_nActiveWidth = 0;
+	GLsizei m_nActiveHeight = 0;
+};
+
+}
@@ -48,6 +48,9 @@ private:
 	GLuint m_nGLId;
 };
 
+// Read the source code of a shader
+std::string loadShaderSource(const FilePath& filepath);
+
 // Load a shader (but does not compile it)
 Shader loadShader(GLenum type, const FilePath& filepath);
 
@@ -29,9 +29,31 @@ public:
         return m_nVertexCount;
     }
 
+    // Renvoit le pointeur vers les vertex uniques (à utiliser avec l'index buffer)
+    const ShapeVertex* getIndexedDataPointer() const {
+        return &m_IndexedVertices[0];
+    }
+
+    // Renvoit le nombre de vertex uniques
+    GLsizei getIndexedVertexCount() const {
+        return m_IndexedVertices.size();
+    }
+
+    // Renvoit le pointeur vers les indices des triangles
+    const uint32_t* getIndexPointer() const {
+        return &m_Indices[0];
+    }
+
+    // Renvoit le nombre d'indices
+    GLsizei getIndexCount() const {
+        return m_Indices.size();
+    }
+
 private:
     std::vector<ShapeVertex> m_Vertices;
     GLsizei m_nVertexCount; // Nombre de sommets
+    std::vector<ShapeVertex> m_IndexedVertices; // Sommets uniques
+    std::vector<uint32_t> m_Indices; // Indices des triangles dans m_IndexedVertices
 };
     
 }
\ No newline at end of file
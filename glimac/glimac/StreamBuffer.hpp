@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <glad/glad.h>
+
+namespace glimac {
+
+// Buffer for data written by the CPU every frame (per instance data, trails, HUD...).
+//
+// The buffer is split into frameCount regions, each frame writes into the next one.
+// A fence is placed once the GPU commands reading a region are issued, the region is
+// only written again when the GPU is done with it, so the writes never wait for the
+// GPU implicitly. With glBufferStorage the buffer stays mapped (persistent and
+// coherent), the data is written in place without any copy. Otherwise each region
+// is mapped with GL_MAP_UNSYNCHRONIZED_BIT, the fences doing the synchronization.
+//
+// Usage per frame:
+//     auto ptr = buffer.map();      // Waits for the region if needed
+//     ... write at most getFrameSize() bytes ...
+//     buffer.unmap();
+//     glBindBufferRange(target, binding, buffer.getGLId(), buffer.getOffset(), size);
+//     ... GPU commands reading the region ...
+//     buffer.fence();
+class StreamBuffer {
+public:
+	static constexpr unsigned int DEFAULT_FRAME_COUNT = 3; // CPU can be two frames ahead of the GPU
+
+	StreamBuffer(GLenum target, GLsizeiptr frameSize, unsigned int frameCount = DEFAULT_FRAME_COUNT);
+
+	~StreamBuffer();
+
+	StreamBuffer(StreamBuffer&& rvalue);
+
+	StreamBuffer& operator =(StreamBuffer&& rvalue);
+
+	// Move to the region of the next frame and return a pointer to write into
+	void* map();
+
+	// Make the writes of the current region visible to the GPU
+	void unmap();
+
+	// Mark the end of the GPU commands reading the current region
+	void fence();
+
+	GLuint getGLId() const {
+		return m_nGLId;
+	}
+
+	// Offset of the current region in the buffer
+	GLintptr getOffset() const {
+		return m_nCurrentRegion * m_nFrameSize;
+	}
+
+	// Size of a region (rounded up to the offset alignment of the target)
+	GLsizeiptr getFrameSize() const {
+		return m_nFrameSize;
+	}
+
+	bool isPersistent() const {
+		return m_pPersistentData != nullptr;
+	}
+
+	// Amount of times map() had to wait for the GPU
+	unsigned int getStallCount() const {
+		return m_nStallCount;
+	}
+
+private:
+	StreamBuffer(const StreamBuffer&);
+	StreamBuffer& operator =(const StreamBuffer&);
+
+	void release();
+
+	GLenum m_Target;
+	GLuint m_nGLId = 0;
+	GLsizeiptr m_nFrameSize;
+	unsigned int m_nFrameCount;
+	unsigned int m_nCurrentRegion;
+	std::vector<GLsync> m_Fences; // One per region, null when the region is free
+	char* m_pPersistentData = nullptr; // Start of the mapping when the buffer stays mapped
+	bool m_bMapped = false;
+	unsigned int m_nStallCount = 0;
+};
+
+}
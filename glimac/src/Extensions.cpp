@@ -0,0 +1,70 @@
+#include "glimac/Extensions.hpp"
+
+#include <cstring>
+
+namespace glimac {
+
+PFNGLBUFFERSTORAGEPROC ext_glBufferStorage = nullptr;
+PFNGLMAXSHADERCOMPILERTHREADSPROC ext_glMaxShaderCompilerThreads = nullptr;
+PFNGLCLIPCONTROLPROC ext_glClipControl = nullptr;
+
+void loadExtensions(GLADloadproc load) {
+	// Some loaders return a stub for any name, so the version or the extension is checked too
+	if(hasVersion(4, 4) || hasExtension("GL_ARB_buffer_storage")) {
+		ext_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage");
+	}
+
+	if(hasExtension("GL_KHR_parallel_shader_compile")) {
+		ext_glMaxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSPROC)load("glMaxShaderCompilerThreadsKHR");
+	} else if(hasExtension("GL_ARB_parallel_shader_compile")) {
+		ext_glMaxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSPROC)load("glMaxShaderCompilerThreadsARB");
+	}
+
+	if(hasVersion(4, 5) || hasExtension("GL_ARB_clip_control")) {
+		ext_glClipControl = (PFNGLCLIPCONTROLPROC)load("glClipControl");
+	}
+}
+
+bool hasVersion(int major, int minor) {
+	GLint contextMajor = 0, contextMinor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &contextMajor);
+	glGetIntegerv(GL_MINOR_VERSION, &contextMinor);
+	return contextMajor > major || (contextMajor == major && contextMinor >= minor);
+}
+
+bool hasExtension(const char* name) {
+	GLint count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for(GLint i = 0; i < count; ++i) {
+		if(std::strcmp((const char*)glGetStringi(GL_EXTENSIONS, i), name) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool hasBufferStorage() {
+	return ext_glBufferStorage != nullptr;
+}
+
+void bufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
+	ext_glBufferStorage(target, size, data, flags);
+}
+
+bool hasParallelShaderCompile() {
+	return ext_glMaxShaderCompilerThreads != nullptr;
+}
+
+void maxShaderCompilerThreads(GLuint count) {
+	ext_glMaxShaderCompilerThreads(count);
+}
+
+bool hasClipControl() {
+	return ext_glClipControl != nullptr;
+}
+
+void clipControl(GLenum origin, GLenum depth) {
+	ext_glClipControl(origin, depth);
+}
+
+}
@@ -0,0 +1,159 @@
+#include "glimac/FrameArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+namespace glimac {
+
+// Arenas of the threads, moved together by nextFrameAll()
+static std::mutex& registryMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+static std::vector<FrameArena*>& registry() {
+	static std::vector<FrameArena*> arenas;
+	return arenas;
+}
+
+FrameArena::FrameArena(std::size_t capacity, unsigned int bufferCount):
+	m_pMemory(new char[capacity * bufferCount]), m_nCapacity(capacity), m_nBufferCount(bufferCount) {
+	if(bufferCount == 0) {
+		throw std::invalid_argument("A frame arena needs at least one region");
+	}
+	m_pBegin = m_pTop = m_pMemory.get();
+	m_pEnd = m_pBegin + m_nCapacity;
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment) {
+	std::uintptr_t top = reinterpret_cast<std::uintptr_t>(m_pTop);
+	std::uintptr_t aligned = (top + alignment - 1) & ~std::uintptr_t(alignment - 1);
+	char* pointer = m_pTop + (aligned - top);
+
+	if(pointer > m_pEnd || std::size_t(m_pEnd - pointer) < size) {
+		// The region is full, the heap keeps the frame going
+		++m_nOverflowCount;
+		m_nOverflowSize += size + alignment;
+		if(alignment > alignof(std::max_align_t)) {
+			return ::operator new(size, std::align_val_t(alignment));
+		}
+		return ::operator new(size);
+	}
+
+	m_pTop = pointer + size;
+	m_nHighWaterMark = std::max(m_nHighWaterMark, getUsed());
+	return pointer;
+}
+
+void FrameArena::deallocate(void* pointer, std::size_t alignment) {
+	if(!pointer || owns(pointer)) {
+		return;
+	}
+	if(alignment > alignof(std::max_align_t)) {
+		::operator delete(pointer, std::align_val_t(alignment));
+	} else {
+		::operator delete(pointer);
+	}
+}
+
+bool FrameArena::owns(const void* pointer) const {
+	if(contains(m_pMemory.get(), m_nCapacity * m_nBufferCount, pointer)) {
+		return true;
+	}
+	for(auto& retired: m_RetiredMemory) {
+		if(contains(retired.m_pMemory.get(), retired.m_nSize, pointer)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void FrameArena::nextFrame() {
+	// The replaced regions are released once the frames they hold are reused
+	for(auto& retired: m_RetiredMemory) {
+		--retired.m_nFrameCount;
+	}
+	m_RetiredMemory.erase(std::remove_if(m_RetiredMemory.begin(), m_RetiredMemory.end(), [](const RetiredMemory& retired) {
+		return retired.m_nFrameCount == 0;
+	}), m_RetiredMemory.end());
+
+	// A frame which overflowed gets regions holding all of it, the current ones stay readable
+	std::size_t needed = getUsed() + m_nOverflowSize;
+	m_nOverflowSize = 0;
+	if(needed > m_nCapacity) {
+		std::size_t capacity = m_nCapacity;
+		while(capacity < needed) {
+			capacity *= 2;
+		}
+
+		if(m_nBufferCount > 1) {
+			m_RetiredMemory.push_back({std::move(m_pMemory), m_nCapacity * m_nBufferCount, m_nBufferCount - 1});
+		}
+		m_pMemory.reset(new char[capacity * m_nBufferCount]);
+		m_nCapacity = capacity;
+	}
+
+	m_nCurrentBuffer = (m_nCurrentBuffer + 1) % m_nBufferCount;
+	m_pBegin = m_pTop = m_pMemory.get() + m_nCurrentBuffer * m_nCapacity;
+	m_pEnd = m_pBegin + m_nCapacity;
+}
+
+FrameArena& FrameArena::local() {
+	// Registered for the lifetime of the thread
+	struct LocalArena {
+		FrameArena arena;
+
+		LocalArena() {
+			std::lock_guard<std::mutex> lock(registryMutex());
+			registry().push_back(&arena);
+		}
+
+		~LocalArena() {
+			std::lock_guard<std::mutex> lock(registryMutex());
+			auto& arenas = registry();
+			arenas.erase(std::find(arenas.begin(), arenas.end(), &arena));
+		}
+	};
+
+	thread_local LocalArena local;
+	return local.arena;
+}
+
+void FrameArena::nextFrameAll() {
+	std::lock_guard<std::mutex> lock(registryMutex());
+	for(auto arena: registry()) {
+		arena->nextFrame();
+	}
+}
+
+std::size_t FrameArena::getGlobalHighWaterMark() {
+	std::lock_guard<std::mutex> lock(registryMutex());
+	std::size_t highWaterMark = 0;
+	for(auto arena: registry()) {
+		highWaterMark = std::max(highWaterMark, arena->getHighWaterMark());
+	}
+	return highWaterMark;
+}
+
+std::size_t FrameArena::getGlobalCapacity() {
+	std::lock_guard<std::mutex> lock(registryMutex());
+	std::size_t capacity = 0;
+	for(auto arena: registry()) {
+		capacity = std::max(capacity, arena->getCapacity());
+	}
+	return capacity;
+}
+
+unsigned int FrameArena::getGlobalOverflowCount() {
+	std::lock_guard<std::mutex> lock(registryMutex());
+	unsigned int overflows = 0;
+	for(auto arena: registry()) {
+		overflows += arena->getOverflowCount();
+	}
+	return overflows;
+}
+
+}
@@ -0,0 +1,536 @@
+#include "glimac/GLInterceptor.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <initializer_list>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace glimac {
+
+namespace {
+
+// What is bound to a slot of the context (ex: the buffer of a target)
+struct Binding {
+	uint64_t m_nName = 0;
+	uint64_t m_nOffset = 0; // Range of glBindBufferRange
+	uint64_t m_nSize = 0;
+
+	bool operator ==(const Binding& other) const {
+		return m_nName == other.m_nName && m_nOffset == other.m_nOffset && m_nSize == other.m_nSize;
+	}
+};
+
+// Buffer mapped by glMapBufferRange, its writes go to the trace
+struct Mapping {
+	GLuint m_nBuffer;
+	const char* m_pData;
+	std::size_t m_nSize;
+	bool m_bPersistent; // Written at any time, compared with m_Copy before the draws
+	bool m_bWrite;
+	std::vector<char> m_Copy;
+};
+
+struct EntryPointStats {
+	unsigned int m_nFrameCalls = 0; // Frame in progress
+	unsigned int m_nFrameRedundant = 0;
+	unsigned int m_nLastFrameCalls = 0; // Last frame ended
+	unsigned int m_nLastFrameRedundant = 0;
+	unsigned int m_nMaxFrameCalls = 0;
+	unsigned long long m_nCalls = 0; // Frames ended since the last reset
+	unsigned long long m_nRedundant = 0;
+};
+
+bool s_bInstalled = false;
+EntryPointStats s_Stats[GL_ENTRY_POINT_COUNT];
+unsigned long long s_nFrameCount = 0;
+unsigned long long s_nMaxFrameCalls = 0;
+
+// Slot: entry point binding it and target, index: texture unit, binding point or vertex array
+std::map<std::pair<uint64_t, uint64_t>, Binding> s_Bindings;
+
+std::ofstream s_Trace;
+bool s_bCapturing = false;
+std::vector<Mapping> s_Mappings;
+
+uint64_t getSlot(GLEntryPoint entry, uint64_t target = 0) {
+	return uint64_t(entry) << 32 | target;
+}
+
+Binding& getBinding(GLEntryPoint entry, uint64_t target, uint64_t index = 0) {
+	return s_Bindings[{getSlot(entry, target), index}]; // Unknown slots start with nothing bound, like the context
+}
+
+// The element array buffer is a state of the vertex array
+uint64_t getBufferIndex(uint64_t target) {
+	return target == GL_ELEMENT_ARRAY_BUFFER ? getBinding(GL_ENTRY_glBindVertexArray, 0).m_nName : 0;
+}
+
+GLuint getBoundBuffer(uint64_t target) {
+	return GLuint(getBinding(GL_ENTRY_glBindBuffer, target, getBufferIndex(target)).m_nName);
+}
+
+// Bind, return true if it was already bound
+bool bind(Binding& binding, const Binding& value) {
+	bool redundant = binding == value;
+	binding = value;
+	return redundant;
+}
+
+// Forget the bindings of deleted objects, the context unbinds them
+void unbind(std::initializer_list<GLEntryPoint> entries, GLsizei count, const GLuint* names) {
+	for(auto& binding : s_Bindings) {
+		GLEntryPoint entry = GLEntryPoint(binding.first.first >> 32);
+		if(std::find(entries.begin(), entries.end(), entry) != entries.end()
+			&& std::find(names, names + count, binding.second.m_nName) != names + count) {
+			binding.second = Binding();
+		}
+	}
+}
+
+// Update the bindings with a call, return true if it bound what was already bound
+bool trackBindings(GLEntryPoint entry, const uint64_t* args) {
+	switch(entry) {
+	case GL_ENTRY_glBindBuffer:
+		return bind(getBinding(entry, args[0], getBufferIndex(args[0])), {args[1]});
+	case GL_ENTRY_glBindBufferBase:
+	case GL_ENTRY_glBindBufferRange:
+		// Binds the generic binding point too
+		getBinding(GL_ENTRY_glBindBuffer, args[0], getBufferIndex(args[0])) = {args[2]};
+		return bind(getBinding(GL_ENTRY_glBindBufferBase, args[0], args[1]),
+			entry == GL_ENTRY_glBindBufferBase ? Binding{args[2], 0, ~0ull} : Binding{args[2], args[3], args[4]});
+	case GL_ENTRY_glActiveTexture:
+		return bind(getBinding(entry, 0), {args[0]});
+	case GL_ENTRY_glBindTexture:
+		return bind(getBinding(entry, args[0], getBinding(GL_ENTRY_glActiveTexture, 0).m_nName), {args[1]});
+	case GL_ENTRY_glBindFramebuffer:
+		if(args[0] == GL_FRAMEBUFFER) {
+			bool draw = bind(getBinding(entry, GL_DRAW_FRAMEBUFFER), {args[1]});
+			bool read = bind(getBinding(entry, GL_READ_FRAMEBUFFER), {args[1]});
+			return draw && read;
+		}
+		return bind(getBinding(entry, args[0]), {args[1]});
+	case GL_ENTRY_glBindVertexArray:
+	case GL_ENTRY_glUseProgram:
+		return bind(getBinding(entry, 0), {args[0]});
+	case GL_ENTRY_glBindRenderbuffer:
+		return bind(getBinding(entry, args[0]), {args[1]});
+	case GL_ENTRY_glDeleteBuffers:
+		unbind({GL_ENTRY_glBindBuffer, GL_ENTRY_glBindBufferBase}, GLsizei(args[0]), fromGLValue<const GLuint*>(args[1]));
+		return false;
+	case GL_ENTRY_glDeleteTextures:
+		unbind({GL_ENTRY_glBindTexture}, GLsizei(args[0]), fromGLValue<const GLuint*>(args[1]));
+		return false;
+	case GL_ENTRY_glDeleteVertexArrays:
+		unbind({GL_ENTRY_glBindVertexArray}, GLsizei(args[0]), fromGLValue<const GLuint*>(args[1]));
+		return false;
+	case GL_ENTRY_glDeleteFramebuffers:
+		unbind({GL_ENTRY_glBindFramebuffer}, GLsizei(args[0]), fromGLValue<const GLuint*>(args[1]));
+		return false;
+	case GL_ENTRY_glDeleteRenderbuffers:
+		unbind({GL_ENTRY_glBindRenderbuffer}, GLsizei(args[0]), fromGLValue<const GLuint*>(args[1]));
+		return false;
+	default:
+		return false;
+	}
+}
+
+void write(const void* data, std::size_t size) {
+	s_Trace.write(static_cast<const char*>(data), size);
+}
+
+template <typename T>
+void write(T value) {
+	write(&value, sizeof(T));
+}
+
+// Write the bytes of a mapping which changed since the last time (all of them the first time)
+void writeMapping(Mapping& mapping) {
+	if(!mapping.m_bWrite) {
+		return;
+	}
+
+	std::size_t begin = 0, end = mapping.m_nSize;
+	if(mapping.m_bPersistent) {
+		if(mapping.m_Copy.empty()) {
+			mapping.m_Copy.assign(mapping.m_pData, mapping.m_pData + mapping.m_nSize);
+		} else {
+			const char* copy = mapping.m_Copy.data();
+			while(begin < end && mapping.m_pData[begin] == copy[begin]) {
+				++begin;
+			}
+			while(end > begin && mapping.m_pData[end - 1] == copy[end - 1]) {
+				--end;
+			}
+			std::memcpy(mapping.m_Copy.data() + begin, mapping.m_pData + begin, end - begin);
+		}
+	}
+
+	if(begin < end) {
+		write(GL_TRACE_BUFFER_WRITE);
+		write(uint32_t(mapping.m_nBuffer));
+		write(uint64_t(begin));
+		write(uint64_t(end - begin));
+		write(mapping.m_pData + begin, end - begin);
+	}
+}
+
+// Write the changes of the persistent mappings, before the commands reading them
+void writePersistentMappings() {
+	for(auto& mapping : s_Mappings) {
+		if(mapping.m_bPersistent) {
+			writeMapping(mapping);
+		}
+	}
+}
+
+// Write the changes of the mapping of a buffer being unmapped, and forget it
+void writeUnmapping(GLuint buffer) {
+	for(auto it = s_Mappings.begin(); it != s_Mappings.end(); ++it) {
+		if(it->m_nBuffer == buffer) {
+			writeMapping(*it);
+			s_Mappings.erase(it);
+			return;
+		}
+	}
+}
+
+// Before a call is made
+void enter(GLEntryPoint entry, const uint64_t* args) {
+	if(!s_bCapturing) {
+		return;
+	}
+
+	const GLEntryPointInfo& info = getEntryPointInfo(entry);
+	if(info.m_Category == GLCategory::Draw || entry == GL_ENTRY_glCopyBufferSubData) {
+		writePersistentMappings();
+	} else if(entry == GL_ENTRY_glUnmapBuffer) {
+		writeUnmapping(getBoundBuffer(args[0]));
+	} else if(entry == GL_ENTRY_glDeleteBuffers) {
+		auto names = fromGLValue<const GLuint*>(args[1]);
+		for(GLsizei i = 0; i < GLsizei(args[0]); ++i) {
+			writeUnmapping(names[i]); // Deleting a buffer unmaps it
+		}
+	}
+}
+
+// Write a call to the trace, once it is made
+void record(GLEntryPoint entry, const uint64_t* args, uint64_t result) {
+	const GLEntryPointInfo& info = getEntryPointInfo(entry);
+	write(uint16_t(entry));
+
+	for(unsigned int i = 0; i < info.m_nArgCount; ++i) {
+		char role = info.getRole(i);
+		switch(role) {
+		case 'B': case 'T': case 'V': case 'F': case 'R': case 'Q':
+			write(fromGLValue<const GLuint*>(args[i]), args[0] * sizeof(GLuint));
+			break;
+		case 'd': {
+			auto data = fromGLValue<const void*>(args[i]);
+			uint64_t size = data ? getPayloadSize(entry, i, args) : 0;
+			write(uint8_t(data != nullptr));
+			write(size);
+			write(data, size);
+			break;
+		}
+		case 'z': {
+			auto text = fromGLValue<const GLchar*>(args[i]);
+			uint32_t length = uint32_t(std::strlen(text));
+			write(length);
+			write(text, length);
+			break;
+		}
+		case 'S': {
+			auto strings = fromGLValue<const GLchar* const*>(args[i]);
+			auto lengths = fromGLValue<const GLint*>(args[i + 1]);
+			for(GLsizei s = 0; s < GLsizei(args[1]); ++s) {
+				uint32_t length = uint32_t(lengths && lengths[s] >= 0 ? lengths[s] : std::strlen(strings[s]));
+				write(length);
+				write(strings[s], length);
+			}
+			break;
+		}
+		case 'L': case 'o':
+			break;
+		default:
+			write(&args[i], info.m_ArgSizes[i]);
+			break;
+		}
+	}
+
+	char returnRole = info.getReturnRole();
+	if(returnRole != '.' && returnRole != 'm') {
+		write(&result, info.m_ReturnSize);
+	}
+}
+
+// After a call is made
+void leave(GLEntryPoint entry, const uint64_t* args, uint64_t result) {
+	if(!s_bCapturing) {
+		return;
+	}
+
+	record(entry, args, result);
+
+	if(entry == GL_ENTRY_glMapBufferRange && result) {
+		GLbitfield access = GLbitfield(args[3]);
+		auto data = fromGLValue<const char*>(result);
+		std::size_t size = std::size_t(args[2]);
+		s_Mappings.push_back({getBoundBuffer(args[0]), data, size, (access & GL_MAP_PERSISTENT_BIT) != 0, (access & GL_MAP_WRITE_BIT) != 0, {}});
+	}
+}
+
+// Wrapper of an entry point, from the type of its pointer
+template <auto Pointer, GLEntryPoint Entry>
+struct GLHook;
+
+template <typename R, typename... Args, R (APIENTRYP *Pointer)(Args...), GLEntryPoint Entry>
+struct GLHook<Pointer, Entry> {
+	static inline R (APIENTRYP s_Original)(Args...) = nullptr;
+
+	static void install() {
+		if(*Pointer) {
+			s_Original = *Pointer;
+			*Pointer = &call;
+		}
+	}
+
+	static void uninstall() {
+		if(s_Original) {
+			*Pointer = s_Original;
+			s_Original = nullptr;
+		}
+	}
+
+	static R APIENTRY call(Args... values) {
+		uint64_t args[sizeof...(Args) + 1] = {toGLValue(values)...}; // One more for the entry points without argument
+
+		EntryPointStats& stats = s_Stats[Entry];
+		++stats.m_nFrameCalls;
+		if(trackBindings(Entry, args)) {
+			++stats.m_nFrameRedundant;
+		}
+
+		enter(Entry, args);
+		if constexpr(std::is_void_v<R>) {
+			s_Original(values...);
+			leave(Entry, args, 0);
+		} else {
+			R result = s_Original(values...);
+			leave(Entry, args, toGLValue(result));
+			return result;
+		}
+	}
+};
+
+#define GLIMAC_GL_ENTRY_POINT_HOOK(name, pointer, category, roles) GLHook<&pointer, GL_ENTRY_##name>::install,
+void (*const s_Installs[])() = {GLIMAC_GL_ENTRY_POINTS(GLIMAC_GL_ENTRY_POINT_HOOK)};
+#undef GLIMAC_GL_ENTRY_POINT_HOOK
+
+#define GLIMAC_GL_ENTRY_POINT_HOOK(name, pointer, category, roles) GLHook<&pointer, GL_ENTRY_##name>::uninstall,
+void (*const s_Uninstalls[])() = {GLIMAC_GL_ENTRY_POINTS(GLIMAC_GL_ENTRY_POINT_HOOK)};
+#undef GLIMAC_GL_ENTRY_POINT_HOOK
+
+}
+
+void GLInterceptor::install() {
+	if(s_bInstalled) {
+		return;
+	}
+	for(auto install : s_Installs) {
+		install();
+	}
+	s_Bindings.clear();
+	getBinding(GL_ENTRY_glActiveTexture, 0) = {GL_TEXTURE0};
+	s_bInstalled = true;
+	resetStats();
+}
+
+void GLInterceptor::uninstall() {
+	if(!s_bInstalled) {
+		return;
+	}
+	stopCapture();
+	for(auto uninstall : s_Uninstalls) {
+		uninstall();
+	}
+	s_bInstalled = false;
+}
+
+bool GLInterceptor::isInstalled() {
+	return s_bInstalled;
+}
+
+bool GLInterceptor::startCapture(const FilePath& path, unsigned int width, unsigned int height) {
+	if(!s_bInstalled || s_bCapturing) {
+		return false;
+	}
+
+	s_Trace.open(path.str(), std::ios::binary | std::ios::trunc);
+	if(!s_Trace) {
+		return false;
+	}
+
+	write(GL_TRACE_MAGIC, sizeof(GL_TRACE_MAGIC));
+	write(GL_TRACE_VERSION);
+	write(uint32_t(width));
+	write(uint32_t(height));
+	write(uint32_t(GL_ENTRY_POINT_COUNT));
+	for(unsigned int i = 0; i < GL_ENTRY_POINT_COUNT; ++i) {
+		const char* name = getEntryPointInfo(GLEntryPoint(i)).m_pName;
+		write(uint32_t(std::strlen(name)));
+		write(name, std::strlen(name));
+	}
+
+	s_Mappings.clear();
+	s_bCapturing = true;
+	return true;
+}
+
+bool GLInterceptor::stopCapture() {
+	if(!s_bCapturing) {
+		return false;
+	}
+
+	s_bCapturing = false;
+	s_Mappings.clear();
+	s_Trace.close();
+	bool written = static_cast<bool>(s_Trace);
+	s_Trace.clear();
+	return written;
+}
+
+bool GLInterceptor::isCapturing() {
+	return s_bCapturing;
+}
+
+void GLInterceptor::endFrame() {
+	if(!s_bInstalled) {
+		return;
+	}
+	if(s_bCapturing) {
+		write(GL_TRACE_FRAME_END);
+	}
+
+	unsigned long long frameCalls = 0;
+	for(auto& stats : s_Stats) {
+		stats.m_nLastFrameCalls = stats.m_nFrameCalls;
+		stats.m_nLastFrameRedundant = stats.m_nFrameRedundant;
+		stats.m_nMaxFrameCalls = std::max(stats.m_nMaxFrameCalls, stats.m_nFrameCalls);
+		stats.m_nCalls += stats.m_nFrameCalls;
+		stats.m_nRedundant += stats.m_nFrameRedundant;
+		frameCalls += stats.m_nFrameCalls;
+		stats.m_nFrameCalls = 0;
+		stats.m_nFrameRedundant = 0;
+	}
+	s_nMaxFrameCalls = std::max(s_nMaxFrameCalls, frameCalls);
+	++s_nFrameCount;
+}
+
+void GLInterceptor::resetStats() {
+	for(auto& stats : s_Stats) {
+		stats = EntryPointStats();
+	}
+	s_nFrameCount = 0;
+	s_nMaxFrameCalls = 0;
+}
+
+unsigned long long GLInterceptor::getFrameCount() {
+	return s_nFrameCount;
+}
+
+unsigned int GLInterceptor::getFrameCalls(GLEntryPoint entry) {
+	return s_Stats[entry].m_nLastFrameCalls;
+}
+
+unsigned int GLInterceptor::getFrameRedundantBinds(GLEntryPoint entry) {
+	return s_Stats[entry].m_nLastFrameRedundant;
+}
+
+// Averages per frame of the calls, of each category and of the redundant binds
+struct Averages {
+	double m_fCalls = 0;
+	double m_Categories[int(GLCategory::Count)] = {};
+	double m_fRedundant = 0;
+};
+
+static Averages getAverages() {
+	Averages averages;
+	double frames = std::max(s_nFrameCount, 1ull);
+	for(unsigned int i = 0; i < GL_ENTRY_POINT_COUNT; ++i) {
+		double calls = s_Stats[i].m_nCalls / frames;
+		averages.m_fCalls += calls;
+		averages.m_Categories[int(getEntryPointInfo(GLEntryPoint(i)).m_Category)] += calls;
+		averages.m_fRedundant += s_Stats[i].m_nRedundant / frames;
+	}
+	return averages;
+}
+
+// Entry points called since the last reset, the most called first
+static std::vector<GLEntryPoint> getCalledEntryPoints() {
+	std::vector<GLEntryPoint> entries;
+	for(unsigned int i = 0; i < GL_ENTRY_POINT_COUNT; ++i) {
+		if(s_Stats[i].m_nCalls) {
+			entries.push_back(GLEntryPoint(i));
+		}
+	}
+	std::stable_sort(entries.begin(), entries.end(), [](GLEntryPoint a, GLEntryPoint b) {
+		return s_Stats[a].m_nCalls > s_Stats[b].m_nCalls;
+	});
+	return entries;
+}
+
+void GLInterceptor::printStats(std::ostream& out) {
+	Averages averages = getAverages();
+	double frames = std::max(s_nFrameCount, 1ull);
+	std::ios::fmtflags flags = out.flags();
+	std::streamsize precision = out.precision();
+
+	out << std::fixed << std::setprecision(1)
+		<< "OpenGL calls per frame over " << s_nFrameCount << " frames: " << averages.m_fCalls << " (" << s_nMaxFrameCalls << " at most)";
+	for(int category = 0; category < int(GLCategory::Count); ++category) {
+		out << ", " << averages.m_Categories[category] << " " << getCategoryName(GLCategory(category));
+	}
+	out << ", " << averages.m_fRedundant << " redundant binds" << std::endl;
+
+	out << "  " << std::left << std::setw(32) << "Entry point" << std::right
+		<< std::setw(14) << "Calls/frame" << std::setw(10) << "Max" << std::setw(18) << "Redundant/frame" << std::endl;
+	for(GLEntryPoint entry : getCalledEntryPoints()) {
+		const EntryPointStats& stats = s_Stats[entry];
+		out << "  " << std::left << std::setw(32) << getEntryPointInfo(entry).m_pName << std::right
+			<< std::setw(14) << stats.m_nCalls / frames << std::setw(10) << stats.m_nMaxFrameCalls;
+		if(stats.m_nRedundant) {
+			out << std::setw(18) << stats.m_nRedundant / frames;
+		}
+		out << std::endl;
+	}
+	out.flags(flags);
+	out.precision(precision);
+}
+
+void GLInterceptor::writeStats(std::ostream& out) {
+	static const char* categoryKeys[] = {"draws", "stateChanges", "uniformUploads", "transfers", "objects", "queries"};
+	Averages averages = getAverages();
+	double frames = std::max(s_nFrameCount, 1ull);
+
+	out << "{\"frames\": " << s_nFrameCount << ", \"callsPerFrame\": " << averages.m_fCalls << ", \"maxCallsPerFrame\": " << s_nMaxFrameCalls;
+	for(int category = 0; category < int(GLCategory::Count); ++category) {
+		out << ", \"" << categoryKeys[category] << "\": " << averages.m_Categories[category];
+	}
+	out << ", \"redundantBinds\": " << averages.m_fRedundant << ", \"entryPoints\": {";
+
+	bool first = true;
+	for(GLEntryPoint entry : getCalledEntryPoints()) {
+		const EntryPointStats& stats = s_Stats[entry];
+		out << (first ? "" : ", ") << "\"" << getEntryPointInfo(entry).m_pName << "\": {\"calls\": " << stats.m_nCalls / frames
+			<< ", \"max\": " << stats.m_nMaxFrameCalls << ", \"redundant\": " << stats.m_nRedundant / frames << "}";
+		first = false;
+	}
+	out << "}}";
+}
+
+}
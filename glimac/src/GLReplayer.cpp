@@ -0,0 +1,225 @@
+#include "glimac/GLReplayer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace glimac {
+
+static const char NAME_KINDS[] = "btvfrqspy"; // Kinds of names, in the order of GLReplayer::m_Names
+static const char NAME_ARRAYS[] = "BTVFRQ"; // Roles of the arrays of names
+static constexpr std::size_t MIN_SCRATCH_SIZE = 256; // Memory given to the calls writing values of unknown size
+
+// Index of the kind of names of a role in NAME_KINDS, -1 if it isn't a name
+static int getNameKind(char role) {
+	const char* kind = role ? std::strchr(NAME_KINDS, std::tolower(role)) : nullptr;
+	return kind ? int(kind - NAME_KINDS) : -1;
+}
+
+GLReplayer::GLReplayer(const FilePath& path):
+	m_File(path.str(), std::ios::binary) {
+	if(!m_File) {
+		throw std::runtime_error("The trace " + path.str() + " can't be opened");
+	}
+
+	char magic[sizeof(GL_TRACE_MAGIC)];
+	read(magic, sizeof(magic));
+	if(std::memcmp(magic, GL_TRACE_MAGIC, sizeof(magic)) != 0 || read<uint32_t>() != GL_TRACE_VERSION) {
+		throw std::runtime_error(path.str() + " isn't an OpenGL trace of this version");
+	}
+
+	m_nWidth = read<uint32_t>();
+	m_nHeight = read<uint32_t>();
+
+	// The entry points are identified by their index, the list must be the same
+	bool sameEntryPoints = read<uint32_t>() == GL_ENTRY_POINT_COUNT;
+	for(unsigned int i = 0; sameEntryPoints && i < GL_ENTRY_POINT_COUNT; ++i) {
+		std::string name(read<uint32_t>(), '\0');
+		read(&name[0], name.size());
+		sameEntryPoints = name == getEntryPointInfo(GLEntryPoint(i)).m_pName;
+	}
+	if(!sameEntryPoints) {
+		throw std::runtime_error(path.str() + " was recorded with other entry points, it must be replayed by the same version of the engine");
+	}
+}
+
+void GLReplayer::read(void* data, std::size_t size) {
+	if(!m_File.read(static_cast<char*>(data), size)) {
+		throw std::runtime_error("The trace is cut or damaged");
+	}
+}
+
+bool GLReplayer::replayFrame() {
+	while(m_File.peek() != std::char_traits<char>::eof()) {
+		uint16_t record = read<uint16_t>();
+		if(record == GL_TRACE_FRAME_END) {
+			return true;
+		} else if(record == GL_TRACE_BUFFER_WRITE) {
+			replayBufferWrite();
+		} else if(record < GL_ENTRY_POINT_COUNT) {
+			replayCall(GLEntryPoint(record));
+		} else {
+			throw std::runtime_error("The trace is damaged, unknown record " + std::to_string(record));
+		}
+	}
+	return false;
+}
+
+std::pair<uint64_t, uint64_t> GLReplayer::getBufferSlot(uint64_t target) const {
+	return {target, target == GL_ELEMENT_ARRAY_BUFFER ? m_nCurrentVertexArray : 0}; // The element array buffer is a state of the vertex array
+}
+
+uint64_t GLReplayer::translate(char role, uint64_t name) const {
+	int kind = getNameKind(role);
+	if(kind < 0 || name == 0) {
+		return name;
+	}
+	auto it = m_Names[kind].find(name);
+	return it != m_Names[kind].end() ? it->second : name;
+}
+
+void GLReplayer::replayCall(GLEntryPoint entry) {
+	const GLEntryPointInfo& info = getEntryPointInfo(entry);
+	uint64_t recorded[GLEntryPointInfo::MAX_ARGS] = {}; // Values of the recording context
+	uint64_t args[GLEntryPointInfo::MAX_ARGS + 1] = {}; // Values of this context
+
+	for(unsigned int i = 0; i < info.m_nArgCount; ++i) {
+		char role = info.getRole(i);
+		switch(role) {
+		case 'B': case 'T': case 'V': case 'F': case 'R': case 'Q': {
+			auto& names = m_NameArrays[i];
+			names.resize(std::max(GLsizei(args[0]), 1));
+			read(names.data(), args[0] * sizeof(GLuint));
+			if(info.m_nOutputArgs & (1u << i)) {
+				m_Payloads[i].assign((char*)names.data(), (char*)(names.data() + args[0])); // Names generated by the recording context
+			} else {
+				for(GLsizei n = 0; n < GLsizei(args[0]); ++n) {
+					names[n] = GLuint(translate(role, names[n]));
+				}
+			}
+			args[i] = toGLValue(names.data());
+			break;
+		}
+		case 'd': {
+			bool present = read<uint8_t>() != 0;
+			auto size = read<uint64_t>();
+			m_Payloads[i].resize(std::max<uint64_t>(size, 1));
+			read(m_Payloads[i].data(), size);
+			args[i] = present ? toGLValue(m_Payloads[i].data()) : 0;
+			break;
+		}
+		case 'z': {
+			auto length = read<uint32_t>();
+			m_Payloads[i].resize(length + 1);
+			read(m_Payloads[i].data(), length);
+			m_Payloads[i][length] = '\0';
+			args[i] = toGLValue(m_Payloads[i].data());
+			break;
+		}
+		case 'S': {
+			GLsizei count = GLsizei(args[1]);
+			m_Strings.resize(count);
+			m_StringPointers.resize(count);
+			m_StringLengths.resize(count);
+			for(GLsizei s = 0; s < count; ++s) {
+				m_Strings[s].resize(read<uint32_t>());
+				read(&m_Strings[s][0], m_Strings[s].size());
+				m_StringPointers[s] = m_Strings[s].data();
+				m_StringLengths[s] = GLint(m_Strings[s].size());
+			}
+			args[i] = toGLValue(m_StringPointers.data());
+			break;
+		}
+		case 'L':
+			args[i] = toGLValue(m_StringLengths.data());
+			break;
+		case 'o':
+			m_Payloads[i].resize(std::max(getPayloadSize(entry, i, args), MIN_SCRATCH_SIZE));
+			args[i] = toGLValue(m_Payloads[i].data());
+			break;
+		case 'u': case 'k': {
+			read(&recorded[i], info.m_ArgSizes[i]);
+			uint64_t program = role == 'u' && info.getRole(0) != 'p' ? m_nCurrentProgram : recorded[0];
+			auto it = m_Uniforms.find(UniformKey(role, program, recorded[i]));
+			args[i] = it != m_Uniforms.end() ? it->second : recorded[i];
+			break;
+		}
+		default:
+			read(&recorded[i], info.m_ArgSizes[i]);
+			args[i] = translate(role, recorded[i]);
+			break;
+		}
+	}
+
+	char returnRole = info.getReturnRole();
+	uint64_t recordedResult = 0;
+	if(returnRole != '.' && returnRole != 'm') {
+		read(&recordedResult, info.m_ReturnSize);
+	}
+
+	uint64_t result = 0;
+	if(!info.m_pCall(args, &result)) {
+		++m_nSkippedCount;
+		return;
+	}
+	++m_nCallCount;
+
+	// Names created by the call
+	int returnKind = getNameKind(returnRole);
+	if(returnKind >= 0) {
+		m_Names[returnKind][recordedResult] = result;
+	} else if(returnRole == 'u' || returnRole == 'k') {
+		m_Uniforms[UniformKey(returnRole, recorded[0], recordedResult)] = result;
+	}
+	for(unsigned int i = 0; i < info.m_nArgCount; ++i) {
+		int kind = getNameKind(info.getRole(i));
+		if(std::strchr(NAME_ARRAYS, info.getRole(i)) && (info.m_nOutputArgs & (1u << i))) {
+			auto generated = reinterpret_cast<const GLuint*>(m_Payloads[i].data());
+			for(GLsizei n = 0; n < GLsizei(args[0]); ++n) {
+				m_Names[kind][generated[n]] = m_NameArrays[i][n];
+			}
+		}
+	}
+
+	// State needed to translate the next calls
+	switch(entry) {
+	case GL_ENTRY_glUseProgram:
+		m_nCurrentProgram = recorded[0];
+		break;
+	case GL_ENTRY_glBindVertexArray:
+		m_nCurrentVertexArray = recorded[0];
+		break;
+	case GL_ENTRY_glBindBuffer:
+		m_BoundBuffers[getBufferSlot(args[0])] = recorded[1];
+		break;
+	case GL_ENTRY_glBindBufferBase:
+	case GL_ENTRY_glBindBufferRange:
+		m_BoundBuffers[getBufferSlot(args[0])] = recorded[2];
+		break;
+	case GL_ENTRY_glMapBufferRange:
+		m_Mappings[m_BoundBuffers[getBufferSlot(args[0])]] = fromGLValue<char*>(result);
+		break;
+	case GL_ENTRY_glUnmapBuffer:
+		m_Mappings.erase(m_BoundBuffers[getBufferSlot(args[0])]);
+		break;
+	default:
+		break;
+	}
+}
+
+void GLReplayer::replayBufferWrite() {
+	auto buffer = read<uint32_t>();
+	auto offset = read<uint64_t>();
+	auto size = read<uint64_t>();
+
+	auto mapping = m_Mappings.find(buffer);
+	if(mapping != m_Mappings.end() && mapping->second) {
+		read(mapping->second + offset, size);
+	} else {
+		m_File.ignore(size); // The mapping failed in this context
+	}
+}
+
+}
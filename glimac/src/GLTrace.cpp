@@ -0,0 +1,129 @@
+#include "glimac/GLTrace.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace glimac {
+
+// Arguments, returned value and call of an entry point, from the type of its pointer
+template <auto Pointer>
+struct GLSignature;
+
+template <typename R, typename... Args, R (APIENTRYP *Pointer)(Args...)>
+struct GLSignature<Pointer> {
+	static constexpr unsigned int ARG_COUNT = sizeof...(Args);
+
+	static GLEntryPointInfo makeInfo(const char* name, GLCategory category, const char* roles) {
+		static_assert(ARG_COUNT <= GLEntryPointInfo::MAX_ARGS, "Too many arguments");
+
+		GLEntryPointInfo info{name, category, roles, ARG_COUNT, 0, {}, 0, &call};
+		if constexpr(!std::is_void_v<R>) {
+			info.m_ReturnSize = sizeof(R);
+		}
+		unsigned char sizes[] = {sizeof(Args)..., 0};
+		bool outputs[] = {isOutput<Args>()..., false};
+		for(unsigned int i = 0; i < ARG_COUNT; ++i) {
+			info.m_ArgSizes[i] = sizes[i];
+			info.m_nOutputArgs |= outputs[i] ? 1u << i : 0;
+		}
+		return info;
+	}
+
+	template <typename T>
+	static constexpr bool isOutput() {
+		return std::is_pointer_v<T> && !std::is_const_v<std::remove_pointer_t<T>>;
+	}
+
+	static bool call(const uint64_t* args, uint64_t* result) {
+		if(!*Pointer) {
+			return false;
+		}
+		callWith(args, result, std::index_sequence_for<Args...>());
+		return true;
+	}
+
+	template <std::size_t... I>
+	static void callWith([[maybe_unused]] const uint64_t* args, uint64_t* result, std::index_sequence<I...>) {
+		if constexpr(std::is_void_v<R>) {
+			(*Pointer)(fromGLValue<Args>(args[I])...);
+			*result = 0;
+		} else {
+			*result = toGLValue((*Pointer)(fromGLValue<Args>(args[I])...));
+		}
+	}
+};
+
+static constexpr std::size_t length(const char* text) {
+	return *text ? 1 + length(text + 1) : 0;
+}
+
+#define GLIMAC_GL_ENTRY_POINT_CHECK(name, pointer, category, roles) \
+	static_assert(length(roles) == 1 + GLSignature<&pointer>::ARG_COUNT, "Roles of " #name " don't match its arguments");
+GLIMAC_GL_ENTRY_POINTS(GLIMAC_GL_ENTRY_POINT_CHECK)
+#undef GLIMAC_GL_ENTRY_POINT_CHECK
+
+static const GLEntryPointInfo s_EntryPoints[] = {
+#define GLIMAC_GL_ENTRY_POINT_INFO(name, pointer, category, roles) \
+	GLSignature<&pointer>::makeInfo(#name, GLCategory::category, roles),
+	GLIMAC_GL_ENTRY_POINTS(GLIMAC_GL_ENTRY_POINT_INFO)
+#undef GLIMAC_GL_ENTRY_POINT_INFO
+};
+
+const char* getCategoryName(GLCategory category) {
+	static const char* names[] = {"draws", "state changes", "uniform uploads", "transfers", "objects", "queries"};
+	return names[static_cast<int>(category)];
+}
+
+const GLEntryPointInfo& getEntryPointInfo(GLEntryPoint entry) {
+	return s_EntryPoints[entry];
+}
+
+// Bytes of a glTexImage2D image, the rows are aligned on the default GL_UNPACK_ALIGNMENT (4)
+static std::size_t getImageSize(uint64_t width, uint64_t height, GLenum format, GLenum type) {
+	std::size_t components = 4;
+	switch(format) {
+	case GL_RED: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: components = 1; break;
+	case GL_RG: case GL_DEPTH_STENCIL: components = 2; break;
+	case GL_RGB: case GL_BGR: components = 3; break;
+	}
+
+	std::size_t componentSize = 1;
+	switch(type) {
+	case GL_SHORT: case GL_UNSIGNED_SHORT: case GL_HALF_FLOAT: componentSize = 2; break;
+	case GL_INT: case GL_UNSIGNED_INT: case GL_FLOAT: componentSize = 4; break;
+	case GL_UNSIGNED_INT_24_8: components = 1; componentSize = 4; break;
+	}
+
+	std::size_t rowSize = (width * components * componentSize + 3) / 4 * 4;
+	return rowSize * height;
+}
+
+std::size_t getPayloadSize(GLEntryPoint entry, unsigned int arg, const uint64_t* args) {
+	switch(entry) {
+	case GL_ENTRY_glUniform2fv:
+		return args[1] * 2 * sizeof(GLfloat);
+	case GL_ENTRY_glUniform4fv:
+		return args[1] * 4 * sizeof(GLfloat);
+	case GL_ENTRY_glUniformMatrix4fv:
+		return args[1] * 16 * sizeof(GLfloat);
+	case GL_ENTRY_glBufferData:
+	case GL_ENTRY_glBufferStorage:
+		return args[1];
+	case GL_ENTRY_glBufferSubData:
+	case GL_ENTRY_glGetBufferSubData:
+		return args[2];
+	case GL_ENTRY_glTexImage2D:
+		return getImageSize(args[3], args[4], GLenum(args[6]), GLenum(args[7]));
+	case GL_ENTRY_glProgramBinary:
+		return args[3];
+	case GL_ENTRY_glGetShaderInfoLog:
+	case GL_ENTRY_glGetProgramInfoLog:
+		return arg == 3 ? args[1] : sizeof(GLsizei);
+	case GL_ENTRY_glGetProgramBinary:
+		return arg == 4 ? args[1] : sizeof(GLint);
+	default:
+		return 0;
+	}
+}
+
+}
@@ -0,0 +1,153 @@
+#include "glimac/GeometryArena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <glm/gtc/packing.hpp>
+
+namespace glimac {
+
+// Copy the content of a buffer in a bigger one, the old buffer is deleted
+static GLuint growBuffer(GLuint buffer, GLsizeiptr usedSize, GLsizeiptr newSize) {
+	GLuint newBuffer;
+	glGenBuffers(1, &newBuffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, newSize, nullptr, GL_STATIC_DRAW);
+
+	if(buffer) {
+		glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, usedSize);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glDeleteBuffers(1, &buffer);
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	return newBuffer;
+}
+
+PackedVertex::PackedVertex(const ShapeVertex& vertex) {
+	position[0] = glm::packHalf1x16(vertex.position.x);
+	position[1] = glm::packHalf1x16(vertex.position.y);
+	position[2] = glm::packHalf1x16(vertex.position.z);
+	position[3] = 0;
+	normal = glm::packSnorm3x10_1x2(glm::vec4(vertex.normal, 0));
+	texCoords[0] = glm::packUnorm1x16(vertex.texCoords.x);
+	texCoords[1] = glm::packUnorm1x16(vertex.texCoords.y);
+}
+
+GeometryArena::GeometryArena(GLsizei vertexCapacity, GLsizei indexCapacity):
+	m_nVertexCapacity(0), m_nIndexCapacity(0) {
+	glGenVertexArrays(1, &m_nVAO);
+	reserve(vertexCapacity, indexCapacity);
+}
+
+GeometryArena::~GeometryArena() {
+	glDeleteVertexArrays(1, &m_nVAO);
+	glDeleteBuffers(1, &m_nVBO);
+	glDeleteBuffers(1, &m_nIBO);
+}
+
+ArenaMesh GeometryArena::add(const ShapeVertex* vertices, GLsizei vertexCount, const uint32_t* indices, GLsizei indexCount, GLenum mode) {
+	std::vector<PackedVertex> packed(vertices, vertices + vertexCount);
+	return add(packed.data(), vertexCount, indices, indexCount, mode);
+}
+
+ArenaMesh GeometryArena::add(const PackedVertex* vertices, GLsizei vertexCount, const uint32_t* indices, GLsizei indexCount, GLenum mode) {
+	reserve(m_nVertexCount + vertexCount, m_nIndexCount + indexCount);
+
+	ArenaMesh mesh;
+	mesh.m_Mode = mode;
+	mesh.m_nIndexCount = indexCount;
+	mesh.m_nFirstIndex = m_nIndexCount;
+	mesh.m_nBaseVertex = m_nVertexCount;
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_nVBO);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, m_nVertexCount * sizeof(PackedVertex), vertexCount * sizeof(PackedVertex), vertices);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_nIBO);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, m_nIndexCount * sizeof(uint32_t), indexCount * sizeof(uint32_t), indices);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	m_nVertexCount += vertexCount;
+	m_nIndexCount += indexCount;
+	return mesh;
+}
+
+ArenaMesh GeometryArena::add(const ShapeVertex* vertices, GLsizei vertexCount, GLenum mode) {
+	std::vector<uint32_t> indices(vertexCount);
+	for(GLsizei i = 0; i < vertexCount; ++i) {
+		indices[i] = i;
+	}
+	return add(vertices, vertexCount, indices.data(), vertexCount, mode);
+}
+
+void GeometryArena::getContent(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices) const {
+	vertices.resize(m_nVertexCount);
+	indices.resize(m_nIndexCount);
+
+	glBindBuffer(GL_COPY_READ_BUFFER, m_nVBO);
+	glGetBufferSubData(GL_COPY_READ_BUFFER, 0, m_nVertexCount * sizeof(PackedVertex), vertices.data());
+	glBindBuffer(GL_COPY_READ_BUFFER, m_nIBO);
+	glGetBufferSubData(GL_COPY_READ_BUFFER, 0, m_nIndexCount * sizeof(uint32_t), indices.data());
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+void GeometryArena::setInstanceAttribute(GLuint attribute, GLuint buffer) {
+	glBindVertexArray(m_nVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	glEnableVertexAttribArray(attribute);
+	glVertexAttribIPointer(attribute, 1, GL_UNSIGNED_INT, sizeof(GLuint), 0);
+	glVertexAttribDivisor(attribute, 1);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+void GeometryArena::reserve(GLsizei vertexCount, GLsizei indexCount) {
+	bool changed = false;
+
+	if(vertexCount > m_nVertexCapacity) {
+		GLsizei capacity = std::max(vertexCount, 2 * m_nVertexCapacity);
+		m_nVBO = growBuffer(m_nVBO, m_nVertexCount * sizeof(PackedVertex), capacity * sizeof(PackedVertex));
+		m_nVertexCapacity = capacity;
+		changed = true;
+	}
+
+	if(indexCount > m_nIndexCapacity) {
+		GLsizei capacity = std::max(indexCount, 2 * m_nIndexCapacity);
+		m_nIBO = growBuffer(m_nIBO, m_nIndexCount * sizeof(uint32_t), capacity * sizeof(uint32_t));
+		m_nIndexCapacity = capacity;
+		changed = true;
+	}
+
+	if(changed) {
+		setVertexAttributes();
+	}
+}
+
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex must stay 16 bytes");
+
+void GeometryArena::setVertexAttributes() {
+	const GLuint ATTR_POSITION = 0;
+	const GLuint ATTR_NORMAL = 1;
+	const GLuint ATTR_TEXTURE = 2;
+
+	glBindVertexArray(m_nVAO);
+
+	// The IBO is part of the VAO state
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_nIBO);
+
+	glEnableVertexAttribArray(ATTR_POSITION);
+	glEnableVertexAttribArray(ATTR_NORMAL);
+	glEnableVertexAttribArray(ATTR_TEXTURE);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_nVBO);
+	// The normalized formats are converted back to floats by the vertex fetch
+	glVertexAttribPointer(ATTR_POSITION, 3, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (const GLvoid*)offsetof(PackedVertex, position));
+	glVertexAttribPointer(ATTR_NORMAL, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedVertex), (const GLvoid*)offsetof(PackedVertex, normal));
+	glVertexAttribPointer(ATTR_TEXTURE, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex), (const GLvoid*)offsetof(PackedVertex, texCoords));
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+}
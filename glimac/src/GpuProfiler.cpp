@@ -0,0 +1,105 @@
+#include "glimac/GpuProfiler.hpp"
+
+namespace glimac {
+
+GpuProfiler::GpuProfiler(unsigned int frameCount): m_Frames(frameCount) {
+	for(auto& frame: m_Frames) {
+		frame.m_Names.reserve(MAX_ZONES);
+	}
+	m_Zones.reserve(MAX_ZONES);
+}
+
+GpuProfiler::~GpuProfiler() {
+	if(!m_Queries.empty()) {
+		glDeleteQueries(m_Queries.size(), m_Queries.data());
+	}
+}
+
+void GpuProfiler::beginFrame(GLuint64 hostTime, const char* name) {
+	m_bRunning = m_nPending < m_Frames.size();
+	if(!m_bRunning) {
+		return;
+	}
+
+	if(m_Queries.empty()) {
+		m_Queries.resize(m_Frames.size() * MAX_ZONES * 2);
+		glGenQueries(m_Queries.size(), m_Queries.data());
+	}
+
+	// The GPU clock is matched with the one of the caller once per frame
+	auto& frame = m_Frames[m_nNext];
+	frame.m_Names.clear();
+	frame.m_nHostTime = hostTime;
+	glGetInteger64v(GL_TIMESTAMP, &frame.m_nGpuTime);
+
+	beginZone(name);
+}
+
+void GpuProfiler::endFrame() {
+	if(!m_bRunning) {
+		return;
+	}
+
+	endZone(0);
+	m_nNext = (m_nNext + 1) % m_Frames.size();
+	++m_nPending;
+	m_bRunning = false;
+}
+
+int GpuProfiler::beginZone(const char* name) {
+	if(!m_bRunning) {
+		return -1;
+	}
+
+	auto& frame = m_Frames[m_nNext];
+	if(frame.m_Names.size() == MAX_ZONES) {
+		return -1;
+	}
+
+	int zone = frame.m_Names.size();
+	frame.m_Names.push_back(name);
+	glQueryCounter(getQuery(m_nNext, 2 * zone), GL_TIMESTAMP);
+	return zone;
+}
+
+void GpuProfiler::endZone(int zone) {
+	if(!m_bRunning || zone < 0) {
+		return;
+	}
+
+	glQueryCounter(getQuery(m_nNext, 2 * zone + 1), GL_TIMESTAMP);
+}
+
+bool GpuProfiler::poll() {
+	if(m_nPending == 0) {
+		return false;
+	}
+
+	unsigned int slot = (m_nNext + m_Frames.size() - m_nPending) % m_Frames.size();
+	auto& frame = m_Frames[slot];
+
+	// The end of the frame is the last query written
+	GLint available = GL_FALSE;
+	glGetQueryObjectiv(getQuery(slot, 1), GL_QUERY_RESULT_AVAILABLE, &available);
+	if(!available) {
+		return false;
+	}
+
+	m_Zones.clear();
+	for(unsigned int i = 0; i < frame.m_Names.size(); ++i) {
+		GLuint64 begin = 0, end = 0;
+		glGetQueryObjectui64v(getQuery(slot, 2 * i), GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(getQuery(slot, 2 * i + 1), GL_QUERY_RESULT, &end);
+
+		// A zone begun before the clocks were matched is clamped to the start of the frame
+		GLint64 offset = GLint64(begin) - frame.m_nGpuTime;
+		GLuint64 hostBegin = offset > 0 ? frame.m_nHostTime + offset : frame.m_nHostTime;
+		GLuint64 hostEnd = hostBegin + (end > begin ? end - begin : 0);
+		m_Zones.push_back({frame.m_Names[i], hostBegin, hostEnd});
+	}
+
+	--m_nPending;
+	return true;
+}
+
+}
@@ -0,0 +1,52 @@
+#include "glimac/GpuTimer.hpp"
+
+namespace glimac {
+
+GpuTimer::GpuTimer(unsigned int queryCount): m_Queries(queryCount, 0) {
+	glGenQueries(queryCount, m_Queries.data());
+}
+
+GpuTimer::~GpuTimer() {
+	glDeleteQueries(m_Queries.size(), m_Queries.data());
+}
+
+bool GpuTimer::begin() {
+	m_bRunning = m_nPending < m_Queries.size();
+	if(m_bRunning) {
+		glBeginQuery(GL_TIME_ELAPSED, m_Queries[m_nNext]);
+	}
+	return m_bRunning;
+}
+
+void GpuTimer::end() {
+	if(!m_bRunning) {
+		return;
+	}
+
+	glEndQuery(GL_TIME_ELAPSED);
+	m_nNext = (m_nNext + 1) % m_Queries.size();
+	++m_nPending;
+	m_bRunning = false;
+}
+
+bool GpuTimer::poll() {
+	if(m_nPending == 0) {
+		return false;
+	}
+
+	GLuint query = m_Queries[(m_nNext + m_Queries.size() - m_nPending) % m_Queries.size()];
+
+	GLint available = GL_FALSE;
+	glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+	if(!available) {
+		return false;
+	}
+
+	GLuint64 nanoseconds = 0;
+	glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+	m_fLastTime = nanoseconds / 1e6;
+	--m_nPending;
+	return true;
+}
+
+}
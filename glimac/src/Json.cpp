@@ -0,0 +1,50 @@
+#include "glimac/Json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace glimac {
+
+void writeJsonString(std::ostream& out, const char* text) {
+	out << '"';
+	for(; text && *text; text++) {
+		if(*text == '"' || *text == '\\') {
+			out << '\\' << *text;
+		} else if(static_cast<unsigned char>(*text) < 0x20) {
+			char escaped[7];
+			std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(*text));
+			out << escaped;
+		} else {
+			out << *text;
+		}
+	}
+	out << '"';
+}
+
+void writeJsonStatistics(std::ostream& out, std::vector<float> samples) {
+	if(samples.empty()) {
+		out << "null";
+		return;
+	}
+	std::sort(samples.begin(), samples.end());
+
+	// Nearest rank
+	auto percentile = [&](float rank) {
+		std::size_t index = std::ceil(rank / 100 * samples.size());
+		return samples[std::max<std::size_t>(index, 1) - 1];
+	};
+
+	double sum = 0;
+	for(float sample : samples) {
+		sum += sample;
+	}
+
+	out << "{\"mean\": " << sum / samples.size()
+		<< ", \"p50\": " << percentile(50)
+		<< ", \"p95\": " << percentile(95)
+		<< ", \"p99\": " << percentile(99)
+		<< ", \"max\": " << samples.back() << "}";
+}
+
+}
@@ -0,0 +1,98 @@
+#include "glimac/MappedFile.hpp"
+
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GLIMAC_HAS_MMAP
+#else
+#include <fstream>
+#endif
+
+namespace glimac {
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& rvalue):
+	m_pData(rvalue.m_pData), m_nSize(rvalue.m_nSize), m_bMapped(rvalue.m_bMapped), m_Buffer(std::move(rvalue.m_Buffer)) {
+	rvalue.m_pData = nullptr;
+	rvalue.m_nSize = 0;
+	rvalue.m_bMapped = false;
+}
+
+MappedFile& MappedFile::operator =(MappedFile&& rvalue) {
+	if(this != &rvalue) {
+		close();
+		m_pData = rvalue.m_pData;
+		m_nSize = rvalue.m_nSize;
+		m_bMapped = rvalue.m_bMapped;
+		m_Buffer = std::move(rvalue.m_Buffer);
+		rvalue.m_pData = nullptr;
+		rvalue.m_nSize = 0;
+		rvalue.m_bMapped = false;
+	}
+	return *this;
+}
+
+bool MappedFile::open(const FilePath& path) {
+	close();
+
+#ifdef GLIMAC_HAS_MMAP
+	int file = ::open(path.c_str(), O_RDONLY);
+	if(file < 0) {
+		return false;
+	}
+
+	struct stat status;
+	if(fstat(file, &status) != 0 || status.st_size == 0) {
+		::close(file);
+		return false;
+	}
+
+	// The mapping stays valid once the descriptor is closed
+	void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	::close(file);
+	if(data == MAP_FAILED) {
+		return false;
+	}
+
+	m_pData = static_cast<const char*>(data);
+	m_nSize = status.st_size;
+	m_bMapped = true;
+#else
+	std::ifstream input(path.c_str(), std::ios::binary | std::ios::ate);
+	if(!input || input.tellg() <= 0) {
+		return false;
+	}
+
+	m_Buffer.resize(input.tellg());
+	input.seekg(0);
+	if(!input.read(m_Buffer.data(), m_Buffer.size())) {
+		m_Buffer.clear();
+		return false;
+	}
+
+	m_pData = m_Buffer.data();
+	m_nSize = m_Buffer.size();
+#endif
+	return true;
+}
+
+void MappedFile::close() {
+#ifdef GLIMAC_HAS_MMAP
+	if(m_bMapped) {
+		munmap(const_cast<char*>(m_pData), m_nSize);
+	}
+#endif
+	m_Buffer.clear();
+	m_pData = nullptr;
+	m_nSize = 0;
+	m_bMapped = false;
+}
+
+}
@@ -71,4 +71,22 @@ Program loadProgram(const FilePath& vsFile, const FilePath& fsFile) {
 	return program;
 }
 
+// Load source code from a file and build a GLSL compute program (OpenGL 4.3)
+Program loadComputeProgram(const FilePath& csFile) {
+	Shader cs = loadShader(GL_COMPUTE_SHADER, csFile);
+
+	if(!cs.compile()) {
+		throw std::runtime_error("Compilation error for compute shader (from file " + std::string(csFile) + "): " + cs.getInfoLog());
+	}
+
+	Program program;
+	program.attachShader(cs);
+
+	if(!program.link()) {
+		throw std::runtime_error("Link error (for file " + csFile.str() + "): " + program.getInfoLog());
+	}
+
+	return program;
+}
+
 }
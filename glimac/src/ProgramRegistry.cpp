@@ -0,0 +1,280 @@
+#include "glimac/ProgramRegistry.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <thread>
+#include "glimac/Extensions.hpp"
+
+namespace glimac {
+
+static double elapsedMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// The defines must come after the #version directive, which has to be the first one
+static std::string insertDefines(const std::string& source, const std::string& defines) {
+	if(defines.empty()) {
+		return source;
+	}
+
+	size_t position = source.find("#version");
+	if(position == std::string::npos) {
+		return defines + source;
+	}
+
+	position = source.find('\n', position);
+	position = (position == std::string::npos) ? source.size() : position + 1;
+	return source.substr(0, position) + defines + source.substr(position);
+}
+
+// 64 bits FNV-1a hash of some strings, as an hexadecimal string
+static std::string hashStrings(std::initializer_list<const std::string*> strings) {
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for(auto str : strings) {
+		// The terminating null character separates the strings
+		for(size_t i = 0; i <= str->size(); ++i) {
+			hash ^= (unsigned char)(*str)[i];
+			hash *= 0x100000001b3ull;
+		}
+	}
+
+	char hex[17];
+	std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+	return hex;
+}
+
+// Header of the cache files, followed by the binary
+struct BinaryHeader {
+	uint32_t m_nMagic;
+	uint32_t m_nFormat;
+	uint32_t m_nLength;
+};
+
+static const uint32_t BINARY_MAGIC = 0x42504c47; // "GLPB"
+
+static bool isCompiled(const Shader& shader) {
+	GLint status;
+	glGetShaderiv(shader.getGLId(), GL_COMPILE_STATUS, &status);
+	return status == GL_TRUE;
+}
+
+ProgramRegistry::ProgramRegistry() {
+	if(hasParallelShaderCompile()) {
+		// Let the driver use as many threads as it wants
+		maxShaderCompilerThreads(0xFFFFFFFF);
+		m_bParallel = true;
+	}
+}
+
+std::shared_ptr<Shader> ProgramRegistry::getShader(GLenum type, const FilePath& file, const std::string& defines) {
+	std::string key = std::to_string(type) + '\n' + file.str() + '\n' + defines;
+
+	auto it = m_Shaders.find(key);
+	if(it != m_Shaders.end()) {
+		return it->second;
+	}
+
+	auto shader = std::make_shared<Shader>(type);
+	shader->setSource(insertDefines(loadShaderSource(file), defines).c_str());
+	glCompileShader(shader->getGLId()); // The status is read by finish()
+
+	m_Shaders.emplace(key, shader);
+	return shader;
+}
+
+void ProgramRegistry::setCacheDirectory(const FilePath& directory) {
+	GLint nbFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &nbFormats);
+
+	std::error_code error;
+	std::filesystem::create_directories(directory.str(), error);
+
+	if(nbFormats == 0 || error) {
+		m_CacheDirectory = FilePath();
+		return;
+	}
+
+	m_CacheDirectory = directory;
+	m_DriverName = std::string((const char*)glGetString(GL_VENDOR)) + '\n'
+		+ (const char*)glGetString(GL_RENDERER) + '\n'
+		+ (const char*)glGetString(GL_VERSION);
+}
+
+std::shared_ptr<Program> ProgramRegistry::get(const FilePath& vsFile, const FilePath& fsFile, const std::string& defines) {
+	++m_nRequestCount;
+	std::string key = vsFile.str() + '\n' + fsFile.str() + '\n' + defines;
+
+	auto it = m_Programs.find(key);
+	if(it != m_Programs.end()) {
+		return it->second;
+	}
+
+	PendingProgram pending;
+	pending.m_VertexFile = vsFile;
+	pending.m_FragmentFile = fsFile;
+	pending.m_Defines = defines;
+	pending.m_Stats.m_Name = vsFile.str() + " + " + fsFile.str();
+	if(!defines.empty()) {
+		// One line per define
+		std::string lines = defines.substr(0, defines.find_last_not_of('\n') + 1);
+		for(auto& c : lines) {
+			c = (c == '\n') ? ',' : c;
+		}
+		pending.m_Stats.m_Name += " (" + lines + ")";
+	}
+
+	auto start = Clock::now();
+
+	pending.m_Program = std::make_shared<Program>();
+
+	if(!m_CacheDirectory.empty()) {
+		std::string vsSource = insertDefines(loadShaderSource(vsFile), defines);
+		std::string fsSource = insertDefines(loadShaderSource(fsFile), defines);
+		pending.m_CacheFile = m_CacheDirectory + (hashStrings({&m_DriverName, &vsSource, &fsSource}) + ".bin");
+		pending.m_Stats.m_bCached = loadBinary(pending);
+	}
+
+	if(!pending.m_Stats.m_bCached) {
+		build(pending);
+	}
+
+	pending.m_Stats.m_fSubmitTime = elapsedMs(start, Clock::now());
+
+	m_Programs.emplace(key, pending.m_Program);
+	m_Pending.push_back(std::move(pending));
+	return m_Pending.back().m_Program;
+}
+
+void ProgramRegistry::build(PendingProgram& pending) {
+	pending.m_VertexShader = getShader(GL_VERTEX_SHADER, pending.m_VertexFile, pending.m_Defines);
+	pending.m_FragmentShader = getShader(GL_FRAGMENT_SHADER, pending.m_FragmentFile, pending.m_Defines);
+
+	GLuint program = pending.m_Program->getGLId();
+	if(!pending.m_CacheFile.empty()) {
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	pending.m_Program->attachShader(*pending.m_VertexShader);
+	pending.m_Program->attachShader(*pending.m_FragmentShader);
+	glLinkProgram(program); // The status is read by finish()
+}
+
+bool ProgramRegistry::loadBinary(PendingProgram& pending) {
+	std::ifstream input(pending.m_CacheFile.c_str(), std::ios::binary);
+	BinaryHeader header;
+	if(!input.read((char*)&header, sizeof(header)) || header.m_nMagic != BINARY_MAGIC) {
+		return false;
+	}
+
+	// The binary fills the rest of the file, a damaged length is rejected before allocating it
+	std::streampos binaryStart = input.tellg();
+	if(!input.seekg(0, std::ios::end)) {
+		return false;
+	}
+	std::streamoff remaining = input.tellg() - binaryStart;
+	if(header.m_nLength == 0 || remaining != std::streamoff(header.m_nLength) || !input.seekg(binaryStart)) {
+		return false;
+	}
+
+	std::vector<char> binary(header.m_nLength);
+	if(!input.read(binary.data(), binary.size())) {
+		return false;
+	}
+
+	glProgramBinary(pending.m_Program->getGLId(), header.m_nFormat, binary.data(), header.m_nLength);
+	return true;
+}
+
+void ProgramRegistry::saveBinary(const PendingProgram& pending) {
+	GLuint program = pending.m_Program->getGLId();
+
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if(length <= 0) {
+		return;
+	}
+
+	std::vector<char> binary(length);
+	GLenum format;
+	glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+	// A failed write only means the program is compiled again next time
+	BinaryHeader header = {BINARY_MAGIC, format, (uint32_t)length};
+	std::ofstream output(pending.m_CacheFile.c_str(), std::ios::binary | std::ios::trunc);
+	output.write((const char*)&header, sizeof(header));
+	output.write(binary.data(), binary.size());
+}
+
+void ProgramRegistry::finish() {
+	auto start = Clock::now();
+
+	// With parallel compilation, the completion is polled so each program gets its own wait time
+	if(m_bParallel) {
+		std::vector<bool> ready(m_Pending.size(), false);
+		size_t nbReady = 0;
+
+		while(nbReady < m_Pending.size()) {
+			for(size_t i = 0; i < m_Pending.size(); ++i) {
+				if(ready[i]) {
+					continue;
+				}
+
+				GLint completed = GL_FALSE;
+				glGetProgramiv(m_Pending[i].m_Program->getGLId(), GL_COMPLETION_STATUS_KHR, &completed);
+				if(completed) {
+					m_Pending[i].m_Stats.m_fWaitTime = elapsedMs(start, Clock::now());
+					ready[i] = true;
+					++nbReady;
+				}
+			}
+
+			if(nbReady < m_Pending.size()) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	for(auto& pending : m_Pending) {
+		// Without parallel compilation, the driver may only build the program when its status is read,
+		// so its wait time starts here instead of including the programs before it
+		auto statusStart = Clock::now();
+
+		GLint status;
+		glGetProgramiv(pending.m_Program->getGLId(), GL_LINK_STATUS, &status);
+
+		if(status != GL_TRUE && pending.m_Stats.m_bCached) {
+			// The driver rejected the binary (updated driver...), it is built from the sources instead
+			pending.m_Stats.m_bCached = false;
+			build(pending);
+			glGetProgramiv(pending.m_Program->getGLId(), GL_LINK_STATUS, &status);
+		}
+
+		if(!m_bParallel) {
+			pending.m_Stats.m_fWaitTime = elapsedMs(statusStart, Clock::now());
+		}
+
+		if(status != GL_TRUE) {
+			if(!isCompiled(*pending.m_VertexShader)) {
+				throw std::runtime_error("Compilation error for vertex shader (for " + pending.m_Stats.m_Name + "): " + pending.m_VertexShader->getInfoLog());
+			}
+			if(!isCompiled(*pending.m_FragmentShader)) {
+				throw std::runtime_error("Compilation error for fragment shader (for " + pending.m_Stats.m_Name + "): " + pending.m_FragmentShader->getInfoLog());
+			}
+			throw std::runtime_error("Link error (for " + pending.m_Stats.m_Name + "): " + pending.m_Program->getInfoLog());
+		}
+
+		if(!pending.m_Stats.m_bCached && !pending.m_CacheFile.empty()) {
+			saveBinary(pending);
+		}
+
+		m_Stats.push_back(pending.m_Stats);
+	}
+
+	m_Pending.clear();
+}
+
+}
@@ -0,0 +1,72 @@
+#include "glimac/RenderTarget.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace glimac {
+
+RenderTarget::~RenderTarget() {
+	release();
+}
+
+void RenderTarget::release() {
+	glDeleteFramebuffers(1, &m_nFBO);
+	glDeleteRenderbuffers(1, &m_nColorBuffer);
+	glDeleteRenderbuffers(1, &m_nDepthBuffer);
+	m_nFBO = m_nColorBuffer = m_nDepthBuffer = 0;
+}
+
+void RenderTarget::resize(GLsizei width, GLsizei height) {
+	if(m_nFBO && width == m_nWidth && height == m_nHeight) {
+		return;
+	}
+
+	release();
+	m_nWidth = m_nActiveWidth = width;
+	m_nHeight = m_nActiveHeight = height;
+
+	glGenRenderbuffers(1, &m_nColorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_nColorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+	glGenRenderbuffers(1, &m_nDepthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_nDepthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32F, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_nFBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_nFBO);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_nColorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_nDepthBuffer);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if(status != GL_FRAMEBUFFER_COMPLETE) {
+		release();
+		throw std::runtime_error("Incomplete render target framebuffer");
+	}
+}
+
+void RenderTarget::setActiveArea(GLsizei width, GLsizei height) {
+	m_nActiveWidth = std::clamp(width, 1, m_nWidth);
+	m_nActiveHeight = std::clamp(height, 1, m_nHeight);
+}
+
+void RenderTarget::bind() const {
+	glBindFramebuffer(GL_FRAMEBUFFER, m_nFBO);
+	glViewport(0, 0, m_nActiveWidth, m_nActiveHeight);
+}
+
+void RenderTarget::blitToScreen(GLsizei screenWidth, GLsizei screenHeight) const {
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_nFBO);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+	// A smaller area is stretched over the whole window with a bilinear filtering
+	GLenum filter = (screenWidth == m_nActiveWidth && screenHeight == m_nActiveHeight) ? GL_NEAREST : GL_LINEAR;
+	glBlitFramebuffer(0, 0, m_nActiveWidth, m_nActiveHeight, 0, 0, screenWidth, screenHeight, GL_COLOR_BUFFER_BIT, filter);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, screenWidth, screenHeight);
+}
+
+}
@@ -49,7 +49,6 @@ void Sphere::build(GLfloat r, GLsizei discLat, GLsizei discLong) {
 
     m_nVertexCount = discLat * discLong * 6;
     
-    GLuint idx = 0;
     // Construit les vertex finaux en regroupant les données en triangles:
     // Pour une longitude donnée, les deux triangles formant une face sont de la forme:
     // (i, i + 1, i + discLat + 1), (i, i + discLat + 1, i + discLat)
@@ -57,17 +56,21 @@ void Sphere::build(GLfloat r, GLsizei discLat, GLsizei discLong) {
     for(GLsizei j = 0; j < discLong; ++j) {
         GLsizei offset = j * (discLat + 1);
         for(GLsizei i = 0; i < discLat; ++i) {
-            m_Vertices.push_back(data[offset + i]);
-            m_Vertices.push_back(data[offset + (i + 1)]);
-            m_Vertices.push_back(data[offset + discLat + 1 + (i + 1)]);
-            m_Vertices.push_back(data[offset + i]);
-            m_Vertices.push_back(data[offset + discLat + 1 + (i + 1)]);
-            m_Vertices.push_back(data[offset + i + discLat + 1]);
+            m_Indices.push_back(offset + i);
+            m_Indices.push_back(offset + (i + 1));
+            m_Indices.push_back(offset + discLat + 1 + (i + 1));
+            m_Indices.push_back(offset + i);
+            m_Indices.push_back(offset + discLat + 1 + (i + 1));
+            m_Indices.push_back(offset + i + discLat + 1);
         }
     }
-    
-    // Attention ! dans cette implantation on duplique beaucoup de sommets. Une meilleur stratégie est de passer
-    // par un Index Buffer Object, que nous verrons dans les prochains TDs
+
+    // Version sans index buffer: on duplique les sommets partagés
+    for(auto index : m_Indices) {
+        m_Vertices.push_back(data[index]);
+    }
+
+    m_IndexedVertices = std::move(data);
 }
 
 }
@@ -0,0 +1,142 @@
+#include "glimac/StreamBuffer.hpp"
+#include "glimac/Extensions.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace glimac {
+
+// Offset alignment required to bind a range of the buffer to the given target
+static GLsizeiptr getOffsetAlignment(GLenum target) {
+	GLint alignment = 1;
+	if(target == GL_UNIFORM_BUFFER) {
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	} else if(target == GL_SHADER_STORAGE_BUFFER) {
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	}
+	return alignment;
+}
+
+StreamBuffer::StreamBuffer(GLenum target, GLsizeiptr frameSize, unsigned int frameCount):
+	m_Target(target), m_nFrameCount(frameCount), m_nCurrentRegion(frameCount - 1), m_Fences(frameCount, nullptr) {
+	GLsizeiptr alignment = getOffsetAlignment(target);
+	m_nFrameSize = (frameSize + alignment - 1) / alignment * alignment;
+
+	glGenBuffers(1, &m_nGLId);
+	glBindBuffer(m_Target, m_nGLId);
+
+	if(hasBufferStorage()) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		bufferStorage(m_Target, m_nFrameSize * m_nFrameCount, nullptr, flags);
+		m_pPersistentData = (char*)glMapBufferRange(m_Target, 0, m_nFrameSize * m_nFrameCount, flags);
+		if(!m_pPersistentData) {
+			glBindBuffer(m_Target, 0);
+			throw std::runtime_error("Persistent mapping of a stream buffer failed");
+		}
+	} else {
+		glBufferData(m_Target, m_nFrameSize * m_nFrameCount, nullptr, GL_STREAM_DRAW);
+	}
+
+	glBindBuffer(m_Target, 0);
+}
+
+StreamBuffer::~StreamBuffer() {
+	release();
+}
+
+StreamBuffer::StreamBuffer(StreamBuffer&& rvalue):
+	m_Target(rvalue.m_Target), m_nGLId(rvalue.m_nGLId), m_nFrameSize(rvalue.m_nFrameSize), m_nFrameCount(rvalue.m_nFrameCount),
+	m_nCurrentRegion(rvalue.m_nCurrentRegion), m_Fences(std::move(rvalue.m_Fences)), m_pPersistentData(rvalue.m_pPersistentData),
+	m_bMapped(rvalue.m_bMapped), m_nStallCount(rvalue.m_nStallCount) {
+	rvalue.m_nGLId = 0;
+	rvalue.m_pPersistentData = nullptr;
+	rvalue.m_Fences.clear();
+}
+
+StreamBuffer& StreamBuffer::operator =(StreamBuffer&& rvalue) {
+	if(this != &rvalue) {
+		release();
+		m_Target = rvalue.m_Target;
+		m_nGLId = rvalue.m_nGLId;
+		m_nFrameSize = rvalue.m_nFrameSize;
+		m_nFrameCount = rvalue.m_nFrameCount;
+		m_nCurrentRegion = rvalue.m_nCurrentRegion;
+		m_Fences = std::move(rvalue.m_Fences);
+		m_pPersistentData = rvalue.m_pPersistentData;
+		m_bMapped = rvalue.m_bMapped;
+		m_nStallCount = rvalue.m_nStallCount;
+		rvalue.m_nGLId = 0;
+		rvalue.m_pPersistentData = nullptr;
+		rvalue.m_Fences.clear();
+	}
+	return *this;
+}
+
+void StreamBuffer::release() {
+	for(auto fence : m_Fences) {
+		if(fence) {
+			glDeleteSync(fence);
+		}
+	}
+	m_Fences.clear();
+
+	if(m_nGLId) {
+		if(m_pPersistentData || m_bMapped) {
+			glBindBuffer(m_Target, m_nGLId);
+			glUnmapBuffer(m_Target);
+			glBindBuffer(m_Target, 0);
+		}
+		glDeleteBuffers(1, &m_nGLId);
+		m_nGLId = 0;
+	}
+}
+
+void* StreamBuffer::map() {
+	m_nCurrentRegion = (m_nCurrentRegion + 1) % m_nFrameCount;
+
+	// Wait for the GPU to be done with the commands that read this region
+	GLsync& fence = m_Fences[m_nCurrentRegion];
+	if(fence) {
+		GLenum status = glClientWaitSync(fence, 0, 0);
+		if(status == GL_TIMEOUT_EXPIRED) {
+			++m_nStallCount;
+			while(status == GL_TIMEOUT_EXPIRED) {
+				status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+			}
+		}
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	if(m_pPersistentData) {
+		return m_pPersistentData + getOffset();
+	}
+
+	// The fence already guarantees the region is free, no need for an implicit synchronization
+	glBindBuffer(m_Target, m_nGLId);
+	void* data = glMapBufferRange(m_Target, getOffset(), m_nFrameSize,
+		GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+	glBindBuffer(m_Target, 0);
+	m_bMapped = true;
+	return data;
+}
+
+void StreamBuffer::unmap() {
+	// Nothing to do for a coherent persistent mapping
+	if(m_bMapped) {
+		glBindBuffer(m_Target, m_nGLId);
+		glUnmapBuffer(m_Target);
+		glBindBuffer(m_Target, 0);
+		m_bMapped = false;
+	}
+}
+
+void StreamBuffer::fence() {
+	GLsync& fence = m_Fences[m_nCurrentRegion];
+	if(fence) {
+		glDeleteSync(fence);
+	}
+	fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+}
@@ -0,0 +1,248 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  Replays the OpenGL calls recorded by the          =
+=  interceptor, without the engine, and times the    =
+=  frames to compare drivers or their settings.      =
+=													 =
+======================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glimac/Extensions.hpp>
+#include <glimac/GLReplayer.hpp>
+#include <glimac/Json.hpp>
+#include <GLFW/glfw3.h>
+
+using namespace glimac;
+
+/**
+ * @brief Settings of the replay, read from the command line.
+ ********************************************************************************/
+struct ReplaySettings
+{
+    std::string tracePath;
+    std::string outputPath;  // Results, not written if empty
+    unsigned int warmup = 1; // Frames played but not measured, the first one creates the objects
+    bool finish = false;     // Waits for the GPU at the end of each frame
+    bool visible = false;    // Shows the window
+};
+
+/**
+ * @brief Reads the settings from the command line.
+ *
+ * SolarSysReplay_ trace.bin [--warmup N] [--finish] [--visible] [--output results.json]
+ *
+ * Throws a std::invalid_argument if the arguments are wrong.
+ ********************************************************************************/
+static ReplaySettings readSettings(int argc, char *argv[])
+{
+    ReplaySettings settings;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--finish") == 0)
+        {
+            settings.finish = true;
+        }
+        else if (std::strcmp(argv[i], "--visible") == 0)
+        {
+            settings.visible = true;
+        }
+        else if (std::strcmp(argv[i], "--output") == 0 && hasValue)
+        {
+            settings.outputPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue)
+        {
+            char *end = nullptr;
+            long value = std::strtol(argv[++i], &end, 10);
+            if (*end != '\0' || value < 0 || value > std::numeric_limits<int>::max())
+            {
+                throw std::invalid_argument(std::string("Wrong amount of warm-up frames: ") + argv[i]);
+            }
+            settings.warmup = value;
+        }
+        else if (argv[i][0] != '-' && settings.tracePath.empty())
+        {
+            settings.tracePath = argv[i];
+        }
+        else
+        {
+            throw std::invalid_argument(std::string("Unknown argument or missing value: ") + argv[i]);
+        }
+    }
+
+    if (settings.tracePath.empty())
+    {
+        throw std::invalid_argument("Missing trace");
+    }
+    return settings;
+}
+
+/**
+ * @brief Creates the window and its context, the one of the app (see the
+ *        window module) with the size of the recorded one.
+ *
+ * @return The window, null if it can't be created.
+ ********************************************************************************/
+static GLFWwindow *createWindow(unsigned int width, unsigned int height, bool visible)
+{
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+    glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
+
+    GLFWwindow *window = glfwCreateWindow(width, height, "== * Solar System replay * ==", nullptr, nullptr);
+    if (!window)
+    {
+        return nullptr;
+    }
+
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        glfwDestroyWindow(window);
+        return nullptr;
+    }
+    loadExtensions((GLADloadproc)glfwGetProcAddress);
+    glfwSwapInterval(0); // The frames are measured, not the refresh of the screen
+    return window;
+}
+
+/**
+ * @brief Replays every frame of the trace and measures them.
+ *
+ * @return The time of each frame (in ms), from the end of the previous one to
+ *         the end of its swap.
+ ********************************************************************************/
+static std::vector<float> replay(GLReplayer &replayer, GLFWwindow *window, bool finish)
+{
+    std::vector<float> frameTimes;
+    auto frameStart = std::chrono::steady_clock::now();
+    while (replayer.replayFrame())
+    {
+        if (finish)
+        {
+            glFinish();
+        }
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+
+        auto frameEnd = std::chrono::steady_clock::now();
+        frameTimes.push_back(std::chrono::duration<float, std::milli>(frameEnd - frameStart).count());
+        frameStart = frameEnd;
+    }
+    return frameTimes;
+}
+
+/**
+ * @brief Input of the replay.
+ *
+ * SolarSysReplay_ trace.bin [--warmup N] [--finish] [--visible] [--output results.json]
+ ********************************************************************************/
+int main(int argc, char *argv[])
+{
+    ReplaySettings settings;
+    std::unique_ptr<GLReplayer> replayer;
+    try
+    {
+        settings = readSettings(argc, argv);
+        replayer = std::make_unique<GLReplayer>(settings.tracePath);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl
+                  << "Usage: " << argv[0] << " trace.bin [--warmup N] [--finish] [--visible] [--output results.json]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!glfwInit())
+    {
+        return EXIT_FAILURE;
+    }
+    GLFWwindow *window = createWindow(replayer->getWidth(), replayer->getHeight(), settings.visible);
+    if (!window)
+    {
+        std::cerr << "The window can't be created" << std::endl;
+        glfwTerminate();
+        return EXIT_FAILURE;
+    }
+
+    std::vector<float> frameTimes;
+    bool replayed = true;
+    try
+    {
+        frameTimes = replay(*replayer, window, settings.finish);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        replayed = false;
+    }
+
+    std::vector<float> measured(frameTimes.begin() + std::min<std::size_t>(settings.warmup, frameTimes.size()), frameTimes.end());
+    std::cout << frameTimes.size() << " frames, " << replayer->getCallCount() << " calls replayed";
+    if (replayer->getSkippedCount())
+    {
+        std::cout << ", " << replayer->getSkippedCount() << " skipped (entry points missing from this context)";
+    }
+    std::cout << std::endl
+              << std::fixed << std::setprecision(3) << "Frame time (ms): ";
+    writeJsonStatistics(std::cout, measured);
+    std::cout << std::endl;
+
+    if (!settings.outputPath.empty())
+    {
+        std::ofstream out(settings.outputPath);
+        out << std::fixed << std::setprecision(3)
+            << "{" << std::endl
+            << "  \"trace\": ";
+        writeJsonString(out, settings.tracePath.c_str());
+        out << "," << std::endl
+            << "  \"renderer\": ";
+        writeJsonString(out, reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+        out << "," << std::endl
+            << "  \"version\": ";
+        writeJsonString(out, reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+        out << "," << std::endl
+            << "  \"frames\": " << frameTimes.size() << "," << std::endl
+            << "  \"measuredFrames\": " << measured.size() << "," << std::endl
+            << "  \"finish\": " << (settings.finish ? "true" : "false") << "," << std::endl
+            << "  \"calls\": " << replayer->getCallCount() << "," << std::endl
+            << "  \"skippedCalls\": " << replayer->getSkippedCount() << "," << std::endl
+            << "  \"frameTime\": ";
+        writeJsonStatistics(out, measured);
+        out << std::endl
+            << "}" << std::endl;
+
+        if (!out)
+        {
+            std::cerr << "The results can't be written" << std::endl;
+            replayed = false;
+        }
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return replayed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
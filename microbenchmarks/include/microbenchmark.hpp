@@ -0,0 +1,137 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module times the kernels of the engine on    =
+=  their own, to compare their throughput before     =
+=  and after a change.                               =
+=													 =
+======================================================
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs kernels many times and keeps robust statistics of their time.
+ *
+ * A kernel is first run once (warm-up), then its amount of runs per sample is
+ * doubled until a sample lasts MIN_SAMPLE_TIME, so the clock resolution doesn't
+ * matter. The median and the median absolute deviation of the samples are
+ * reported, they are barely moved by the samples slowed down by the system.
+ *
+ * A kernel returns a value depending on its work, the values are summed in a
+ * volatile so the compiler can't remove the work.
+ ********************************************************************************/
+class Microbenchmark
+{
+public:
+    static constexpr unsigned int DEFAULT_SAMPLES = 15;                  // Samples timed for each kernel
+    static constexpr std::chrono::milliseconds MIN_SAMPLE_TIME{20};      // Shortest time of a sample
+    static constexpr unsigned long long MAX_RUNS = 1ull << 30;           // Most runs of a kernel in a sample
+
+    /**
+     * @brief Reads the settings from the command line.
+     *
+     * SolarSysBench_ [--filter text] [--samples N] [--output results.json]
+     *
+     * Throws a std::invalid_argument if the arguments are wrong.
+     *
+     * @param argc Amount of arguments, the name of the app included.
+     * @param argv The arguments.
+     ********************************************************************************/
+    Microbenchmark(int argc, char *argv[]);
+
+    /**
+     * @brief Tells if a kernel is run, its name must contain the filter.
+     ********************************************************************************/
+    bool isSelected(const std::string &name) const;
+
+    /**
+     * @brief Times a kernel and prints its results.
+     *
+     * @param name Name of the kernel, with its parameters.
+     * @param itemsPerRun Amount of items processed by a run (bodies, vertices...).
+     * @param unit Name of the items.
+     * @param kernel Function running the kernel once, returning a value
+     *               depending on its work.
+     ********************************************************************************/
+    template <typename Kernel>
+    void run(const std::string &name, double itemsPerRun, const char *unit, Kernel kernel)
+    {
+        if (!isSelected(name))
+        {
+            return;
+        }
+
+        _sink = _sink + kernel(); // Warm-up: caches, allocator, lazy initializations
+
+        unsigned long long nbRuns = 1;
+        while (time(kernel, nbRuns) < MIN_SAMPLE_TIME && nbRuns < MAX_RUNS)
+        {
+            nbRuns *= 2;
+        }
+
+        std::vector<double> times; // Time of a run in each sample (in ns)
+        times.reserve(_nbSamples);
+        for (unsigned int i = 0; i < _nbSamples; i++)
+        {
+            times.push_back(std::chrono::duration<double, std::nano>(time(kernel, nbRuns)).count() / nbRuns);
+        }
+
+        addResult(name, itemsPerRun, unit, nbRuns, times);
+    }
+
+    /**
+     * @brief Writes the results to the output given on the command line, if any.
+     *
+     * @return False if the file can't be written.
+     ********************************************************************************/
+    bool writeResults() const;
+
+private:
+    /**
+     * @brief Statistics of a kernel.
+     ********************************************************************************/
+    struct Result
+    {
+        std::string name;
+        std::string unit;
+        double itemsPerRun;
+        unsigned long long nbRuns; // Runs in a sample
+        double median;             // Time of a run (in ns)
+        double deviation;          // Median absolute deviation (in ns)
+        double min;                // Time of a run in the fastest sample (in ns)
+    };
+
+    /**
+     * @brief Times runs of a kernel.
+     ********************************************************************************/
+    template <typename Kernel>
+    std::chrono::steady_clock::duration time(Kernel &kernel, unsigned long long nbRuns)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned long long i = 0; i < nbRuns; i++)
+        {
+            _sink = _sink + kernel();
+        }
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    /**
+     * @brief Computes the statistics of the samples of a kernel and prints them.
+     ********************************************************************************/
+    void addResult(const std::string &name, double itemsPerRun, const char *unit, unsigned long long nbRuns, std::vector<double> &times);
+
+    std::string _filter;                         // Kernels whose name doesn't contain it aren't run
+    unsigned int _nbSamples = DEFAULT_SAMPLES;   // Samples timed for each kernel
+    std::string _outputPath;                     // Results written as JSON, nothing if empty
+    std::vector<Result> _results;                // Kernels already run
+    volatile std::size_t _sink = 0;              // Sum of the values returned by the kernels
+};
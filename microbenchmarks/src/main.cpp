@@ -0,0 +1,292 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  Microbenchmarks of the kernels of the engine,     =
+=  run without window nor OpenGL context.            =
+=													 =
+======================================================
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glimac/FilePath.hpp>
+#include <glimac/GeometryArena.hpp>
+#include <glimac/Geometry.hpp>
+#include <glimac/Image.hpp>
+#include <glimac/Sphere.hpp>
+
+#include "include/frustum.hpp"
+#include "include/microbenchmark.hpp"
+#include "include/pathStorage.hpp"
+#include "include/solarSystem.hpp"
+
+using namespace glimac;
+
+/**
+ * @brief Builds a solar system with copies of the real bodies.
+ *
+ * @param nbPlanets Amount of planets.
+ * @param nbSatellites Amount of satellites of each planet, 9 at most.
+ ********************************************************************************/
+static void fillSolarSystem(SolarSystem &solarSys, unsigned int nbPlanets, unsigned int nbSatellites)
+{
+    const PlanetData planets[] = {MercuryData(), VenusData(), EarthData(), MarsData(), JupiterData(), SaturnData(), UranusData(), NeptuneData()};
+    const PlanetData satellites[] = {MoonData(), MimasData(), EnceladusData(), TethysData(), DioneData(), RheaData(), TitanData(), HyperionData(), IapetusData()};
+
+    MaterialComponent material; // Nothing is drawn, no texture nor shader
+    for (unsigned int i = 0; i < nbPlanets; i++)
+    {
+        Entity planet = solarSys.addPlanet(planets[i % (sizeof(planets) / sizeof(planets[0]))], material);
+        for (unsigned int j = 0; j < nbSatellites; j++)
+        {
+            solarSys.addSatellite(planet, satellites[j], material);
+        }
+    }
+}
+
+/**
+ * @brief Times the update of the matrices of the bodies, as done each frame by
+ *        the update scheduler.
+ ********************************************************************************/
+static void benchmarkMatrices(Microbenchmark &bench)
+{
+    // The same amounts of bodies, alone or as satellites
+    const unsigned int nbBodies[] = {100, 1000, 10000};
+    const unsigned int nbSatellites = 9;
+
+    for (unsigned int count : nbBodies)
+    {
+        for (bool withSatellites : {false, true})
+        {
+            std::string name = std::string("SolarSystem::updateMatrices/") + (withSatellites ? "satellites/" : "planets/") + std::to_string(count);
+            if (!bench.isSelected(name))
+            {
+                continue;
+            }
+
+            SolarSystem solarSys;
+            fillSolarSystem(solarSys, withSatellites ? count / (nbSatellites + 1) : count, withSatellites ? nbSatellites : 0);
+
+            float time = 0;
+            bench.run(name, solarSys.nbBodies(), "bodies", [&]()
+                      {
+                          time += 1.f / 60;
+                          for (Entity planet : solarSys)
+                          {
+                              solarSys.updateMatrices(planet, time, withSatellites);
+                          }
+                          return static_cast<size_t>(solarSys.getModelMatrix(solarSys.getPlanet(0))[3][0]); });
+        }
+    }
+}
+
+/**
+ * @brief Times the generation of the spheres and the packing of their vertices
+ *        into the format of the shared geometry (as done by `GeometryArena::add()`),
+ *        at the discretizations of the levels of detail and above.
+ ********************************************************************************/
+static void benchmarkShapes(Microbenchmark &bench)
+{
+    const GLsizei discretizations[][2] = {{8, 4}, {16, 8}, {32, 16}, {64, 32}, {128, 64}, {256, 128}};
+
+    for (auto &disc : discretizations)
+    {
+        std::string suffix = "/" + std::to_string(disc[0]) + "x" + std::to_string(disc[1]);
+
+        std::string buildName = "Sphere::build" + suffix;
+        if (bench.isSelected(buildName))
+        {
+            Sphere sphere(1, disc[0], disc[1]);
+            bench.run(buildName, sphere.getVertexCount(), "vertices", [&]()
+                      { return static_cast<size_t>(Sphere(1, disc[0], disc[1]).getIndexCount()); });
+        }
+
+        std::string packName = "PackedVertex/sphere" + suffix;
+        if (bench.isSelected(packName))
+        {
+            Sphere sphere(1, disc[0], disc[1]);
+            const ShapeVertex *vertices = sphere.getIndexedDataPointer();
+            GLsizei nbVertices = sphere.getIndexedVertexCount();
+            bench.run(packName, nbVertices, "vertices", [&]()
+                      {
+                          std::vector<PackedVertex> packed(vertices, vertices + nbVertices);
+                          return static_cast<size_t>(packed.back().normal); });
+        }
+    }
+}
+
+/**
+ * @brief Times the decoding of the textures of the app and their conversion to
+ *        floats, per megapixel.
+ *
+ * @param appFolder Folder of the executable, the textures are looked for from it.
+ ********************************************************************************/
+static void benchmarkImages(Microbenchmark &bench, const FilePath &appFolder)
+{
+    const char *textures[] = {PathStorage::PATH_TEXTURE_JUPITER, PathStorage::PATH_TEXTURE_UMBRIEL, PathStorage::PATH_TEXTURE_SUN};
+
+    for (auto texture : textures)
+    {
+        FilePath path = appFolder + texture;
+        std::string name = "loadImage/" + path.file();
+        if (!bench.isSelected(name))
+        {
+            continue;
+        }
+
+        auto image = loadImage(path);
+        if (!image)
+        {
+            std::cerr << name << " skipped, the assets must be next to the executable" << std::endl;
+            continue;
+        }
+
+        bench.run(name, image->getWidth() * image->getHeight() / 1e6, "MP", [&]()
+                  { return static_cast<size_t>(loadImage(path)->getPixels()[0].r * 255); });
+    }
+}
+
+/**
+ * @brief Writes a sphere as an OBJ file, with positions, normals and texture
+ *        coordinates.
+ ********************************************************************************/
+static bool writeSphereOBJ(const FilePath &path, GLsizei discLat, GLsizei discLong)
+{
+    Sphere sphere(1, discLat, discLong);
+    std::ofstream out(path.str());
+
+    auto vertices = sphere.getIndexedDataPointer();
+    for (GLsizei i = 0; i < sphere.getIndexedVertexCount(); i++)
+    {
+        auto &vertex = vertices[i];
+        out << "v " << vertex.position.x << " " << vertex.position.y << " " << vertex.position.z << "\n"
+            << "vn " << vertex.normal.x << " " << vertex.normal.y << " " << vertex.normal.z << "\n"
+            << "vt " << vertex.texCoords.x << " " << vertex.texCoords.y << "\n";
+    }
+
+    auto indices = sphere.getIndexPointer();
+    for (GLsizei i = 0; i < sphere.getIndexCount(); i += 3)
+    {
+        out << "f";
+        for (GLsizei j = 0; j < 3; j++)
+        {
+            auto index = indices[i + j] + 1; // The OBJ indices start at 1
+            out << " " << index << "/" << index << "/" << index;
+        }
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Times the loading of OBJ meshes written from spheres.
+ ********************************************************************************/
+static void benchmarkOBJ(Microbenchmark &bench)
+{
+    const GLsizei discretizations[][2] = {{32, 16}, {128, 64}, {256, 128}};
+    FilePath folder = std::filesystem::temp_directory_path().string();
+
+    for (auto &disc : discretizations)
+    {
+        std::string name = "Geometry::loadOBJ/sphere/" + std::to_string(disc[0]) + "x" + std::to_string(disc[1]);
+        if (!bench.isSelected(name))
+        {
+            continue;
+        }
+
+        FilePath path = folder + ("solarSysBench_" + std::to_string(disc[0]) + ".obj");
+        if (!writeSphereOBJ(path, disc[0], disc[1]))
+        {
+            std::cerr << name << " skipped, " << path << " can't be written" << std::endl;
+            continue;
+        }
+
+        Geometry geometry;
+        geometry.loadOBJ(path, folder, false);
+        bench.run(name, geometry.getIndexCount() / 3., "triangles", [&]()
+                  {
+                      Geometry geometry;
+                      geometry.loadOBJ(path, folder, false);
+                      return geometry.getVertexCount(); });
+
+        std::remove(path.c_str());
+    }
+}
+
+/**
+ * @brief Times the frustum culling of bodies spread around the camera.
+ ********************************************************************************/
+static void benchmarkCulling(Microbenchmark &bench)
+{
+    const unsigned int nbSpheres[] = {1000, 100000};
+
+    // The camera of the app, looking at the sun from the side
+    Frustum frustum(glm::perspective(glm::radians(70.f), 16.f / 9, 0.1f, 5000.f) * glm::lookAt(glm::vec3(0, 50, 300), glm::vec3(0), glm::vec3(0, 1, 0)));
+
+    for (unsigned int count : nbSpheres)
+    {
+        // Fixed seed: the same spheres, and the same part of them visible, on each run
+        std::mt19937 generator(count);
+        std::uniform_real_distribution<float> position(-2000, 2000);
+        std::uniform_real_distribution<float> radius(0.1f, 20);
+
+        std::vector<glm::vec4> spheres(count); // Center in xyz, radius in w
+        for (auto &sphere : spheres)
+        {
+            sphere = glm::vec4(position(generator), position(generator) / 10, position(generator), radius(generator));
+        }
+
+        bench.run("Frustum::intersectsSphere/" + std::to_string(count), count, "spheres", [&]()
+                  {
+                      size_t nbVisible = 0;
+                      for (auto &sphere : spheres)
+                      {
+                          nbVisible += frustum.intersectsSphere(glm::vec3(sphere), sphere.w);
+                      }
+                      return nbVisible; });
+    }
+}
+
+/**
+ * @brief Input of the microbenchmarks.
+ *
+ * SolarSysBench_ [--filter text] [--samples N] [--output results.json]
+ ********************************************************************************/
+int main(int argc, char *argv[])
+{
+    try
+    {
+        Microbenchmark bench(argc, argv);
+        std::clog.setstate(std::ios::failbit); // Geometry::loadOBJ reports each step
+
+        benchmarkMatrices(bench);
+        benchmarkShapes(bench);
+        benchmarkImages(bench, FilePath(argv[0]).dirPath());
+        benchmarkOBJ(bench);
+        benchmarkCulling(bench);
+
+        if (!bench.writeResults())
+        {
+            std::cerr << "The results can't be written" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl
+                  << "Usage: " << argv[0] << " [--filter text] [--samples N] [--output results.json]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
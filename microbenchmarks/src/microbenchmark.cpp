@@ -0,0 +1,159 @@
+/*
+======================================================
+=  													 =
+=      Made by Kevin QUACH and Dylan DE JESUS	     =
+=													 =
+=													 =
+=  This module times the kernels of the engine on    =
+=  their own, to compare their throughput before     =
+=  and after a change.                               =
+=													 =
+======================================================
+*/
+
+#include "include/microbenchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <glimac/Json.hpp>
+
+/**
+ * @brief Reads the settings from the command line.
+ *
+ * SolarSysBench_ [--filter text] [--samples N] [--output results.json]
+ *
+ * Throws a std::invalid_argument if the arguments are wrong.
+ *
+ * @param argc Amount of arguments, the name of the app included.
+ * @param argv The arguments.
+ ********************************************************************************/
+Microbenchmark::Microbenchmark(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 == argc)
+        {
+            throw std::invalid_argument(std::string("Missing value after ") + argv[i]);
+        }
+
+        if (std::strcmp(argv[i], "--filter") == 0)
+        {
+            _filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--output") == 0)
+        {
+            _outputPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--samples") == 0)
+        {
+            char *end = nullptr;
+            long value = std::strtol(argv[++i], &end, 10);
+            if (*end != '\0' || value <= 0)
+            {
+                throw std::invalid_argument(std::string("Wrong amount of samples: ") + argv[i]);
+            }
+            _nbSamples = value;
+        }
+        else
+        {
+            throw std::invalid_argument(std::string("Unknown argument: ") + argv[i]);
+        }
+    }
+
+    std::cout << std::left << std::setw(44) << "Kernel" << std::right
+              << std::setw(14) << "Time (ns)" << std::setw(10) << "+/-"
+              << std::setw(22) << "Throughput" << std::setw(14) << "Runs" << std::endl;
+}
+
+/**
+ * @brief Tells if a kernel is run, its name must contain the filter.
+ ********************************************************************************/
+bool Microbenchmark::isSelected(const std::string &name) const
+{
+    return name.find(_filter) != std::string::npos;
+}
+
+/**
+ * @brief Computes the statistics of the samples of a kernel and prints them.
+ ********************************************************************************/
+void Microbenchmark::addResult(const std::string &name, double itemsPerRun, const char *unit, unsigned long long nbRuns, std::vector<double> &times)
+{
+    std::sort(times.begin(), times.end());
+    auto median = [](const std::vector<double> &values)
+    {
+        size_t middle = values.size() / 2;
+        return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+    };
+
+    Result result{name, unit, itemsPerRun, nbRuns, median(times), 0, times.front()};
+    for (auto &time : times)
+    {
+        time = std::abs(time - result.median);
+    }
+    std::sort(times.begin(), times.end());
+    result.deviation = median(times);
+    _results.push_back(result);
+
+    // The throughput is printed in items per second, with a multiple of the unit
+    double throughput = itemsPerRun * 1e9 / result.median;
+    const char *prefixes[] = {"", "k", "M", "G"};
+    unsigned int prefix = 0;
+    while (throughput >= 1000 && prefix + 1 < sizeof(prefixes) / sizeof(prefixes[0]))
+    {
+        throughput /= 1000;
+        prefix++;
+    }
+
+    std::cout << std::left << std::setw(44) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << result.median
+              << std::setw(9) << 100 * result.deviation / result.median << "%"
+              << std::setw(10) << throughput << " " << std::left << std::setw(11) << (prefixes[prefix] + result.unit + "/s")
+              << std::right << std::setw(14) << nbRuns << "x" << _nbSamples << std::endl;
+}
+
+/**
+ * @brief Writes the results to the output given on the command line, if any.
+ *
+ * @return False if the file can't be written.
+ ********************************************************************************/
+bool Microbenchmark::writeResults() const
+{
+    if (_outputPath.empty())
+    {
+        return true;
+    }
+
+    std::ofstream out(_outputPath);
+    if (!out)
+    {
+        return false;
+    }
+
+    out << std::fixed << std::setprecision(3)
+        << "{" << std::endl
+        << "  \"samples\": " << _nbSamples << "," << std::endl
+        << "  \"kernels\": [";
+    for (size_t i = 0; i < _results.size(); i++)
+    {
+        auto &result = _results[i];
+        out << (i ? "," : "") << std::endl
+            << "    {\"name\": ";
+        glimac::writeJsonString(out, result.name.c_str());
+        out << ", \"unit\": ";
+        glimac::writeJsonString(out, result.unit.c_str());
+        out << ", \"itemsPerRun\": " << result.itemsPerRun
+            << ", \"runs\": " << result.nbRuns << ", \"medianNs\": " << result.median << ", \"deviationNs\": " << result.deviation
+            << ", \"minNs\": " << result.min << ", \"itemsPerSecond\": " << result.itemsPerRun * 1e9 / result.median << "}";
+    }
+    out << std::endl
+        << "  ]" << std::endl
+        << "}" << std::endl;
+
+    return static_cast<bool>(out);
+}